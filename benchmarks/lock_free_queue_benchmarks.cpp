@@ -0,0 +1,698 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "lock_free_queue/mpmc_queue.hpp"
+#include "lock_free_queue/multicast_ring.hpp"
+#include "lock_free_queue/shm_spsc_queue.hpp"
+#include "lock_free_queue/spsc_queue.hpp"
+#include "lock_free_queue/unbounded_spsc_queue.hpp"
+
+class Timer {
+public:
+    Timer() : start_(std::chrono::steady_clock::now()) {}
+
+    double elapsed_ns() const {
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Spin briefly, then give the core away (keeps 1-CPU machines progressing)
+inline void backoff(int& spins) {
+    if (++spins > 64) {
+        spins = 0;
+        std::this_thread::yield();
+    }
+}
+
+// Baseline: the previous SPSCQueue design. Capacity+1 slots indexed with
+// `% BufferSize`, and every push/pop loads the other side's index.
+template <typename T, std::size_t Capacity>
+class LegacySPSCQueue {
+    static constexpr std::size_t BufferSize = Capacity + 1;
+
+public:
+    bool push(const T& value) {
+        auto head      = head_.load(std::memory_order_relaxed);
+        auto next_head = (head + 1) % BufferSize;
+        if (next_head == tail_.load(std::memory_order_acquire)) return false;
+        buffer_[head] = value;
+        head_.store(next_head, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return false;
+        out = buffer_[tail];
+        tail_.store((tail + 1) % BufferSize, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) T buffer_[BufferSize];
+};
+
+// Baseline: std::queue behind a mutex, same bounded push/pop contract
+template <typename T, std::size_t Capacity>
+class MutexQueue {
+public:
+    bool push(const T& value) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (queue_.size() == Capacity) return false;
+        queue_.push(value);
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (queue_.empty()) return false;
+        out = queue_.front();
+        queue_.pop();
+        return true;
+    }
+
+private:
+    std::mutex    mutex_;
+    std::queue<T> queue_;
+};
+
+// ============================================================================
+// MPMC scaling: P producers, C consumers, total items fixed
+// ============================================================================
+
+// Returns millions of items per second through the queue
+template <typename Queue>
+double throughput_mops(int producers, int consumers, int total_items) {
+    Queue q;
+    const int per_producer = total_items / producers;
+    const int items        = per_producer * producers;
+
+    std::atomic<int>  consumed{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < per_producer; ++i) {
+                while (!q.push(static_cast<std::uint64_t>(i))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            std::uint64_t item = 0;
+            while (consumed.load(std::memory_order_relaxed) < items) {
+                if (q.pop(item)) {
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    Timer timer;
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    return items / (timer.elapsed_ns() / 1000.0);
+}
+
+void benchmark_mpmc_scaling() {
+    std::cout << "\n--- MPMC throughput, P producers x C consumers (Mops/s) ---\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    constexpr int total_items = 2'000'000;
+    const int configs[] = {1, 2, 4, 8, 16};
+
+    for (int n : configs) {
+        std::cout << std::setw(2) << n << "x" << std::left << std::setw(2) << n << std::right
+                  << " | MPMCQueue: " << std::setw(7)
+                  << throughput_mops<lock_free::MPMCQueue<std::uint64_t, 1024>>(n, n, total_items)
+                  << " | mutex + std::queue: " << std::setw(7)
+                  << throughput_mops<MutexQueue<std::uint64_t, 1024>>(n, n, total_items)
+                  << "\n";
+    }
+}
+
+// ============================================================================
+// SPSC: streaming throughput and ping-pong latency
+// ============================================================================
+
+// push() that reports success, so the unbounded queue fits the stream loop
+struct UnboundedAdapter : lock_free::UnboundedSPSCQueue<std::uint64_t> {
+    bool push(std::uint64_t v) {
+        UnboundedSPSCQueue::push(v);
+        return true;
+    }
+};
+
+// One producer streams `items` integers to one consumer. Returns Mops/s.
+// args... are forwarded to the queue constructor (runtime-sized queues).
+template <typename Queue, typename... Args>
+double spsc_stream_mops(int items, Args... args) {
+    auto q = std::make_unique<Queue>(args...);
+
+    std::thread consumer([&] {
+        std::uint64_t item = 0;
+        int spins = 0;
+        for (int i = 0; i < items; ++i) {
+            while (!q->pop(item)) {
+                backoff(spins);
+            }
+        }
+    });
+
+    Timer timer;
+    int spins = 0;
+    for (int i = 0; i < items; ++i) {
+        while (!q->push(static_cast<std::uint64_t>(i))) {
+            backoff(spins);
+        }
+    }
+    consumer.join();
+    return items / (timer.elapsed_ns() / 1000.0);
+}
+
+// Two queues, one message bouncing between two threads. Returns ns per round trip.
+template <typename Queue>
+double spsc_ping_pong_ns(int round_trips) {
+    auto ping = std::make_unique<Queue>();
+    auto pong = std::make_unique<Queue>();
+
+    std::thread echo([&] {
+        std::uint64_t item = 0;
+        int spins = 0;
+        for (int i = 0; i < round_trips; ++i) {
+            while (!ping->pop(item)) {
+                backoff(spins);
+            }
+            while (!pong->push(item)) {
+                backoff(spins);
+            }
+        }
+    });
+
+    Timer timer;
+    std::uint64_t item = 0;
+    int spins = 0;
+    for (int i = 0; i < round_trips; ++i) {
+        while (!ping->push(static_cast<std::uint64_t>(i))) {
+            backoff(spins);
+        }
+        while (!pong->pop(item)) {
+            backoff(spins);
+        }
+    }
+    echo.join();
+    return timer.elapsed_ns() / round_trips;
+}
+
+// Same stream, moved in batches with push_bulk / pop_bulk
+double spsc_stream_bulk_mops(int items, std::size_t batch) {
+    auto q = std::make_unique<lock_free::SPSCQueue<std::uint64_t, 1024>>();
+
+    std::thread consumer([&] {
+        std::vector<std::uint64_t> out(batch);
+        int received = 0;
+        int spins    = 0;
+        while (received < items) {
+            const std::size_t n = q->pop_bulk(out.begin(), batch);
+            if (n == 0) {
+                backoff(spins);
+            }
+            received += static_cast<int>(n);
+        }
+    });
+
+    std::vector<std::uint64_t> in(batch);
+    Timer timer;
+    int sent  = 0;
+    int spins = 0;
+    while (sent < items) {
+        const std::size_t count = std::min<std::size_t>(batch, items - sent);
+        for (std::size_t i = 0; i < count; ++i) {
+            in[i] = static_cast<std::uint64_t>(sent) + i;
+        }
+        std::size_t pushed = 0;
+        while (pushed < count) {
+            const std::size_t n = q->push_bulk(in.begin() + pushed, in.begin() + count);
+            if (n == 0) {
+                backoff(spins);
+            }
+            pushed += n;
+        }
+        sent += static_cast<int>(count);
+    }
+    consumer.join();
+    return items / (timer.elapsed_ns() / 1000.0);
+}
+
+// Same stream, written and read in place with claim/commit
+double spsc_stream_claim_mops(int items, std::size_t batch) {
+    auto q = std::make_unique<lock_free::SPSCQueue<std::uint64_t, 1024>>();
+
+    std::thread consumer([&] {
+        std::uint64_t sum = 0;
+        int received = 0;
+        int spins    = 0;
+        while (received < items) {
+            std::span<std::uint64_t> r = q->claim_read(batch);
+            if (r.empty()) {
+                backoff(spins);
+                continue;
+            }
+            for (std::uint64_t v : r) {
+                sum += v;
+            }
+            q->commit_read(r.size());
+            received += static_cast<int>(r.size());
+        }
+        do_not_optimize(sum);
+    });
+
+    Timer timer;
+    int sent  = 0;
+    int spins = 0;
+    while (sent < items) {
+        std::span<std::uint64_t> w =
+            q->claim_write(std::min<std::size_t>(batch, items - sent));
+        if (w.empty()) {
+            backoff(spins);
+            continue;
+        }
+        for (std::size_t i = 0; i < w.size(); ++i) {
+            w[i] = static_cast<std::uint64_t>(sent) + i;
+        }
+        q->commit_write(w.size());
+        sent += static_cast<int>(w.size());
+    }
+    consumer.join();
+    return items / (timer.elapsed_ns() / 1000.0);
+}
+
+// Bursty producer: `bursts` bursts of `burst` items, consumer draining
+// steadily. Returns the producer's average ns per burst, i.e. how long a
+// burst holds up the producing thread.
+template <typename Queue>
+double spsc_burst_producer_ns(int bursts, int burst) {
+    auto q = std::make_unique<Queue>();
+    const int items = bursts * burst;
+
+    std::thread consumer([&] {
+        std::uint64_t item = 0;
+        int spins = 0;
+        for (int i = 0; i < items; ++i) {
+            while (!q->pop(item)) {
+                backoff(spins);
+            }
+        }
+    });
+
+    double producer_ns = 0;
+    int spins = 0;
+    for (int b = 0; b < bursts; ++b) {
+        Timer timer;
+        for (int i = 0; i < burst; ++i) {
+            if constexpr (std::is_void_v<decltype(q->push(std::uint64_t{}))>) {
+                q->push(static_cast<std::uint64_t>(i));
+            } else {
+                while (!q->push(static_cast<std::uint64_t>(i))) {
+                    backoff(spins);
+                }
+            }
+        }
+        producer_ns += timer.elapsed_ns();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));  // quiet period
+    }
+    consumer.join();
+    return producer_ns / bursts;
+}
+
+// ============================================================================
+// Wait strategies: wake-up latency after idle gaps, and idle CPU cost
+// ============================================================================
+
+struct WakeResult {
+    double avg_latency_us;
+    double consumer_cpu_percent;
+};
+
+// Producer sends `messages` timestamps, sleeping `gap` between them; the
+// consumer blocks in pop_wait and records send -> receive latency.
+template <typename Wait>
+WakeResult wake_up_latency(int messages, std::chrono::microseconds gap) {
+    lock_free::SPSCQueue<std::int64_t, 64, Wait> q;
+
+    auto now_ns = [] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    };
+
+    double total_latency_ns = 0;
+    double consumer_cpu_ns  = 0;
+
+    Timer wall;
+    std::thread consumer([&] {
+        timespec cpu_start{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_start);
+
+        for (int i = 0; i < messages; ++i) {
+            std::int64_t sent = 0;
+            q.pop_wait(sent);
+            total_latency_ns += static_cast<double>(now_ns() - sent);
+        }
+
+        timespec cpu_end{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
+        consumer_cpu_ns = (cpu_end.tv_sec - cpu_start.tv_sec) * 1e9 +
+                          static_cast<double>(cpu_end.tv_nsec - cpu_start.tv_nsec);
+    });
+
+    for (int i = 0; i < messages; ++i) {
+        std::this_thread::sleep_for(gap);
+        q.push_wait(now_ns());
+    }
+    consumer.join();
+
+    return {total_latency_ns / messages / 1000.0, 100.0 * consumer_cpu_ns / wall.elapsed_ns()};
+}
+
+template <typename Wait>
+void print_wake_up(const char* name) {
+    const WakeResult r = wake_up_latency<Wait>(200, std::chrono::microseconds(1000));
+    std::cout << std::left << std::setw(15) << name << std::right
+              << " | wake-up " << std::setw(9) << r.avg_latency_us << " us"
+              << " | idle consumer CPU " << std::setw(6) << r.consumer_cpu_percent << " %"
+              << " | streaming " << std::setw(7)
+              << spsc_stream_mops<lock_free::SPSCQueue<std::uint64_t, 1024, Wait>>(5'000'000)
+              << " Mops/s\n";
+}
+
+void benchmark_wait_strategies() {
+    std::cout << "\n--- SPSC wait strategies (1 ms gaps between messages) ---\n";
+    std::cout << "(streaming: push/pop cost with the strategy's wake-up handshake)\n";
+
+    print_wake_up<lock_free::BusySpinWait>("BusySpinWait");
+    print_wake_up<lock_free::SpinYieldWait>("SpinYieldWait");
+    print_wake_up<lock_free::SpinParkWait>("SpinParkWait");
+}
+
+void benchmark_spsc() {
+    std::cout << "\n--- SPSC streaming, 1 producer -> 1 consumer (Mops/s) ---\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    constexpr int items = 20'000'000;
+    std::cout << "SPSCQueue (cached indices, mask) : " << std::setw(8)
+              << spsc_stream_mops<lock_free::SPSCQueue<std::uint64_t, 1024>>(items) << "\n";
+    std::cout << "Legacy SPSC (modulo, no cache)   : " << std::setw(8)
+              << spsc_stream_mops<LegacySPSCQueue<std::uint64_t, 1024>>(items) << "\n";
+    std::cout << "HeapSPSCQueue (runtime 1024)     : " << std::setw(8)
+              << spsc_stream_mops<lock_free::HeapSPSCQueue<std::uint64_t>>(items, 1024) << "\n";
+    std::cout << "UnboundedSPSCQueue (segment 1024): " << std::setw(8)
+              << spsc_stream_mops<UnboundedAdapter>(items) << "\n";
+
+    for (std::size_t batch : {8, 32, 128}) {
+        std::cout << "push_bulk/pop_bulk, batch " << std::setw(3) << batch << "   : " << std::setw(8)
+                  << spsc_stream_bulk_mops(items, batch) << "\n";
+        std::cout << "claim/commit,       batch " << std::setw(3) << batch << "   : " << std::setw(8)
+                  << spsc_stream_claim_mops(items, batch) << "\n";
+    }
+
+    // A ring much larger than the TLB reach of 4 KB pages (64 MB of slots)
+    constexpr std::size_t big = std::size_t{1} << 23;
+    const bool hugetlb =
+        lock_free::HeapSPSCQueue<std::uint64_t>(1, lock_free::PageSize::Huge2M).huge_pages();
+
+    std::cout << "\n--- SPSC streaming through a 64 MB ring (Mops/s) ---\n";
+    std::cout << "HeapSPSCQueue, 4 KB pages        : " << std::setw(8)
+              << spsc_stream_mops<lock_free::HeapSPSCQueue<std::uint64_t>>(
+                     items, big, lock_free::PageSize::Default)
+              << "\n";
+    std::cout << "HeapSPSCQueue, 2 MB pages        : " << std::setw(8)
+              << spsc_stream_mops<lock_free::HeapSPSCQueue<std::uint64_t>>(
+                     items, big, lock_free::PageSize::Huge2M)
+              << (hugetlb ? "  (hugetlbfs)" : "  (transparent huge pages, if enabled)") << "\n";
+
+
+    std::cout << "\n--- SPSC bursts of 100k items (producer us per burst) ---\n";
+    std::cout << "SPSCQueue<1024> (spin when full) : " << std::setw(8)
+              << spsc_burst_producer_ns<lock_free::SPSCQueue<std::uint64_t, 1024>>(20, 100'000) /
+                     1000.0
+              << "\n";
+    std::cout << "UnboundedSPSCQueue               : " << std::setw(8)
+              << spsc_burst_producer_ns<lock_free::UnboundedSPSCQueue<std::uint64_t>>(20, 100'000) /
+                     1000.0
+              << "\n";
+
+    std::cout << "\n--- SPSC ping-pong (ns per round trip) ---\n";
+
+    constexpr int round_trips = 1'000'000;
+    std::cout << "SPSCQueue (cached indices, mask) : " << std::setw(8)
+              << spsc_ping_pong_ns<lock_free::SPSCQueue<std::uint64_t, 1024>>(round_trips) << "\n";
+    std::cout << "Legacy SPSC (modulo, no cache)   : " << std::setw(8)
+              << spsc_ping_pong_ns<LegacySPSCQueue<std::uint64_t, 1024>>(round_trips) << "\n";
+}
+
+// ============================================================================
+// Fan-out to several consumers: one multicast ring vs one SPSC queue each
+// ============================================================================
+
+struct Event {
+    std::uint64_t seq;
+    std::uint64_t payload[7];  // one cache line per event
+};
+
+// Returns million events per second delivered to every consumer
+double fanout_multicast_mops(int events, int consumers) {
+    auto ring = std::make_unique<lock_free::MulticastRing<Event, 1024>>();
+    std::vector<lock_free::MulticastRing<Event, 1024>::Consumer*> handles;
+    for (int c = 0; c < consumers; ++c) {
+        handles.push_back(&ring->add_consumer());
+    }
+
+    std::vector<std::thread> threads;
+    for (auto* consumer : handles) {
+        threads.emplace_back([consumer, events] {
+            std::uint64_t sum   = 0;
+            int           seen  = 0;
+            int           spins = 0;
+            while (seen < events) {
+                const std::size_t n = consumer->poll(
+                    [&](const Event& e, std::size_t) { sum += e.seq + e.payload[0]; });
+                if (n == 0) {
+                    backoff(spins);
+                }
+                seen += static_cast<int>(n);
+            }
+            do_not_optimize(sum);
+        });
+    }
+
+    Timer timer;
+    Event e{};
+    int spins = 0;
+    for (int i = 0; i < events; ++i) {
+        e.seq        = static_cast<std::uint64_t>(i);
+        e.payload[0] = e.seq;
+        while (!ring->push(e)) {
+            backoff(spins);
+        }
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return events / (timer.elapsed_ns() / 1000.0);
+}
+
+double fanout_spsc_copies_mops(int events, int consumers) {
+    using Queue = lock_free::SPSCQueue<Event, 1024>;
+    std::vector<std::unique_ptr<Queue>> queues;
+    for (int c = 0; c < consumers; ++c) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+
+    std::vector<std::thread> threads;
+    for (auto& q : queues) {
+        threads.emplace_back([queue = q.get(), events] {
+            std::uint64_t sum = 0;
+            Event e{};
+            int spins = 0;
+            for (int i = 0; i < events; ++i) {
+                while (!queue->pop(e)) {
+                    backoff(spins);
+                }
+                sum += e.seq + e.payload[0];
+            }
+            do_not_optimize(sum);
+        });
+    }
+
+    Timer timer;
+    Event e{};
+    int spins = 0;
+    for (int i = 0; i < events; ++i) {
+        e.seq        = static_cast<std::uint64_t>(i);
+        e.payload[0] = e.seq;
+        for (auto& q : queues) {
+            while (!q->push(e)) {
+                backoff(spins);
+            }
+        }
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return events / (timer.elapsed_ns() / 1000.0);
+}
+
+void benchmark_fanout() {
+    std::cout << "\n--- Fan-out of 64-byte events to N consumers (M events/s) ---\n";
+
+    constexpr int events = 2'000'000;
+    for (int consumers : {1, 3, 6}) {
+        std::cout << "N = " << consumers << " | MulticastRing " << std::setw(8)
+                  << fanout_multicast_mops(events, consumers) << " | SPSCQueue per consumer "
+                  << std::setw(8) << fanout_spsc_copies_mops(events, consumers) << "\n";
+    }
+}
+
+// ============================================================================
+// Cross-process: shared-memory SPSC vs Unix domain socket
+// ============================================================================
+
+// Two shm queues (ping, pong) between this process and a forked echo
+// process. Returns ns per round trip.
+template <typename Wait>
+double ipc_shm_ping_pong_ns(int round_trips) {
+    using Queue = lock_free::ShmSPSCQueue<std::uint64_t, Wait>;
+
+    const std::string base = "/lfq_bench_" + std::to_string(::getpid());
+    auto ping = Queue::create(base + "_ping", 64);
+    auto pong = Queue::create(base + "_pong", 64);
+
+    std::cout.flush();
+    const pid_t child = ::fork();
+    if (child == 0) {
+        auto in  = Queue::attach(base + "_ping");
+        auto out = Queue::attach(base + "_pong");
+        std::uint64_t item = 0;
+        for (int i = 0; i < round_trips; ++i) {
+            in.pop_wait(item);
+            out.push_wait(item);
+        }
+        ::_exit(0);
+    }
+
+    Timer timer;
+    std::uint64_t item = 0;
+    for (int i = 0; i < round_trips; ++i) {
+        ping.push_wait(static_cast<std::uint64_t>(i));
+        pong.pop_wait(item);
+    }
+    const double ns = timer.elapsed_ns() / round_trips;
+
+    ::waitpid(child, nullptr, 0);
+    Queue::unlink(base + "_ping");
+    Queue::unlink(base + "_pong");
+    return ns;
+}
+
+// Same exchange over a socketpair(AF_UNIX, SOCK_STREAM)
+double ipc_socket_ping_pong_ns(int round_trips) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return 0;
+    }
+
+    std::cout.flush();
+    const pid_t child = ::fork();
+    if (child == 0) {
+        ::close(fds[0]);
+        std::uint64_t item = 0;
+        for (int i = 0; i < round_trips; ++i) {
+            if (::read(fds[1], &item, sizeof(item)) != sizeof(item)) break;
+            if (::write(fds[1], &item, sizeof(item)) != sizeof(item)) break;
+        }
+        ::_exit(0);
+    }
+    ::close(fds[1]);
+
+    Timer timer;
+    std::uint64_t item = 0;
+    for (int i = 0; i < round_trips; ++i) {
+        item = static_cast<std::uint64_t>(i);
+        if (::write(fds[0], &item, sizeof(item)) != sizeof(item)) break;
+        if (::read(fds[0], &item, sizeof(item)) != sizeof(item)) break;
+    }
+    const double ns = timer.elapsed_ns() / round_trips;
+
+    ::close(fds[0]);
+    ::waitpid(child, nullptr, 0);
+    return ns;
+}
+
+void benchmark_ipc() {
+    std::cout << "\n--- Cross-process ping-pong, 8-byte message (ns per round trip) ---\n";
+
+    constexpr int round_trips = 100'000;
+    std::cout << "ShmSPSCQueue, SpinParkWait      : " << std::setw(9)
+              << ipc_shm_ping_pong_ns<lock_free::SpinParkWait>(round_trips) << "\n";
+    std::cout << "ShmSPSCQueue, SpinYieldWait     : " << std::setw(9)
+              << ipc_shm_ping_pong_ns<lock_free::SpinYieldWait>(round_trips) << "\n";
+    std::cout << "Unix domain socket (socketpair) : " << std::setw(9)
+              << ipc_socket_ping_pong_ns(round_trips) << "\n";
+}
+
+int main() {
+    std::cout << "\n" << std::string(70, '=');
+    std::cout << "\nlock_free_queue benchmarks\n";
+    std::cout << std::string(70, '=') << "\n";
+
+    benchmark_spsc();
+    benchmark_wait_strategies();
+    benchmark_fanout();
+    benchmark_ipc();
+    benchmark_mpmc_scaling();
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "reclamation/epoch.hpp"
+#include "reclamation/hazard_pointer.hpp"
+
+using namespace reclamation;
+
+class Timer {
+public:
+    Timer() : start_(std::chrono::steady_clock::now()) {}
+
+    double elapsed_ns() const {
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Node {
+    long               value;
+    std::atomic<Node*> next{nullptr};
+
+    explicit Node(long v) : value(v) {}
+};
+
+// Singly linked list of `length` nodes
+static std::atomic<Node*>* build_list(int length) {
+    auto* head = new std::atomic<Node*>{nullptr};
+    for (int i = length - 1; i >= 0; --i) {
+        auto* n = new Node(i);
+        n->next.store(head->load(std::memory_order_relaxed), std::memory_order_relaxed);
+        head->store(n, std::memory_order_relaxed);
+    }
+    return head;
+}
+
+static void destroy_list(std::atomic<Node*>* head) {
+    Node* n = head->load();
+    while (n) {
+        Node* next = n->next.load();
+        delete n;
+        n = next;
+    }
+    delete head;
+}
+
+// ============================================================================
+// Traversal: read-side cost per node visited
+// ============================================================================
+
+static long traverse_unprotected(const std::atomic<Node*>& head) {
+    long sum = 0;
+    for (Node* n = head.load(std::memory_order_acquire); n;
+         n = n->next.load(std::memory_order_acquire)) {
+        sum += n->value;
+    }
+    return sum;
+}
+
+// Hand-over-hand: protect the next node before releasing the current one
+static long traverse_hazard(const std::atomic<Node*>& head) {
+    HazardPointer hp_cur;
+    HazardPointer hp_next;
+
+    long sum = 0;
+    Node* n = hp_cur.protect(head);
+    while (n) {
+        sum += n->value;
+        Node* next = hp_next.protect(n->next);
+        std::swap(hp_cur, hp_next);
+        n = next;
+    }
+    return sum;
+}
+
+// One guard for the whole traversal
+static long traverse_epoch(const std::atomic<Node*>& head) {
+    EpochGuard guard;
+    return traverse_unprotected(head);
+}
+
+template <typename Traverse>
+static double traversal_ns_per_node(const std::atomic<Node*>& head, int length,
+                                    int iterations, Traverse traverse) {
+    Timer timer;
+    for (int i = 0; i < iterations; ++i) {
+        do_not_optimize(traverse(head));
+    }
+    return timer.elapsed_ns() / (static_cast<double>(iterations) * length);
+}
+
+static void benchmark_traversal() {
+    std::cout << "\n--- List traversal, single reader (ns per node) ---\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (int length : {1, 16, 256}) {
+        auto* head = build_list(length);
+        const int iterations = 2'000'000 / length;
+
+        std::cout << std::setw(4) << length << " nodes | "
+                  << "unprotected " << std::setw(6)
+                  << traversal_ns_per_node(*head, length, iterations, traverse_unprotected)
+                  << " | hazard " << std::setw(6)
+                  << traversal_ns_per_node(*head, length, iterations, traverse_hazard)
+                  << " | epoch " << std::setw(6)
+                  << traversal_ns_per_node(*head, length, iterations, traverse_epoch)
+                  << "\n";
+
+        destroy_list(head);
+    }
+}
+
+// ============================================================================
+// Readers vs a writer that keeps replacing the head node
+// ============================================================================
+
+enum class Scheme { Hazard, Epoch };
+
+static double contended_read_ns(Scheme scheme, int readers, int reads_per_reader) {
+    std::atomic<Node*> head{new Node(0)};
+    std::atomic<bool>  stop{false};
+
+    std::thread writer([&] {
+        long v = 1;
+        while (!stop.load(std::memory_order_relaxed)) {
+            Node* old = head.exchange(new Node(v++), std::memory_order_acq_rel);
+            if (scheme == Scheme::Hazard) {
+                HazardPointerDomain::global().retire(old);
+            } else {
+                EpochDomain::global().retire(old);
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<std::thread> threads;
+    Timer timer;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            long sum = 0;
+            for (int i = 0; i < reads_per_reader; ++i) {
+                if (scheme == Scheme::Hazard) {
+                    HazardPointer hp;
+                    sum += hp.protect(head)->value;
+                } else {
+                    EpochGuard guard;
+                    sum += head.load(std::memory_order_acquire)->value;
+                }
+            }
+            do_not_optimize(sum);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const double ns = timer.elapsed_ns() / reads_per_reader;
+
+    stop.store(true);
+    writer.join();
+    delete head.load();
+    return ns;
+}
+
+static void benchmark_contended_reads() {
+    std::cout << "\n--- 1 writer + N readers (wall ns per read) ---\n";
+
+    const int reads = 500'000;
+    for (int readers : {1, 2, 4, 8}) {
+        std::cout << std::setw(2) << readers << " readers | "
+                  << "hazard " << std::setw(8) << contended_read_ns(Scheme::Hazard, readers, reads)
+                  << " | epoch " << std::setw(8) << contended_read_ns(Scheme::Epoch, readers, reads)
+                  << "\n";
+    }
+}
+
+int main() {
+    std::cout << "\n" << std::string(70, '=');
+    std::cout << "\nreclamation benchmarks\n";
+    std::cout << std::string(70, '=') << "\n";
+
+    benchmark_traversal();
+    benchmark_contended_reads();
+
+    return 0;
+}
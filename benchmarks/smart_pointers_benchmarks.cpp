@@ -0,0 +1,323 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "smart_pointers/shared_ptr.hpp"
+#include "smart_pointers/intrusive_ptr.hpp"
+#include "smart_pointers/atomic_shared_ptr.hpp"
+#include "smart_pointers/biased_ref_count.hpp"
+#include "memory_pool/pool_allocator.hpp"
+
+using namespace smart_pointers;
+
+// Count global heap allocations so creation paths can be compared
+static std::atomic<std::size_t> g_heap_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+class Timer {
+public:
+    Timer() : start_(std::chrono::steady_clock::now()) {}
+
+    double elapsed_ns() const {
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Keep the compiler from eliding copies whose result is unused
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Payload {
+    int value{0};
+};
+
+// ============================================================================
+// Reference-count policies: copy + destroy
+// ============================================================================
+
+template <typename RefCount>
+double copy_destroy_ns(const SharedPtr<Payload, RefCount>& sp, int iterations) {
+    Timer timer;
+    for (int i = 0; i < iterations; ++i) {
+        SharedPtr<Payload, RefCount> copy = sp;
+        do_not_optimize(copy);
+    }
+    return timer.elapsed_ns() / iterations;
+}
+
+// Every thread copies the same pointer: all RMWs hit one cache line
+// (BiasedRefCount: no worker owns the pointer, so all take the shared path)
+template <typename RefCount>
+double contended_copy_destroy_ns(int threads, int iterations) {
+    auto sp = make_shared<Payload, RefCount>();
+
+    std::vector<std::thread> workers;
+    Timer timer;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&sp, iterations] {
+            copy_destroy_ns(sp, iterations);
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    return timer.elapsed_ns() / iterations;
+}
+
+// Every thread copies its own pointer: atomic cost without line bouncing
+template <typename RefCount>
+double uncontended_copy_destroy_ns(int threads, int iterations) {
+    std::vector<std::thread> workers;
+    Timer timer;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([iterations] {
+            auto sp = make_shared<Payload, RefCount>();
+            copy_destroy_ns(sp, iterations);
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    return timer.elapsed_ns() / iterations;
+}
+
+void benchmark_ref_count_policies() {
+    std::cout << "\n--- SharedPtr copy+destroy: single thread ---\n";
+
+    constexpr int iterations = 10'000'000;
+
+    auto plain  = make_shared<Payload, NonAtomicRefCount>();
+    auto atomic = make_shared<Payload, AtomicRefCount>();
+    auto biased = make_shared<Payload, BiasedRefCount>();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "NonAtomicRefCount: " << copy_destroy_ns(plain, iterations)  << " ns/op\n";
+    std::cout << "AtomicRefCount   : " << copy_destroy_ns(atomic, iterations) << " ns/op\n";
+    std::cout << "BiasedRefCount   : " << copy_destroy_ns(biased, iterations) << " ns/op (owner thread)\n";
+
+    // Same biased pointer copied from a thread that does not own it
+    double biased_remote = 0;
+    std::thread remote([&] { biased_remote = copy_destroy_ns(biased, iterations); });
+    remote.join();
+    std::cout << "BiasedRefCount   : " << biased_remote << " ns/op (other thread)\n";
+
+    std::cout << "\n--- SharedPtr copy+destroy: multi-threaded (wall ns per iteration) ---\n";
+
+    constexpr int mt_iterations = 2'000'000;
+    const int thread_counts[] = {1, 2, 4, 8};
+
+    for (int threads : thread_counts) {
+        std::cout << std::setw(2) << threads << " threads | "
+                  << "Atomic shared ptr: " << std::setw(8)
+                  << contended_copy_destroy_ns<AtomicRefCount>(threads, mt_iterations) << " ns | "
+                  << "Biased shared ptr: " << std::setw(8)
+                  << contended_copy_destroy_ns<BiasedRefCount>(threads, mt_iterations) << " ns | "
+                  << "Atomic per-thread: " << std::setw(8)
+                  << uncontended_copy_destroy_ns<AtomicRefCount>(threads, mt_iterations) << " ns | "
+                  << "NonAtomic per-thread: " << std::setw(8)
+                  << uncontended_copy_destroy_ns<NonAtomicRefCount>(threads, mt_iterations) << " ns\n";
+    }
+}
+
+// ============================================================================
+// Creation: two allocations (SharedPtr(new T)) vs fused make_shared
+// ============================================================================
+
+struct Order {
+    long   id{0};
+    double price{0.0};
+    int    qty{0};
+};
+
+template <typename Create>
+void report_creation(const char* label, int iterations, Create&& create) {
+    const std::size_t before = g_heap_allocations.load(std::memory_order_relaxed);
+
+    Timer timer;
+    for (int i = 0; i < iterations; ++i) {
+        auto sp = create(i);
+        do_not_optimize(sp);
+    }
+    const double ns = timer.elapsed_ns() / iterations;
+
+    const std::size_t allocs = g_heap_allocations.load(std::memory_order_relaxed) - before;
+    std::cout << std::left << std::setw(34) << label << std::right
+              << std::setw(8) << ns << " ns/op | "
+              << static_cast<double>(allocs) / iterations << " heap allocs/op\n";
+}
+
+void benchmark_creation_paths() {
+    std::cout << "\n--- SharedPtr creation + destruction ---\n";
+
+    constexpr int iterations = 5'000'000;
+
+    report_creation("SharedPtr<T>(new T) [2 allocs]", iterations, [](int i) {
+        return SharedPtr<Order>(new Order{i, 1.5, 10});
+    });
+
+    report_creation("make_shared<T> [fused]", iterations, [](int i) {
+        return make_shared<Order>(Order{i, 1.5, 10});
+    });
+
+    memory_pool::FixedBlockMemoryPool pool(128, 16);
+    memory_pool::PoolAllocator<Order> alloc(pool);
+    report_creation("allocate_shared<T>(PoolAllocator)", iterations, [&alloc](int i) {
+        return allocate_shared<Order>(alloc, Order{i, 1.5, 10});
+    });
+}
+
+// ============================================================================
+// Intrusive vs control-block counting
+// ============================================================================
+
+struct IntrusiveOrder : IntrusiveRefCounted<IntrusiveOrder> {
+    long   id{0};
+    double price{0.0};
+    int    qty{0};
+
+    IntrusiveOrder(long i, double p, int q) : id(i), price(p), qty(q) {}
+};
+
+void benchmark_intrusive_ptr() {
+    std::cout << "\n--- IntrusivePtr vs SharedPtr (NonAtomicRefCount) ---\n";
+
+    constexpr int iterations = 5'000'000;
+
+    report_creation("make_intrusive<T>", iterations, [](int i) {
+        return make_intrusive<IntrusiveOrder>(i, 1.5, 10);
+    });
+
+    auto ip = make_intrusive<IntrusiveOrder>(1, 1.5, 10);
+    Timer timer;
+    for (int i = 0; i < iterations; ++i) {
+        IntrusivePtr<IntrusiveOrder> copy = ip;
+        do_not_optimize(copy);
+    }
+    std::cout << std::left << std::setw(34) << "IntrusivePtr copy+destroy" << std::right
+              << std::setw(8) << timer.elapsed_ns() / iterations << " ns/op | "
+              << sizeof(IntrusivePtr<IntrusiveOrder>) << " bytes/pointer\n";
+
+    auto sp = make_shared<Payload>();
+    std::cout << std::left << std::setw(34) << "SharedPtr copy+destroy" << std::right
+              << std::setw(8) << copy_destroy_ns(sp, iterations) << " ns/op | "
+              << sizeof(SharedPtr<Payload>) << " bytes/pointer\n";
+}
+
+// ============================================================================
+// Snapshot publishing: 1 writer, N readers
+// ============================================================================
+
+struct RoutingTable {
+    int version{0};
+    int routes[16]{};
+};
+
+using TablePtr = SharedPtr<RoutingTable, AtomicRefCount>;
+
+// Baseline: a mutex around the pointer copy/swap
+class MutexSnapshot {
+public:
+    explicit MutexSnapshot(TablePtr p) : ptr_(std::move(p)) {}
+
+    TablePtr load() const {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return ptr_;
+    }
+
+    void store(TablePtr p) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        ptr_.swap(p);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    TablePtr           ptr_;
+};
+
+// Returns average reader ns per load (wall time / loads per reader)
+template <typename Holder>
+double snapshot_reader_ns(int readers, int loads_per_reader) {
+    Holder holder(make_shared<RoutingTable, AtomicRefCount>());
+    std::atomic<bool> stop{false};
+
+    std::thread writer([&] {
+        int version = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto next = make_shared<RoutingTable, AtomicRefCount>();
+            next->version = ++version;
+            holder.store(std::move(next));
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<std::thread> threads;
+    Timer timer;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&holder, loads_per_reader] {
+            long sum = 0;
+            for (int i = 0; i < loads_per_reader; ++i) {
+                auto snap = holder.load();
+                sum += snap->version;
+            }
+            do_not_optimize(sum);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const double ns = timer.elapsed_ns() / loads_per_reader;
+
+    stop.store(true);
+    writer.join();
+    return ns;
+}
+
+void benchmark_snapshot_publishing() {
+    std::cout << "\n--- Snapshot load with 1 writer + N readers (wall ns per load) ---\n";
+
+    constexpr int loads = 1'000'000;
+    const int reader_counts[] = {1, 2, 4, 8};
+
+    for (int readers : reader_counts) {
+        std::cout << std::setw(2) << readers << " readers | "
+                  << "mutex + SharedPtr: " << std::setw(8)
+                  << snapshot_reader_ns<MutexSnapshot>(readers, loads) << " ns | "
+                  << "AtomicSharedPtr: " << std::setw(8)
+                  << snapshot_reader_ns<AtomicSharedPtr<RoutingTable>>(readers, loads) << " ns\n";
+    }
+}
+
+int main() {
+    std::cout << "\n" << std::string(70, '=');
+    std::cout << "\nsmart_pointers benchmarks\n";
+    std::cout << std::string(70, '=') << "\n";
+
+    benchmark_ref_count_policies();
+    benchmark_creation_paths();
+    benchmark_intrusive_ptr();
+    benchmark_snapshot_publishing();
+
+    return 0;
+}
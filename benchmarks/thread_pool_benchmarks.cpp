@@ -0,0 +1,788 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "thread_pool/coroutine.hpp"
+#include "thread_pool/parallel_algorithms.hpp"
+#include "thread_pool/task_group.hpp"
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+#if defined(HAVE_STD_EXECUTION_PAR)
+#include <execution>
+#endif
+
+// Count global heap allocations so submission paths can be compared
+static std::atomic<std::size_t> g_heap_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+class Timer {
+public:
+    Timer() : start_(std::chrono::steady_clock::now()) {}
+
+    double elapsed_ns() const {
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Baseline: the previous WorkStealingThreadPool design. One std::deque +
+// std::mutex per worker, round-robin submission, every idle check and
+// submit going through one global mutex/condvar.
+class LegacyThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit LegacyThreadPool(std::size_t thread_count) {
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            workers_.emplace_back(std::make_unique<WorkerQueue>());
+        }
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            threads_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ~LegacyThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(global_mutex_);
+            stop_.store(true, std::memory_order_relaxed);
+        }
+        global_cv_.notify_all();
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+
+    template <typename F, typename... Args>
+    auto submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        using R = std::invoke_result_t<F, Args...>;
+        auto task_ptr = std::make_shared<std::packaged_task<R()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::future<R> fut = task_ptr->get_future();
+
+        const std::size_t idx = next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+        {
+            auto& w = *workers_[idx];
+            std::lock_guard<std::mutex> lk(w.mutex);
+            w.tasks.emplace_back([task_ptr] { (*task_ptr)(); });
+        }
+        global_cv_.notify_one();
+        return fut;
+    }
+
+private:
+    struct WorkerQueue {
+        std::deque<Task> tasks;
+        std::mutex       mutex;
+    };
+
+    void worker_loop(std::size_t index) {
+        while (true) {
+            Task task;
+            if (try_pop(index, task)) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(global_mutex_);
+            global_cv_.wait(lk, [this] { return stop_.load() || has_work(); });
+            if (stop_.load() && !has_work()) {
+                break;
+            }
+        }
+    }
+
+    bool try_pop(std::size_t index, Task& out) {
+        const std::size_t n = workers_.size();
+        for (std::size_t offset = 0; offset < n; ++offset) {
+            auto& w = *workers_[(index + offset) % n];
+            std::lock_guard<std::mutex> lk(w.mutex);
+            if (!w.tasks.empty()) {
+                if (offset == 0) {
+                    out = std::move(w.tasks.back());
+                    w.tasks.pop_back();
+                } else {
+                    out = std::move(w.tasks.front());
+                    w.tasks.pop_front();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool has_work() {
+        for (auto& w : workers_) {
+            std::lock_guard<std::mutex> lk(w->mutex);
+            if (!w->tasks.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> workers_;
+    std::vector<std::thread>                  threads_;
+    std::atomic<bool>                         stop_{false};
+    std::atomic<std::size_t>                  next_worker_{0};
+    std::mutex                                global_mutex_;
+    std::condition_variable                   global_cv_;
+};
+
+// ============================================================================
+// Recursive fib: every call is a task that spawns two more
+// ============================================================================
+
+template <typename Pool>
+struct FibRun {
+    Pool&                     pool;
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<std::int64_t> pending{0};
+    std::atomic<std::int64_t> tasks{0};
+
+    void spawn(int n) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.submit([this, n] { step(n); });
+    }
+
+    void step(int n) {
+        tasks.fetch_add(1, std::memory_order_relaxed);
+        if (n < 2) {
+            sum.fetch_add(n, std::memory_order_relaxed);
+        } else {
+            spawn(n - 1);
+            spawn(n - 2);
+        }
+        pending.fetch_sub(1, std::memory_order_release);
+    }
+};
+
+// Returns ns per task
+template <typename Pool>
+double fib_ns_per_task(std::size_t threads, int n) {
+    Pool pool(threads);
+    FibRun<Pool> run{pool};
+
+    Timer timer;
+    run.spawn(n);
+    while (run.pending.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    const double ns = timer.elapsed_ns();
+
+    do_not_optimize(run.sum.load());
+    return ns / static_cast<double>(run.tasks.load());
+}
+
+// Same recursion as fork-join: each call spawns n-1 and joins it
+static std::int64_t fib_task_group(thread_pool::WorkStealingThreadPool& pool, int n,
+                                   std::atomic<std::int64_t>& calls) {
+    calls.fetch_add(1, std::memory_order_relaxed);
+    if (n < 2) {
+        return n;
+    }
+    std::int64_t a = 0;
+    thread_pool::TaskGroup group(pool);
+    group.spawn([&] { a = fib_task_group(pool, n - 1, calls); });
+    const std::int64_t b = fib_task_group(pool, n - 2, calls);
+    group.wait();
+    return a + b;
+}
+
+// Returns ns per call
+double fib_task_group_ns_per_call(std::size_t threads, int n) {
+    thread_pool::WorkStealingThreadPool pool(threads);
+    std::atomic<std::int64_t> calls{0};
+
+    Timer timer;
+    const std::int64_t result = fib_task_group(pool, n, calls);
+    const double ns = timer.elapsed_ns();
+
+    do_not_optimize(result);
+    return ns / static_cast<double>(calls.load());
+}
+
+// ============================================================================
+// Parallel sum: many small chunks submitted from outside the pool
+// ============================================================================
+
+// Returns ns per chunk task
+template <typename Pool>
+double parallel_sum_ns_per_task(std::size_t threads, const std::vector<double>& data,
+                                std::size_t chunk) {
+    Pool pool(threads);
+
+    Timer timer;
+    std::vector<std::future<double>> parts;
+    parts.reserve(data.size() / chunk + 1);
+    for (std::size_t begin = 0; begin < data.size(); begin += chunk) {
+        const std::size_t end = std::min(begin + chunk, data.size());
+        parts.push_back(pool.submit([&data, begin, end] {
+            return std::accumulate(data.begin() + static_cast<std::ptrdiff_t>(begin),
+                                   data.begin() + static_cast<std::ptrdiff_t>(end), 0.0);
+        }));
+    }
+    double total = 0;
+    for (auto& f : parts) {
+        total += f.get();
+    }
+    const double ns = timer.elapsed_ns();
+
+    do_not_optimize(total);
+    return ns / static_cast<double>(parts.size());
+}
+
+void benchmark_fine_grained_tasks() {
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "\n--- Recursive fib(24), one task per call (ns per task, " << threads
+              << " workers) ---\n";
+    std::cout << "WorkStealingThreadPool (Chase-Lev) : " << std::setw(8)
+              << fib_ns_per_task<thread_pool::WorkStealingThreadPool>(threads, 24) << "\n";
+    std::cout << "Legacy pool (mutex deques)         : " << std::setw(8)
+              << fib_ns_per_task<LegacyThreadPool>(threads, 24) << "\n";
+    std::cout << "TaskGroup spawn + helping wait     : " << std::setw(8)
+              << fib_task_group_ns_per_call(threads, 24) << "\n";
+
+    std::vector<double> data(1 << 22, 1.0);
+    Timer serial_timer;
+    double serial = std::accumulate(data.begin(), data.end(), 0.0);
+    do_not_optimize(serial);
+    const double serial_ns = serial_timer.elapsed_ns();
+
+    std::cout << "\n--- Parallel sum of 4M doubles in 1024-element chunks (ns per chunk) ---\n";
+    std::cout << "Serial (whole array / 4096)        : " << std::setw(8) << serial_ns / 4096
+              << "\n";
+    std::cout << "WorkStealingThreadPool (Chase-Lev) : " << std::setw(8)
+              << parallel_sum_ns_per_task<thread_pool::WorkStealingThreadPool>(threads, data, 1024)
+              << "\n";
+    std::cout << "Legacy pool (mutex deques)         : " << std::setw(8)
+              << parallel_sum_ns_per_task<LegacyThreadPool>(threads, data, 1024) << "\n";
+}
+
+// ============================================================================
+// Submission cost: many empty tasks from outside the pool
+// ============================================================================
+
+struct SubmitCost {
+    double ns_per_task;
+    double allocs_per_task;
+};
+
+// Submits `count` tiny tasks through `enqueue(pool, done)` and waits for all
+// of them. One warm-up round first, so pooled allocators are primed.
+template <typename Pool, typename Enqueue>
+SubmitCost submit_cost(std::size_t threads, std::size_t count, Enqueue enqueue) {
+    Pool pool(threads);
+    std::atomic<std::size_t> done{0};
+
+    auto round = [&] {
+        done.store(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            enqueue(pool, done);
+        }
+        while (done.load(std::memory_order_acquire) != count) {
+            std::this_thread::yield();
+        }
+    };
+
+    round();
+    const std::size_t allocs_before = g_heap_allocations.load();
+    Timer timer;
+    round();
+    const double ns = timer.elapsed_ns();
+    const std::size_t allocs = g_heap_allocations.load() - allocs_before;
+
+    return {ns / static_cast<double>(count),
+            static_cast<double>(allocs) / static_cast<double>(count)};
+}
+
+void benchmark_submission_cost() {
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    constexpr std::size_t kTasks = 200000;
+
+    auto bump = [](std::atomic<std::size_t>& done) {
+        done.fetch_add(1, std::memory_order_release);
+    };
+
+    const SubmitCost legacy = submit_cost<LegacyThreadPool>(
+        threads, kTasks, [&](LegacyThreadPool& pool, std::atomic<std::size_t>& done) {
+            pool.submit([&done, &bump] { bump(done); });
+        });
+    const SubmitCost submit = submit_cost<thread_pool::WorkStealingThreadPool>(
+        threads, kTasks, [&](thread_pool::WorkStealingThreadPool& pool, std::atomic<std::size_t>& done) {
+            pool.submit([&done, &bump] { bump(done); });
+        });
+    const SubmitCost post = submit_cost<thread_pool::WorkStealingThreadPool>(
+        threads, kTasks, [&](thread_pool::WorkStealingThreadPool& pool, std::atomic<std::size_t>& done) {
+            pool.post([&done, &bump] { bump(done); });
+        });
+
+    std::cout << "\n--- Submitting 200K empty tasks from outside the pool (" << threads
+              << " workers) ---\n";
+    std::cout << "                                       ns/task   allocs/task\n";
+    auto row = [](const char* name, const SubmitCost& c) {
+        std::cout << name << std::setw(8) << c.ns_per_task << "   " << std::setw(8)
+                  << std::setprecision(2) << c.allocs_per_task << std::setprecision(1) << "\n";
+    };
+    row("Legacy pool submit (packaged_task)   : ", legacy);
+    row("WorkStealingThreadPool submit        : ", submit);
+    row("WorkStealingThreadPool post          : ", post);
+}
+
+// ============================================================================
+// Mostly idle pool: wake-up cost with many parked workers
+// ============================================================================
+
+// One task at a time from outside: every submit has to wake a worker.
+// Returns ns per round trip.
+template <typename Pool>
+double idle_round_trip_ns(std::size_t threads, std::size_t rounds) {
+    Pool pool(threads);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // let workers park
+
+    std::atomic<std::size_t> done{0};
+    Timer timer;
+    for (std::size_t i = 0; i < rounds; ++i) {
+        pool.submit([&done] { done.fetch_add(1, std::memory_order_release); });
+        while (done.load(std::memory_order_acquire) != i + 1) {
+            std::this_thread::yield();
+        }
+    }
+    return timer.elapsed_ns() / static_cast<double>(rounds);
+}
+
+// Bursts of 16 tasks separated by idle gaps: the pool keeps parking and
+// waking. Returns ns per task (burst submit + drain), plus wall time.
+template <typename Pool>
+double burst_ns_per_task(std::size_t threads, std::size_t bursts) {
+    Pool pool(threads);
+    constexpr std::size_t kBurst = 16;
+
+    std::atomic<std::size_t> done{0};
+    double busy_ns = 0;
+    for (std::size_t b = 0; b < bursts; ++b) {
+        Timer timer;
+        for (std::size_t i = 0; i < kBurst; ++i) {
+            pool.submit([&done] { done.fetch_add(1, std::memory_order_release); });
+        }
+        while (done.load(std::memory_order_acquire) != (b + 1) * kBurst) {
+            std::this_thread::yield();
+        }
+        busy_ns += timer.elapsed_ns();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return busy_ns / static_cast<double>(bursts * kBurst);
+}
+
+void benchmark_idle_wakeups() {
+    constexpr std::size_t kThreads = 32;
+    std::cout << "\n--- Mostly idle pool, " << kThreads << " workers (ns) ---\n";
+    std::cout << "                                   round trip   burst ns/task\n";
+    std::cout << "WorkStealingThreadPool           : " << std::setw(10)
+              << idle_round_trip_ns<thread_pool::WorkStealingThreadPool>(kThreads, 2000)
+              << "   " << std::setw(10)
+              << burst_ns_per_task<thread_pool::WorkStealingThreadPool>(kThreads, 300) << "\n";
+    std::cout << "Legacy pool (global condvar)     : " << std::setw(10)
+              << idle_round_trip_ns<LegacyThreadPool>(kThreads, 2000) << "   " << std::setw(10)
+              << burst_ns_per_task<LegacyThreadPool>(kThreads, 300) << "\n";
+}
+
+// ============================================================================
+// Data-parallel algorithms vs serial loops and std::execution::par
+// ============================================================================
+
+template <typename Fn>
+double time_ms(Fn&& fn) {
+    Timer timer;
+    fn();
+    return timer.elapsed_ns() / 1e6;
+}
+
+void benchmark_parallel_algorithms() {
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    thread_pool::WorkStealingThreadPool pool(threads);
+    constexpr std::size_t kN = 1 << 22;
+
+    std::vector<double> src(kN);
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dist(1.0, 2.0);
+    for (auto& x : src) {
+        x = dist(rng);
+    }
+    std::vector<double> dst(kN);
+    auto heavy = [](double x) { return std::sqrt(x) * std::log(x + 1.0); };
+
+    std::cout << "\n--- Data-parallel algorithms on 4M elements (ms, " << threads
+              << " workers) ---\n";
+    std::cout << "                      serial    thread_pool   std::execution::par\n";
+    auto row = [](const char* name, double serial, double pool_ms, double par) {
+        std::cout << name << std::setw(8) << serial << "   " << std::setw(10) << pool_ms;
+        if (par >= 0) {
+            std::cout << "   " << std::setw(10) << par;
+        } else {
+            std::cout << "          n/a";
+        }
+        std::cout << "\n";
+    };
+    double par = -1;
+
+    // transform
+    const double t_serial = time_ms([&] { std::transform(src.begin(), src.end(), dst.begin(), heavy); });
+    const double t_pool   = time_ms([&] {
+        thread_pool::parallel_transform(pool, src.begin(), src.end(), dst.begin(), heavy);
+    });
+#if defined(HAVE_STD_EXECUTION_PAR)
+    par = time_ms([&] { std::transform(std::execution::par, src.begin(), src.end(), dst.begin(), heavy); });
+#endif
+    do_not_optimize(dst[kN / 2]);
+    row("transform (sqrt*log): ", t_serial, t_pool, par);
+
+    // reduce
+    double sum = 0;
+    const double r_serial = time_ms([&] { sum = std::accumulate(src.begin(), src.end(), 0.0); });
+    do_not_optimize(sum);
+    const double r_pool = time_ms([&] {
+        sum = thread_pool::parallel_reduce(pool, src.begin(), src.end(), 0.0);
+    });
+    do_not_optimize(sum);
+#if defined(HAVE_STD_EXECUTION_PAR)
+    par = time_ms([&] { sum = std::reduce(std::execution::par, src.begin(), src.end(), 0.0); });
+    do_not_optimize(sum);
+#endif
+    row("reduce (sum):         ", r_serial, r_pool, par);
+
+    // inclusive scan
+    const double s_serial = time_ms([&] { std::inclusive_scan(src.begin(), src.end(), dst.begin()); });
+    const double s_pool   = time_ms([&] {
+        thread_pool::parallel_scan(pool, src.begin(), src.end(), dst.begin());
+    });
+#if defined(HAVE_STD_EXECUTION_PAR)
+    par = time_ms([&] { std::inclusive_scan(std::execution::par, src.begin(), src.end(), dst.begin()); });
+#endif
+    do_not_optimize(dst[kN - 1]);
+    row("inclusive scan:       ", s_serial, s_pool, par);
+
+    // sort
+    std::vector<double> keys = src;
+    const double o_serial = time_ms([&] { std::sort(keys.begin(), keys.end()); });
+    keys = src;
+    const double o_pool = time_ms([&] { thread_pool::parallel_sort(pool, keys.begin(), keys.end()); });
+#if defined(HAVE_STD_EXECUTION_PAR)
+    keys = src;
+    par = time_ms([&] { std::sort(std::execution::par, keys.begin(), keys.end()); });
+#endif
+    do_not_optimize(keys[0]);
+    row("sort:                 ", o_serial, o_pool, par);
+
+    // parallel_for with a body doing almost nothing: splitting overhead
+    std::atomic<std::size_t> touched{0};
+    const double f_pool = time_ms([&] {
+        thread_pool::parallel_for(pool, 0, kN, [&](std::size_t i) {
+            if (src[i] > 1.999999) {
+                touched.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    });
+    std::size_t serial_touched = 0;
+    const double f_serial = time_ms([&] {
+        for (std::size_t i = 0; i < kN; ++i) {
+            serial_touched += src[i] > 1.999999;
+        }
+    });
+    do_not_optimize(serial_touched);
+    row("for (trivial body):   ", f_serial, f_pool, -1);
+}
+
+// ============================================================================
+// Coroutines: resume cost vs submit + future
+// ============================================================================
+
+static thread_pool::coro::Task<int> ready_child(int x) {
+    co_return x;
+}
+
+void benchmark_coroutines() {
+    namespace coro = thread_pool::coro;
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    thread_pool::WorkStealingThreadPool pool(threads);
+    constexpr int kHops = 200'000;
+
+    // Round trip through the pool with a future: submit, then block in get()
+    Timer future_timer;
+    for (int i = 0; i < kHops; ++i) {
+        do_not_optimize(pool.submit([i] { return i; }).get());
+    }
+    const double future_ns = future_timer.elapsed_ns() / kHops;
+
+    // One coroutine hopping onto the pool: each co_await posts its handle and
+    // the coroutine continues on whichever worker picks it up
+    auto hops = [](thread_pool::WorkStealingThreadPool& p, int n) -> coro::Task<int> {
+        int sum = 0;
+        for (int i = 0; i < n; ++i) {
+            co_await p.schedule();
+            sum += i & 1;
+        }
+        co_return sum;
+    };
+    Timer schedule_timer;
+    do_not_optimize(coro::sync_wait(hops(pool, kHops)));
+    const double schedule_ns = schedule_timer.elapsed_ns() / kHops;
+
+    // Awaiting a child that completes at once: frame allocation plus the
+    // start / return handshake, no pool involvement
+    auto awaits = [](int n) -> coro::Task<long> {
+        long sum = 0;
+        for (int i = 0; i < n; ++i) {
+            sum += co_await ready_child(i);
+        }
+        co_return sum;
+    };
+    Timer await_timer;
+    do_not_optimize(coro::sync_wait(awaits(kHops * 10)));
+    const double await_ns = await_timer.elapsed_ns() / (kHops * 10);
+
+    std::cout << "\n--- Coroutine resume cost (ns per operation, " << threads
+              << " workers) ---\n";
+    std::cout << "submit(...).get() round trip        : " << std::setw(8) << future_ns << "\n";
+    std::cout << "co_await pool.schedule() hop        : " << std::setw(8) << schedule_ns << "\n";
+    std::cout << "co_await of a ready child Task      : " << std::setw(8) << await_ns << "\n";
+}
+
+// Submit-to-start latency (us) of short requests posted into a pool that is
+// saturated with bulk background tasks; returns {p50, p99}
+static std::pair<double, double> request_latency_under_flood(thread_pool::Priority background,
+                                                             thread_pool::Priority request) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kBackground = 20'000;
+    constexpr int kRequests   = 200;
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+
+    std::vector<double> latencies(kRequests);
+    std::atomic<int>    done{0};
+    {
+        thread_pool::WorkStealingThreadPool pool(threads);
+        for (int i = 0; i < kBackground; ++i) {
+            pool.post({.priority = background}, [] {
+                const auto until = Clock::now() + std::chrono::microseconds(20);
+                while (Clock::now() < until) {
+                }
+            });
+        }
+        for (int i = 0; i < kRequests; ++i) {
+            const auto posted = Clock::now();
+            pool.post({.priority = request}, [&latencies, &done, posted, i] {
+                latencies[static_cast<std::size_t>(i)] =
+                    std::chrono::duration<double, std::micro>(Clock::now() - posted).count();
+                done.fetch_add(1, std::memory_order_release);
+            });
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        while (done.load(std::memory_order_acquire) < kRequests) {
+            std::this_thread::yield();
+        }
+    }  // drains the remaining background work
+
+    std::sort(latencies.begin(), latencies.end());
+    return {latencies[kRequests / 2], latencies[kRequests * 99 / 100]};
+}
+
+void benchmark_priorities() {
+    using thread_pool::Priority;
+    const auto [same_p50, same_p99] = request_latency_under_flood(Priority::normal, Priority::normal);
+    const auto [prio_p50, prio_p99] = request_latency_under_flood(Priority::low, Priority::high);
+
+    std::cout << "\n--- Request latency under a background flood (us, submit to start) ---\n";
+    std::cout << "one class            p50 : " << std::setw(8) << same_p50
+              << "   p99 : " << std::setw(8) << same_p99 << "\n";
+    std::cout << "high over low        p50 : " << std::setw(8) << prio_p50
+              << "   p99 : " << std::setw(8) << prio_p99 << "\n";
+}
+
+// Delayed tasks: cost of arming and cancelling a timer, and how late
+// timers fire, against a sleeping thread per delayed task
+void benchmark_timers() {
+    using Clock = std::chrono::steady_clock;
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    thread_pool::WorkStealingThreadPool pool(threads);
+
+    constexpr int kArmed = 200'000;
+    Timer arm_timer;
+    for (int i = 0; i < kArmed; ++i) {
+        auto fut = pool.submit_after(std::chrono::hours(1), [i] { return i; });
+        do_not_optimize(fut.cancel());
+    }
+    const double arm_ns = arm_timer.elapsed_ns() / kArmed;
+
+    // Lateness (us past the due time) of timers spread over 200 ms
+    constexpr int kFired = 20'000;
+    std::vector<double> late(kFired);
+    std::atomic<int>    fired{0};
+    const auto          start = Clock::now();
+    for (int i = 0; i < kFired; ++i) {
+        const auto due = start + std::chrono::microseconds(i * 10);
+        pool.submit_at(due, [&late, &fired, due, i] {
+            late[static_cast<std::size_t>(i)] =
+                std::chrono::duration<double, std::micro>(Clock::now() - due).count();
+            fired.fetch_add(1, std::memory_order_release);
+        });
+    }
+    while (fired.load(std::memory_order_acquire) < kFired) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::sort(late.begin(), late.end());
+
+    // Baseline: a sleeping std::thread per delayed task
+    constexpr int kThreads = 200;
+    std::vector<double>      thread_late(kThreads);
+    std::vector<std::thread> sleepers;
+    const auto               thread_start = Clock::now();
+    for (int i = 0; i < kThreads; ++i) {
+        const auto due = thread_start + std::chrono::microseconds(i * 1000);
+        sleepers.emplace_back([&thread_late, due, i] {
+            std::this_thread::sleep_until(due);
+            thread_late[static_cast<std::size_t>(i)] =
+                std::chrono::duration<double, std::micro>(Clock::now() - due).count();
+        });
+    }
+    for (auto& t : sleepers) {
+        t.join();
+    }
+    std::sort(thread_late.begin(), thread_late.end());
+
+    std::cout << "\n--- Delayed tasks (timer wheel, " << thread_pool::WorkStealingThreadPool::kTimerTick.count()
+              << " ms ticks) ---\n";
+    std::cout << "submit_after + cancel (ns)          : " << std::setw(8) << arm_ns << "\n";
+    std::cout << "timer wheel  lateness us  p50 : " << std::setw(8) << late[kFired / 2]
+              << "   p99 : " << std::setw(8) << late[kFired * 99 / 100] << "\n";
+    std::cout << "thread/timer lateness us  p50 : " << std::setw(8) << thread_late[kThreads / 2]
+              << "   p99 : " << std::setw(8) << thread_late[kThreads * 99 / 100] << "\n";
+}
+
+// Cache-heavy work with and without pinning workers to CPUs: repeated
+// reductions over an array bigger than L2, and fork-join recursion
+// where stolen halves touch their parent's data
+void benchmark_affinity() {
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<double> data(1 << 20);  // 8 MB
+    std::iota(data.begin(), data.end(), 0.0);
+
+    auto run = [&](bool pin, double& reduce_ms, double& fib_ms) {
+        thread_pool::SchedulingConfig config;
+        config.pin_workers = pin;
+        thread_pool::WorkStealingThreadPool pool(threads, config);
+
+        Timer reduce_timer;
+        for (int pass = 0; pass < 20; ++pass) {
+            do_not_optimize(thread_pool::parallel_reduce(pool, data.begin(), data.end(), 0.0));
+        }
+        reduce_ms = reduce_timer.elapsed_ns() / 1e6;
+
+        std::atomic<std::int64_t> calls{0};
+        Timer fib_timer;
+        for (int rep = 0; rep < 10; ++rep) {
+            do_not_optimize(pool.submit([&] { return fib_task_group(pool, 24, calls); }).get());
+        }
+        fib_ms = fib_timer.elapsed_ns() / 1e6;
+    };
+
+    double free_reduce = 0, free_fib = 0, pinned_reduce = 0, pinned_fib = 0;
+    run(false, free_reduce, free_fib);
+    run(true, pinned_reduce, pinned_fib);
+
+    const thread_pool::CpuTopology topo = thread_pool::CpuTopology::detect();
+    std::cout << "\n--- Worker pinning (ms, " << threads << " workers, " << topo.cpus().size()
+              << " CPUs, topology " << (topo.known() ? "from sysfs" : "unknown") << ") ---\n";
+    std::cout << "                                       unpinned     pinned\n";
+    std::cout << "parallel_reduce 8 MB x 20            : " << std::setw(8) << free_reduce
+              << "   " << std::setw(8) << pinned_reduce << "\n";
+    std::cout << "TaskGroup fib(24) x 10               : " << std::setw(8) << free_fib
+              << "   " << std::setw(8) << pinned_fib << "\n";
+}
+
+// Scheduler counters of one fork-join run (build with
+// -DTHREAD_POOL_METRICS=ON; otherwise they are compiled out)
+void benchmark_metrics() {
+    const std::size_t                   threads = std::max(2u, std::thread::hardware_concurrency());
+    thread_pool::WorkStealingThreadPool pool(threads);
+
+    std::atomic<std::int64_t> calls{0};
+    Timer                     timer;
+    for (int rep = 0; rep < 10; ++rep) {
+        do_not_optimize(pool.submit([&] { return fib_task_group(pool, 24, calls); }).get());
+    }
+    const double ms = timer.elapsed_ns() / 1e6;
+
+    const thread_pool::SchedulerMetrics m = pool.metrics();
+    std::cout << "\n--- Scheduler metrics (TaskGroup fib(24) x 10, " << threads << " workers) ---\n";
+    if (!m.enabled) {
+        std::cout << "counters compiled out (configure with -DTHREAD_POOL_METRICS=ON)\n";
+        return;
+    }
+    const thread_pool::WorkerMetrics total = m.total();
+    std::cout << "time (ms)                            : " << std::setw(8) << ms << "\n";
+    std::cout << "tasks                                : " << std::setw(8) << total.tasks << "\n";
+    std::cout << "local pops / injector pops           : " << std::setw(8) << total.local_pops
+              << "   " << std::setw(8) << total.injector_pops << "\n";
+    std::cout << "steals / failed steal scans          : " << std::setw(8) << total.steals
+              << "   " << std::setw(8) << total.failed_steals << "\n";
+    std::cout << "parks / wake-ups                     : " << std::setw(8) << total.parks
+              << "   " << std::setw(8) << total.wakeups << "\n";
+    std::cout << "busy / idle (ms, all workers)        : " << std::setw(8) << total.busy_ns / 1e6
+              << "   " << std::setw(8) << total.idle_ns / 1e6 << "\n";
+    std::cout << m.to_json() << "\n";
+}
+
+int main() {
+    std::cout << "\n" << std::string(70, '=');
+    std::cout << "\nthread_pool benchmarks\n";
+    std::cout << std::string(70, '=') << "\n";
+
+    benchmark_fine_grained_tasks();
+    benchmark_submission_cost();
+    benchmark_idle_wakeups();
+    benchmark_parallel_algorithms();
+    benchmark_coroutines();
+    benchmark_priorities();
+    benchmark_timers();
+    benchmark_affinity();
+    benchmark_metrics();
+
+    return 0;
+}
@@ -22,6 +22,7 @@
 
 #include "thread_pool/work_stealing_thread_pool.hpp"
 #include "lock_free_queue/spsc_queue.hpp"
+#include "lock_free_queue/mpmc_queue.hpp"
 
 // ============================================================================
 // Example 1: Simple Producer-Consumer with Lock-Free Queue
@@ -30,8 +31,9 @@
 void example_basic_producer_consumer() {
     std::cout << "\n=== Example 1: Basic Producer-Consumer ===\n";
     
-    constexpr int queue_capacity = 100;
-    lock_free::SPSCQueue<int, queue_capacity> queue;
+    // Many pool tasks pop concurrently: needs a multi-consumer queue
+    constexpr int queue_capacity = 128;
+    lock_free::MPMCQueue<int, queue_capacity> queue;
     
     auto pool = std::make_unique<thread_pool::WorkStealingThreadPool>(2);
     
@@ -93,8 +95,10 @@ struct WorkItem {
 void example_worker_pool() {
     std::cout << "\n=== Example 2: Worker Pool Processing ===\n";
     
-    constexpr int queue_capacity = 64;
-    lock_free::SPSCQueue<WorkItem, queue_capacity> work_queue;
+    // Four workers pop concurrently: needs a multi-consumer queue.
+    // All 100 items are enqueued before the workers start, so it must fit them.
+    constexpr int queue_capacity = 128;
+    lock_free::MPMCQueue<WorkItem, queue_capacity> work_queue;
     
     auto pool = std::make_unique<thread_pool::WorkStealingThreadPool>(4);
     
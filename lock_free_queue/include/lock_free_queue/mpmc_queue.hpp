@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lock_free {
+
+/**
+ * Bounded multi-producer / multi-consumer lock-free queue (Vyukov, 2010).
+ *
+ * DESIGN:
+ * - Ring of Capacity cells, each holding a sequence number next to its slot
+ * - enqueue_pos_ / dequeue_pos_ are free-running tickets; the cell for a
+ *   ticket is `ticket & (Capacity - 1)`
+ * - A cell's sequence says whose turn it is:
+ *     seq == ticket          → free, the producer holding `ticket` may fill it
+ *     seq == ticket + 1      → full, the consumer holding `ticket` may drain it
+ *     seq == ticket + Capacity → free again for the next lap
+ * - A thread claims a ticket with one CAS on its cursor, then works on its
+ *   cell without further contention; producers and consumers only meet on
+ *   the cell, never on a shared lock or counter
+ *
+ * MEMORY ORDERING:
+ * - cell sequence: acquire load before using the slot, release store after
+ *   constructing (producer) or destroying (consumer) the element
+ * - cursors: relaxed; they only hand out tickets, the sequence carries the data
+ * - Cursors sit on separate cache lines so producers and consumers do not
+ *   false-share
+ *
+ * LIMITATIONS:
+ * - Capacity must be a power of two (>= 2)
+ * - Lock-free, not wait-free: a producer preempted between claiming a ticket
+ *   and publishing its cell stalls consumers of that cell until it resumes
+ * - If T's constructor throws inside push/emplace, the claimed cell is never
+ *   published and the queue stops delivering past it; use nothrow-constructible
+ *   payloads (pointers, PODs, move-only handles)
+ *
+ * THREAD SAFETY:
+ * - Any number of producers and consumers
+ * - empty()/size() are snapshots, exact only when the queue is quiescent
+ */
+template <typename T, std::size_t Capacity>
+class MPMCQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two >= 2");
+
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Storage                  storage;
+    };
+
+public:
+    MPMCQueue() noexcept {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&)            = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    ~MPMCQueue() {
+        clear();
+    }
+
+    // Returns true if item was enqueued, false if full.
+    bool push(const T& value) {
+        return emplace_impl(value);
+    }
+
+    bool push(T&& value) {
+        return emplace_impl(std::move(value));
+    }
+
+    // Constructs T directly in queue storage. Returns false if full.
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        return emplace_impl(std::forward<Args>(args)...);
+    }
+
+    // Moves the front element into out. Returns false if empty.
+    bool pop(T& out) {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &buffer_[pos & kMask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) -
+                              static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                // Cell is filled for our ticket: try to claim it
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Producer for this ticket has not published yet: empty
+                return false;
+            } else {
+                // Another consumer took this ticket; reload
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* elem = ptr(cell);
+        out = std::move(*elem);
+        elem->~T();
+
+        // Free the cell for the producer one lap ahead
+        cell->sequence.store(pos + Capacity, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Approximate under concurrency.
+    std::size_t size() const noexcept {
+        const std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+    // Drain queue, destroying remaining elements.
+    // Should only be called when guaranteed no producer/consumer access.
+    void clear() noexcept {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        const std::size_t end = enqueue_pos_.load(std::memory_order_relaxed);
+        for (; pos != end; ++pos) {
+            Cell& cell = buffer_[pos & kMask];
+            ptr(&cell)->~T();
+            cell.sequence.store(pos + Capacity, std::memory_order_relaxed);
+        }
+        dequeue_pos_.store(end, std::memory_order_relaxed);
+    }
+
+private:
+    template <typename... Args>
+    bool emplace_impl(Args&&... args) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &buffer_[pos & kMask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) -
+                              static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                // Cell is free for our ticket: try to claim it
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Consumer one lap behind has not freed the cell: full
+                return false;
+            } else {
+                // Another producer took this ticket; reload
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (static_cast<void*>(&cell->storage)) T(std::forward<Args>(args)...);
+
+        // Publish to the consumer holding the same ticket
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    static T* ptr(Cell* cell) noexcept {
+        return std::launder(reinterpret_cast<T*>(&cell->storage));
+    }
+
+    // Producer ticket counter (own cache line: contended by producers only)
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+
+    // Consumer ticket counter (own cache line: contended by consumers only)
+    alignas(64) std::atomic<std::size_t> dequeue_pos_{0};
+
+    // Cells (cache-line aligned, kept off the cursor lines)
+    alignas(64) Cell buffer_[Capacity];
+};
+
+} // namespace lock_free
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace lock_free {
+
+/**
+ * Single-producer, multi-consumer broadcast ring (LMAX Disruptor style).
+ *
+ * Every consumer sees every element. Elements are written once into a slot
+ * and read in place by all consumers, instead of being copied into one
+ * queue per consumer.
+ *
+ * DESIGN:
+ * - Capacity pre-constructed slots (T must be default-constructible); the
+ *   producer assigns into them, nothing is constructed or destroyed per item
+ * - The producer's cursor `published_` counts elements made visible
+ * - Each consumer owns a cursor `consumed_` counting elements it is done with
+ * - A consumer may depend on other consumers: it only sees elements all of
+ *   its dependencies have finished (e.g. "replicate" after "journal").
+ *   Dependencies form a DAG, since a consumer can only name consumers that
+ *   already exist. Consumers without dependencies follow the producer.
+ * - The producer may overwrite a slot once every consumer is past it. It is
+ *   enough to check the gating set: consumers nobody depends on, because
+ *   everyone upstream of them is at least as far along.
+ * - Both sides cache the bound they last read (slowest gating cursor /
+ *   available sequence) and only re-read shared cursors when it runs out.
+ *
+ * MEMORY ORDERING:
+ * - published_: release store after writing the slots, acquire load by
+ *   consumers before reading them
+ * - consumed_: release store after a consumer's last read of the slots,
+ *   acquire load by the producer (before overwriting) and by dependent
+ *   consumers
+ * - Every cursor sits on its own cache line
+ *
+ * LIMITATIONS:
+ * - Capacity must be a power of two
+ * - Consumers must be added before the first element is published; the
+ *   consumer set is fixed from then on
+ * - Consumers read elements as const; a stage that needs to pass results
+ *   downstream writes them elsewhere
+ * - The producer is gated by the slowest consumer: one stalled consumer
+ *   stalls the whole ring (by design, nothing is dropped)
+ *
+ * THREAD SAFETY:
+ * - One producer thread; one thread per Consumer handle
+ */
+template <typename T, std::size_t Capacity>
+class MulticastRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two >= 2");
+    static_assert(std::is_default_constructible_v<T>,
+                  "MulticastRing pre-constructs its slots");
+
+    static constexpr std::size_t kMask = Capacity - 1;
+    static constexpr std::size_t kAll  = std::numeric_limits<std::size_t>::max();
+
+public:
+    class Consumer;
+
+    MulticastRing() = default;
+
+    MulticastRing(const MulticastRing&)            = delete;
+    MulticastRing& operator=(const MulticastRing&) = delete;
+
+    // Register a consumer that sees elements after every consumer in
+    // depends_on has processed them (no dependencies: right after they are
+    // published). Call before publishing; throws std::logic_error after.
+    Consumer& add_consumer(std::initializer_list<const Consumer*> depends_on = {}) {
+        if (published_.load(std::memory_order_relaxed) != 0) {
+            throw std::logic_error("MulticastRing: add consumers before publishing");
+        }
+
+        for (const Consumer* dep : depends_on) {
+            if (dep == nullptr || dep->ring_ != this) {
+                throw std::invalid_argument("MulticastRing: dependency from another ring");
+            }
+        }
+
+        consumers_.push_back(std::unique_ptr<Consumer>(new Consumer(this, depends_on)));
+        Consumer* consumer = consumers_.back().get();
+
+        // Upstream consumers are covered by this one: drop them from the gate
+        std::erase_if(gating_, [&](const Consumer* c) {
+            return std::find(depends_on.begin(), depends_on.end(), c) != depends_on.end();
+        });
+        gating_.push_back(consumer);
+        return *consumer;
+    }
+
+    // ------------------------------------------------------------------
+    // Producer
+    // ------------------------------------------------------------------
+
+    // Producer only. Writes value into the next slot and publishes it.
+    // Returns false if the slowest consumer is a full ring behind.
+    template <typename U>
+    bool push(U&& value) {
+        const std::size_t next = published_.load(std::memory_order_relaxed);
+        if (free_slots(next, 1) == 0) return false;
+
+        slots_[next & kMask] = std::forward<U>(value);
+        published_.store(next + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only. Returns up to max writable slots, contiguous in memory
+    // (possibly fewer when the ring wraps). Fill them, then commit_write(n)
+    // publishes the first n to all consumers at once.
+    std::span<T> claim_write(std::size_t max = kAll) noexcept {
+        const std::size_t next = published_.load(std::memory_order_relaxed);
+        const std::size_t n    = std::min(free_slots(next, max), Capacity - (next & kMask));
+        return {&slots_[next & kMask], n};
+    }
+
+    void commit_write(std::size_t n) noexcept {
+        published_.store(published_.load(std::memory_order_relaxed) + n,
+                         std::memory_order_release);
+    }
+
+    // Elements published so far
+    std::size_t published() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    std::size_t consumer_count() const noexcept { return consumers_.size(); }
+
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+    /**
+     * One consumer's view of the ring. Obtained from add_consumer(); owned
+     * by the ring, used by exactly one thread.
+     */
+    class Consumer {
+    public:
+        Consumer(const Consumer&)            = delete;
+        Consumer& operator=(const Consumer&) = delete;
+
+        // Up to max elements ready for this consumer, contiguous in memory,
+        // to be read in place. They stay valid until commit_read().
+        std::span<const T> claim_read(std::size_t max = kAll) noexcept {
+            const std::size_t next = consumed_.load(std::memory_order_relaxed);
+            std::size_t available  = cached_available_ - next;
+            if (available < max) {
+                cached_available_ = upstream();
+                available         = cached_available_ - next;
+            }
+            const std::size_t n = std::min({max, available, Capacity - (next & kMask)});
+            return {&ring_->slots_[next & kMask], n};
+        }
+
+        // Done with the first n elements of the last claim_read(): releases
+        // them to dependent consumers and, eventually, the producer.
+        void commit_read(std::size_t n) noexcept {
+            consumed_.store(consumed_.load(std::memory_order_relaxed) + n,
+                            std::memory_order_release);
+        }
+
+        // Calls fn(element, sequence) for up to max ready elements (across
+        // the wrap point) and commits them. Returns the number processed.
+        template <typename Fn>
+        std::size_t poll(Fn&& fn, std::size_t max = kAll) {
+            std::size_t done = 0;
+            while (done < max) {
+                const std::span<const T> batch = claim_read(max - done);
+                if (batch.empty()) break;
+
+                std::size_t seq = consumed_.load(std::memory_order_relaxed);
+                for (const T& item : batch) {
+                    fn(item, seq++);
+                }
+                commit_read(batch.size());
+                done += batch.size();
+            }
+            return done;
+        }
+
+        // Elements this consumer has processed
+        std::size_t sequence() const noexcept {
+            return consumed_.load(std::memory_order_acquire);
+        }
+
+    private:
+        friend class MulticastRing;
+
+        Consumer(MulticastRing* ring, std::initializer_list<const Consumer*> depends_on)
+            : ring_(ring), depends_on_(depends_on) {}
+
+        // Highest sequence this consumer may read up to (exclusive)
+        std::size_t upstream() const noexcept {
+            if (depends_on_.empty()) {
+                return ring_->published_.load(std::memory_order_acquire);
+            }
+            std::size_t bound = kAll;
+            for (const Consumer* dep : depends_on_) {
+                bound = std::min(bound, dep->consumed_.load(std::memory_order_acquire));
+            }
+            return bound;
+        }
+
+        MulticastRing*               ring_;
+        std::vector<const Consumer*> depends_on_;
+        std::size_t                  cached_available_{0};
+
+        // Written by this consumer, read by the producer and dependents
+        alignas(64) std::atomic<std::size_t> consumed_{0};
+    };
+
+private:
+    // Slots the producer may write at `next`, up to want. Refreshes the
+    // cached gate only when the cached one says there are fewer than want.
+    std::size_t free_slots(std::size_t next, std::size_t want) noexcept {
+        std::size_t free = Capacity - (next - cached_gate_);
+        if (free < want) {
+            cached_gate_ = slowest_gating();
+            free         = Capacity - (next - cached_gate_);
+        }
+        return std::min(free, want);
+    }
+
+    std::size_t slowest_gating() const noexcept {
+        std::size_t slowest = published_.load(std::memory_order_relaxed);
+        for (const Consumer* c : gating_) {
+            slowest = std::min(slowest, c->consumed_.load(std::memory_order_acquire));
+        }
+        return slowest;
+    }
+
+    // Producer line: cursor + producer-private state
+    alignas(64) std::atomic<std::size_t> published_{0};
+    std::size_t                          cached_gate_{0};  // slowest consumer seen
+    std::vector<const Consumer*>         gating_;          // fixed once publishing starts
+
+    std::vector<std::unique_ptr<Consumer>> consumers_;
+
+    // Pre-constructed slots (cache-line aligned)
+    alignas(64) T slots_[Capacity];
+};
+
+} // namespace lock_free
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace lock_free {
+
+// Capacity argument selecting a runtime-sized, heap-allocated ring
+// (compare std::dynamic_extent)
+inline constexpr std::size_t dynamic_capacity = std::numeric_limits<std::size_t>::max();
+
+// Backing pages for a runtime-sized ring
+enum class PageSize {
+    Default,  // cache-line aligned allocation from the global heap
+    Huge2M,   // 2 MB pages: explicit hugetlbfs pages if the system has them
+              // reserved, else a 2 MB aligned block advised for transparent
+              // huge pages
+};
+
+namespace detail {
+
+/**
+ * Slot storage for the ring buffers.
+ *
+ * FixedRing<T, N>: inline array, slot count and mask are compile-time
+ * constants. HeapRing<T>: separately allocated array sized at construction.
+ * Both round the slot count up to a power of two so an index maps to its
+ * slot with `index & mask()`.
+ *
+ * HUGE PAGES (HeapRing only):
+ * - A multi-megabyte ring on 4 KB pages needs hundreds of TLB entries; the
+ *   producer and consumer sweep through all of them, so TLB misses show up
+ *   in the per-element cost. On 2 MB pages a 64 MB ring needs 32 entries.
+ * - MAP_HUGETLB needs pages reserved in /proc/sys/vm/nr_hugepages. When that
+ *   fails the ring falls back to a 2 MB aligned heap block with
+ *   madvise(MADV_HUGEPAGE), which the kernel may back with transparent huge
+ *   pages. huge_pages() reports whether the explicit mapping succeeded.
+ */
+template <typename T, std::size_t N>
+class FixedRing {
+    static constexpr std::size_t kSlots = std::bit_ceil(N);
+
+public:
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    static constexpr std::size_t capacity() noexcept { return N; }
+    static constexpr std::size_t slots() noexcept { return kSlots; }
+    static constexpr std::size_t mask() noexcept { return kSlots - 1; }
+
+    Storage*       data() noexcept { return buffer_; }
+    const Storage* data() const noexcept { return buffer_; }
+
+private:
+    Storage buffer_[kSlots];
+};
+
+template <typename T>
+class HeapRing {
+public:
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    static constexpr std::size_t kCacheLine    = 64;
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+    HeapRing(std::size_t capacity, PageSize pages) {
+        if (capacity == 0) {
+            throw std::invalid_argument("SPSCQueue capacity must be > 0");
+        }
+        if (capacity > std::numeric_limits<std::size_t>::max() / 2 / sizeof(Storage)) {
+            throw std::length_error("SPSCQueue capacity too large");
+        }
+
+        capacity_ = capacity;
+        slots_    = std::bit_ceil(capacity);
+        mask_     = slots_ - 1;
+        bytes_    = slots_ * sizeof(Storage);
+        align_    = kCacheLine > alignof(Storage) ? kCacheLine : alignof(Storage);
+
+        if (pages == PageSize::Huge2M) {
+            align_ = kHugePageSize;
+            bytes_ = (bytes_ + kHugePageSize - 1) & ~(kHugePageSize - 1);
+            data_  = map_huge(bytes_);
+            if (data_) {
+                huge_ = true;
+                return;
+            }
+        }
+
+        data_ = static_cast<Storage*>(::operator new(bytes_, std::align_val_t{align_}));
+        if (pages == PageSize::Huge2M) {
+            advise_huge(data_, bytes_);
+        }
+    }
+
+    ~HeapRing() {
+        if (huge_) {
+#if defined(__linux__)
+            ::munmap(data_, bytes_);
+#endif
+        } else {
+            ::operator delete(data_, bytes_, std::align_val_t{align_});
+        }
+    }
+
+    HeapRing(const HeapRing&)            = delete;
+    HeapRing& operator=(const HeapRing&) = delete;
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    std::size_t slots() const noexcept { return slots_; }
+    std::size_t mask() const noexcept { return mask_; }
+
+    Storage*       data() noexcept { return data_; }
+    const Storage* data() const noexcept { return data_; }
+
+    // True if the ring sits on explicit (hugetlbfs) 2 MB pages
+    bool huge_pages() const noexcept { return huge_; }
+
+    // Bytes reserved for the slots (rounded up to 2 MB for PageSize::Huge2M)
+    std::size_t bytes() const noexcept { return bytes_; }
+
+private:
+    static Storage* map_huge(std::size_t bytes) noexcept {
+#if defined(__linux__) && defined(MAP_HUGETLB)
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        return p == MAP_FAILED ? nullptr : static_cast<Storage*>(p);
+#else
+        (void)bytes;
+        return nullptr;
+#endif
+    }
+
+    static void advise_huge(void* p, std::size_t bytes) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        ::madvise(p, bytes, MADV_HUGEPAGE);  // best effort
+#else
+        (void)p;
+        (void)bytes;
+#endif
+    }
+
+    Storage*    data_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t slots_{0};
+    std::size_t mask_{0};
+    std::size_t bytes_{0};
+    std::size_t align_{0};
+    bool        huge_{false};
+};
+
+} // namespace detail
+
+} // namespace lock_free
@@ -0,0 +1,396 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lock_free_queue/wait_strategy.hpp"
+
+namespace lock_free {
+
+namespace detail {
+
+// Control block at offset 0 of the shared segment. Holds only integers and
+// atomics (no pointers), so every process can map it at any address.
+struct ShmQueueHeader {
+    static constexpr std::uint64_t kMagic   = 0x5350'5343'5348'4d31;  // "SPSCSHM1"
+    static constexpr std::uint32_t kVersion = 1;
+
+    std::atomic<std::uint64_t> magic{0};  // set last by create()
+    std::uint32_t              version{0};
+    std::uint32_t              element_size{0};
+    std::uint32_t              element_align{0};
+    std::uint64_t              capacity{0};
+    std::uint64_t              slots{0};  // bit_ceil(capacity)
+
+    alignas(64) std::atomic<std::uint64_t> head{0};  // producer
+    alignas(64) std::atomic<std::uint64_t> tail{0};  // consumer
+
+    SharedParker consumer_parker;  // consumer waits for items
+    SharedParker producer_parker;  // producer waits for space
+
+    // Ring slots start here
+    static constexpr std::size_t slots_offset() noexcept {
+        return (sizeof(ShmQueueHeader) + 63) & ~std::size_t{63};
+    }
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "shared-memory queue needs address-free 64-bit atomics");
+
+// Owns one mapping of a shared segment
+class ShmMapping {
+public:
+    ShmMapping() noexcept = default;
+
+    ShmMapping(void* base, std::size_t bytes) noexcept : base_(base), bytes_(bytes) {}
+
+    ~ShmMapping() {
+        if (base_) {
+            ::munmap(base_, bytes_);
+        }
+    }
+
+    ShmMapping(ShmMapping&& other) noexcept
+        : base_(std::exchange(other.base_, nullptr)), bytes_(std::exchange(other.bytes_, 0)) {}
+
+    ShmMapping& operator=(ShmMapping&& other) noexcept {
+        if (this != &other) {
+            if (base_) {
+                ::munmap(base_, bytes_);
+            }
+            base_  = std::exchange(other.base_, nullptr);
+            bytes_ = std::exchange(other.bytes_, 0);
+        }
+        return *this;
+    }
+
+    void*       base() const noexcept { return base_; }
+    std::size_t bytes() const noexcept { return bytes_; }
+
+    // Create (exclusively) and size a segment, then map it. shm = true opens
+    // a POSIX shared-memory object, false a regular file.
+    static ShmMapping create(const std::string& name, std::size_t bytes, bool shm) {
+        const int fd = shm ? ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600)
+                           : ::open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "create " + name);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            const int err = errno;
+            ::close(fd);
+            shm ? ::shm_unlink(name.c_str()) : ::unlink(name.c_str());
+            throw std::system_error(err, std::generic_category(), "ftruncate " + name);
+        }
+        return map(fd, bytes, name);
+    }
+
+    // Map an existing segment in full
+    static ShmMapping open(const std::string& name, bool shm) {
+        const int fd = shm ? ::shm_open(name.c_str(), O_RDWR, 0)
+                           : ::open(name.c_str(), O_RDWR);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + name);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "fstat " + name);
+        }
+        return map(fd, static_cast<std::size_t>(st.st_size), name);
+    }
+
+private:
+    static ShmMapping map(int fd, std::size_t bytes, const std::string& name) {
+        void* base = bytes == 0 ? MAP_FAILED
+                                : ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED, fd, 0);
+        const int err = bytes == 0 ? EINVAL : errno;
+        ::close(fd);  // the mapping keeps the segment alive
+        if (base == MAP_FAILED) {
+            throw std::system_error(err, std::generic_category(), "mmap " + name);
+        }
+        return ShmMapping(base, bytes);
+    }
+
+    void*       base_{nullptr};
+    std::size_t bytes_{0};
+};
+
+} // namespace detail
+
+/**
+ * Single-producer / single-consumer queue between two processes, living in
+ * a POSIX shared-memory object (or a regular file) that both map.
+ *
+ * DESIGN:
+ * - Same algorithm as SPSCQueue: free-running head/tail, power-of-two slot
+ *   count, each side caching the other's index in its own (process-local)
+ *   handle
+ * - The segment holds a header (magic, layout, head, tail, sleeping flags)
+ *   followed by the slots. It contains no pointers: indices are offsets, so
+ *   each process may map it at a different address
+ * - Elements are copied in and out with memcpy, hence the trivially-copyable
+ *   requirement; a slot never holds a live C++ object with a destructor
+ *
+ * LIFECYCLE:
+ *   // process A                                  // process B
+ *   auto q = ShmSPSCQueue<Msg>::create("/feed", 4096);
+ *                                                 auto q = ShmSPSCQueue<Msg>::attach("/feed");
+ *   q.push(msg);                                  q.pop_wait(msg);
+ *   ShmSPSCQueue<Msg>::unlink("/feed");           // (mapping stays valid)
+ *
+ * - create_file / attach_file / unlink_file do the same with a regular file
+ *
+ * - create() fails if the name exists; attach() fails if it does not, is not
+ *   fully initialized, or was created for a different element size/alignment
+ * - Either side may unlink the name once both are attached
+ *
+ * BLOCKING:
+ * - pop_wait / push_wait use the Wait strategy (default SpinParkWait). The
+ *   sleeping flags are futex words in the segment, woken with process-shared
+ *   FUTEX_WAKE. Every publishing call runs the wake-up handshake regardless
+ *   of the strategy, because the other process may use a parking one.
+ *
+ * LIMITATIONS:
+ * - T must be trivially copyable and aligned to at most 64 bytes
+ * - Exactly one producer and one consumer handle across all processes
+ * - A process dying mid-operation is not detected; the segment is left as is
+ * - Futex wake-ups across processes need Linux; elsewhere use BusySpinWait
+ *   or SpinYieldWait
+ */
+template <typename T, typename Wait = SpinParkWait>
+class ShmSPSCQueue {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "ShmSPSCQueue elements are copied between processes with memcpy");
+    static_assert(alignof(T) <= 64, "ShmSPSCQueue element alignment must be <= 64");
+
+    using Header = detail::ShmQueueHeader;
+
+public:
+    using wait_strategy = Wait;
+
+    // Create a new POSIX shared-memory object `name` ("/something") holding
+    // up to `capacity` elements. Throws std::system_error (e.g. EEXIST).
+    static ShmSPSCQueue create(const std::string& name, std::size_t capacity) {
+        return create_impl(name, capacity, true);
+    }
+
+    // Attach to a queue created by create(name, ...). Throws std::system_error
+    // if it does not exist, std::runtime_error if the layout does not match.
+    static ShmSPSCQueue attach(const std::string& name) {
+        return ShmSPSCQueue(detail::ShmMapping::open(name, true));
+    }
+
+    // Same, backed by a regular file (e.g. on /dev/shm or a hugetlbfs mount)
+    static ShmSPSCQueue create_file(const std::string& path, std::size_t capacity) {
+        return create_impl(path, capacity, false);
+    }
+
+    static ShmSPSCQueue attach_file(const std::string& path) {
+        return ShmSPSCQueue(detail::ShmMapping::open(path, false));
+    }
+
+    // Remove the name; existing mappings stay valid. Returns false if it
+    // did not exist.
+    static bool unlink(const std::string& name) noexcept {
+        return ::shm_unlink(name.c_str()) == 0;
+    }
+
+    // Same, for a queue made with create_file()
+    static bool unlink_file(const std::string& path) noexcept {
+        return ::unlink(path.c_str()) == 0;
+    }
+
+    // A moved-from queue holds no mapping and must not be used
+    ShmSPSCQueue(ShmSPSCQueue&& other) noexcept
+        : mapping_(std::move(other.mapping_)),
+          header_(std::exchange(other.header_, nullptr)),
+          slots_(std::exchange(other.slots_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)),
+          mask_(std::exchange(other.mask_, 0)),
+          cached_head_(std::exchange(other.cached_head_, 0)),
+          cached_tail_(std::exchange(other.cached_tail_, 0)) {}
+
+    ShmSPSCQueue& operator=(ShmSPSCQueue&& other) noexcept {
+        if (this != &other) {
+            mapping_     = std::move(other.mapping_);
+            header_      = std::exchange(other.header_, nullptr);
+            slots_       = std::exchange(other.slots_, nullptr);
+            capacity_    = std::exchange(other.capacity_, 0);
+            mask_        = std::exchange(other.mask_, 0);
+            cached_head_ = std::exchange(other.cached_head_, 0);
+            cached_tail_ = std::exchange(other.cached_tail_, 0);
+        }
+        return *this;
+    }
+
+    ShmSPSCQueue(const ShmSPSCQueue&)            = delete;
+    ShmSPSCQueue& operator=(const ShmSPSCQueue&) = delete;
+
+    // Producer only. Returns true if item was enqueued, false if full.
+    bool push(const T& value) noexcept {
+        auto head = header_->head.load(std::memory_order_relaxed);
+
+        if (head - cached_tail_ == capacity_) {
+            cached_tail_ = header_->tail.load(std::memory_order_acquire);
+            if (head - cached_tail_ == capacity_) {
+                return false;
+            }
+        }
+
+        std::memcpy(slot(head), &value, sizeof(T));
+
+        header_->head.store(head + 1, std::memory_order_release);
+        header_->consumer_parker.wake();
+        return true;
+    }
+
+    // Consumer only. Copies the front element to out. Returns false if empty.
+    bool pop(T& out) noexcept {
+        auto tail = header_->tail.load(std::memory_order_relaxed);
+
+        if (tail == cached_head_) {
+            cached_head_ = header_->head.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                return false;
+            }
+        }
+
+        std::memcpy(&out, slot(tail), sizeof(T));
+
+        header_->tail.store(tail + 1, std::memory_order_release);
+        header_->producer_parker.wake();
+        return true;
+    }
+
+    // Consumer only. Waits up to timeout for an element.
+    template <typename Rep, typename Period>
+    bool pop_wait(T& out, std::chrono::duration<Rep, Period> timeout) {
+        if (pop(out)) return true;
+        return Wait::wait_until([&] { return pop(out); }, deadline_after(timeout),
+                                header_->consumer_parker);
+    }
+
+    void pop_wait(T& out) {
+        if (pop(out)) return;
+        Wait::wait_until([&] { return pop(out); }, Deadline::max(), header_->consumer_parker);
+    }
+
+    // Producer only. Waits up to timeout for a free slot.
+    template <typename Rep, typename Period>
+    bool push_wait(const T& value, std::chrono::duration<Rep, Period> timeout) {
+        if (push(value)) return true;
+        return Wait::wait_until([&] { return push(value); }, deadline_after(timeout),
+                                header_->producer_parker);
+    }
+
+    void push_wait(const T& value) {
+        if (push(value)) return;
+        Wait::wait_until([&] { return push(value); }, Deadline::max(),
+                         header_->producer_parker);
+    }
+
+    // Approximate from either side (and from other processes)
+    bool empty() const noexcept { return size() == 0; }
+
+    std::size_t size() const noexcept {
+        auto tail = header_->tail.load(std::memory_order_acquire);
+        auto head = header_->head.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(head - tail);
+    }
+
+    std::size_t capacity() const noexcept { return static_cast<std::size_t>(capacity_); }
+
+    // Size of the mapped segment (header + slots)
+    std::size_t mapped_bytes() const noexcept { return mapping_.bytes(); }
+
+    // Bytes a segment for `capacity` elements needs
+    static std::size_t segment_bytes(std::size_t capacity) noexcept {
+        return Header::slots_offset() + std::bit_ceil(capacity) * sizeof(T);
+    }
+
+private:
+    static ShmSPSCQueue create_impl(const std::string& name, std::size_t capacity, bool shm) {
+        if (capacity == 0) {
+            throw std::invalid_argument("ShmSPSCQueue capacity must be > 0");
+        }
+        auto mapping = detail::ShmMapping::create(name, segment_bytes(capacity), shm);
+
+        // Fresh segment is zero-filled; construct the header, publish magic last
+        auto* header          = ::new (mapping.base()) Header();
+        header->version       = Header::kVersion;
+        header->element_size  = sizeof(T);
+        header->element_align = alignof(T);
+        header->capacity      = capacity;
+        header->slots         = std::bit_ceil(capacity);
+        header->magic.store(Header::kMagic, std::memory_order_release);
+
+        return ShmSPSCQueue(std::move(mapping));
+    }
+
+    explicit ShmSPSCQueue(detail::ShmMapping mapping)
+        : mapping_(std::move(mapping)) {
+        if (mapping_.bytes() < Header::slots_offset()) {
+            throw std::runtime_error("ShmSPSCQueue: segment too small");
+        }
+        header_ = std::launder(static_cast<Header*>(mapping_.base()));
+
+        if (header_->magic.load(std::memory_order_acquire) != Header::kMagic ||
+            header_->version != Header::kVersion) {
+            throw std::runtime_error("ShmSPSCQueue: segment not initialized");
+        }
+        if (header_->element_size != sizeof(T) || header_->element_align != alignof(T)) {
+            throw std::runtime_error("ShmSPSCQueue: element type mismatch");
+        }
+        // The header comes from another process: the ring must be exactly
+        // bit_ceil(capacity) slots and fit the mapping, or slot() would
+        // index past it
+        const std::uint64_t room = (mapping_.bytes() - Header::slots_offset()) / sizeof(T);
+        if (header_->capacity == 0 || header_->capacity > room ||
+            header_->slots != std::bit_ceil(header_->capacity)) {
+            throw std::runtime_error("ShmSPSCQueue: bad capacity in segment header");
+        }
+        if (header_->slots > room) {
+            throw std::runtime_error("ShmSPSCQueue: segment too small");
+        }
+
+        slots_       = static_cast<unsigned char*>(mapping_.base()) + Header::slots_offset();
+        capacity_    = header_->capacity;
+        mask_        = header_->slots - 1;
+        cached_head_ = header_->head.load(std::memory_order_acquire);
+        cached_tail_ = header_->tail.load(std::memory_order_acquire);
+    }
+
+    unsigned char* slot(std::uint64_t idx) const noexcept {
+        return slots_ + static_cast<std::size_t>(idx & mask_) * sizeof(T);
+    }
+
+    detail::ShmMapping mapping_;
+    Header*            header_{nullptr};
+    unsigned char*     slots_{nullptr};
+    std::uint64_t      capacity_{0};
+    std::uint64_t      mask_{0};
+
+    // Process-local caches of the other side's index
+    std::uint64_t cached_head_{0};  // consumer
+    std::uint64_t cached_tail_{0};  // producer
+};
+
+} // namespace lock_free
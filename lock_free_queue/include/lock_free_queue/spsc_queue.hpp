@@ -1,52 +1,102 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <limits>
+#include <new>
+#include <span>
 #include <type_traits>
 #include <utility>
 
+#include "lock_free_queue/ring_storage.hpp"
+#include "lock_free_queue/wait_strategy.hpp"
+
 namespace lock_free {
 
 /**
  * Single-producer / single-consumer lock-free queue implemented as a ring buffer.
  * 
  * DESIGN:
- * - Uses a fixed-size circular buffer with head (producer) and tail (consumer) indices
- * - Both indices are atomic to enable wait-free operation
- * - Capacity+1 slots distinguish between empty (head==tail) and full (head+1==tail mod size)
+ * - Fixed-size circular buffer with head (producer) and tail (consumer) indices
+ * - Indices are free-running counters: size == head - tail, full when
+ *   size == Capacity, so no slot is sacrificed to tell full from empty
+ * - Slot count is Capacity rounded up to a power of two; a slot is found
+ *   with `index & mask` instead of a modulo (division)
+ * - Each side keeps a private cached copy of the other side's index and only
+ *   re-reads the shared one when the cache says full (producer) or empty
+ *   (consumer). In steady state neither side touches the other's cache line.
  * 
  * MEMORY ORDERING:
  * - head: modified only by producer, read by both
  * - tail: modified only by consumer, read by both
- * - Cache-line aligned (64 bytes) to avoid false sharing
+ * - Cache-line aligned (64 bytes) to avoid false sharing; each index shares
+ *   its line with its owner's cached copy of the opposite index
  * 
  * MEMORY SEMANTICS:
- * - emplace: load head (relaxed), load tail (acquire), store head (release)
+ * - emplace: load head (relaxed), [refresh cached tail (acquire)], store head (release)
  *   → Producer ordered against consumer reads of head
- * - pop: load tail (relaxed), load head (acquire), store tail (release)
+ * - pop: load tail (relaxed), [refresh cached head (acquire)], store tail (release)
  *   → Consumer ordered against producer reads of tail
+ * - A stale cache is always conservative: it can only under-estimate free
+ *   space (producer) or available items (consumer)
+ * 
+ * RUNTIME CAPACITY:
+ * - SPSCQueue<T, N> keeps its slots inline (N fixed at compile time)
+ * - SPSCQueue<T, dynamic_capacity> (alias HeapSPSCQueue<T>) takes the
+ *   capacity in its constructor and allocates the slots separately,
+ *   cache-line aligned, optionally on 2 MB huge pages (ring_storage.hpp).
+ *   Same algorithm; capacity and mask are read from a read-only line.
  * 
  * LIMITATIONS:
  * - Single producer, single consumer only
- * - Fixed capacity (no dynamic resizing)
+ * - Capacity fixed at construction (no dynamic resizing)
  * - For MPMC, see mpmc_queue.hpp
  * 
+ * BATCHING:
+ * - push_bulk / pop_bulk move many elements per index store
+ * - claim_write / commit_write expose free slots for in-place construction,
+ *   claim_read / commit_read expose ready elements for in-place reads
+ * 
+ * BLOCKING:
+ * - push/pop never block. pop_wait / push_wait wait for an item / for space
+ *   using the Wait strategy (wait_strategy.hpp): BusySpinWait, SpinYieldWait
+ *   (default) or SpinParkWait
+ * - With SpinParkWait every publishing call (push, pop, bulk, commit) checks
+ *   whether the other side is asleep and wakes it, so waiters may be mixed
+ *   freely with non-blocking calls. The other strategies add no cost to
+ *   push/pop.
+ * 
  * THREAD SAFETY:
- * - Wait-free: no loops, allocations, or blocking operations
+ * - Wait-free: no loops, allocations, or blocking operations (except *_wait)
  * - No spurious wakeups or conditional variables
  * - Safe under single producer, single consumer constraint
  */
-template <typename T, std::size_t Capacity>
+template <typename T, std::size_t Capacity, typename Wait = SpinYieldWait>
 class SPSCQueue {
     static_assert(Capacity >= 1, "Capacity must be at least 1");
 
-    // We use Capacity + 1 slots to distinguish full vs empty
-    static constexpr std::size_t BufferSize = Capacity + 1;
+    static constexpr bool kDynamic = Capacity == dynamic_capacity;
+
+    // Power-of-two slot count so indices wrap with a mask
+    using Ring = std::conditional_t<kDynamic, detail::HeapRing<T>,
+                                    detail::FixedRing<T, Capacity>>;
 
-    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+    // Sleeping flags only exist for strategies that park
+    using Parker = std::conditional_t<Wait::kParks, detail::Parker, detail::NoParker>;
 
 public:
-    SPSCQueue() noexcept = default;
+    using wait_strategy = Wait;
+
+    SPSCQueue() noexcept requires(!kDynamic) = default;
+
+    // Runtime-sized queue holding up to `capacity` elements.
+    // Throws std::invalid_argument if capacity == 0, std::bad_alloc if the
+    // slots cannot be allocated.
+    explicit SPSCQueue(std::size_t capacity, PageSize pages = PageSize::Default)
+        requires(kDynamic)
+        : ring_(capacity, pages) {}
 
     SPSCQueue(const SPSCQueue&)            = delete;
     SPSCQueue& operator=(const SPSCQueue&) = delete;
@@ -80,22 +130,188 @@ public:
     // Returns false if queue is empty.
     bool pop(T& out) {
         auto tail = tail_.load(std::memory_order_relaxed);
-        auto head = head_.load(std::memory_order_acquire);
 
-        if (tail == head) {
-            // empty - no items to consume
-            return false;
+        if (tail == cached_head_) {
+            // looks empty - refresh our view of the producer
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                // empty - no items to consume
+                return false;
+            }
         }
 
         T* elem = ptr(tail);
         out = std::move(*elem);
         elem->~T();  // explicitly call destructor
 
-        auto next_tail = next_index(tail);
-        tail_.store(next_tail, std::memory_order_release);
+        tail_.store(tail + 1, std::memory_order_release);
+        producer_parker_.wake();
         return true;
     }
 
+    // ------------------------------------------------------------------
+    // Blocking API (see wait_strategy.hpp)
+    // ------------------------------------------------------------------
+
+    // Consumer only. Waits up to timeout for an element.
+    // Returns false if none arrived in time.
+    template <typename Rep, typename Period>
+    bool pop_wait(T& out, std::chrono::duration<Rep, Period> timeout) {
+        if (pop(out)) return true;
+        return Wait::wait_until([&] { return pop(out); },
+                                deadline_after(timeout), consumer_parker_);
+    }
+
+    // Consumer only. Waits until an element is available.
+    void pop_wait(T& out) {
+        if (pop(out)) return;
+        Wait::wait_until([&] { return pop(out); }, Deadline::max(), consumer_parker_);
+    }
+
+    // Producer only. Waits up to timeout for a free slot.
+    // Returns false (value untouched) if the queue stayed full.
+    template <typename Rep, typename Period>
+    bool push_wait(const T& value, std::chrono::duration<Rep, Period> timeout) {
+        if (emplace_impl(value)) return true;
+        return Wait::wait_until([&] { return emplace_impl(value); },
+                                deadline_after(timeout), producer_parker_);
+    }
+
+    template <typename Rep, typename Period>
+    bool push_wait(T&& value, std::chrono::duration<Rep, Period> timeout) {
+        if (emplace_impl(std::move(value))) return true;
+        return Wait::wait_until([&] { return emplace_impl(std::move(value)); },
+                                deadline_after(timeout), producer_parker_);
+    }
+
+    // Producer only. Waits until a slot is free.
+    void push_wait(const T& value) {
+        if (emplace_impl(value)) return;
+        Wait::wait_until([&] { return emplace_impl(value); }, Deadline::max(),
+                         producer_parker_);
+    }
+
+    void push_wait(T&& value) {
+        if (emplace_impl(std::move(value))) return;
+        Wait::wait_until([&] { return emplace_impl(std::move(value)); }, Deadline::max(),
+                         producer_parker_);
+    }
+
+    // ------------------------------------------------------------------
+    // Batch API: one index store (one cache-line handoff) per batch
+    // ------------------------------------------------------------------
+
+    // Producer only. Copies elements from [first, last) until the range ends
+    // or the queue is full; pass std::make_move_iterator(...) to move them.
+    // Returns the number enqueued; all of them are published with one store.
+    template <typename InputIt>
+    std::size_t push_bulk(InputIt first, InputIt last) {
+        auto head = head_.load(std::memory_order_relaxed);
+        std::size_t free = capacity() - (head - cached_tail_);
+        std::size_t n    = 0;
+
+        try {
+            for (; first != last; ++first) {
+                if (n == free) {
+                    // looks full - refresh once, then stop
+                    cached_tail_ = tail_.load(std::memory_order_acquire);
+                    free = capacity() - (head - cached_tail_);
+                    if (n == free) break;
+                }
+                ::new (static_cast<void*>(ptr(head + n))) T(*first);
+                ++n;
+            }
+        } catch (...) {
+            // Keep what was constructed before the throw
+            head_.store(head + n, std::memory_order_release);
+            consumer_parker_.wake();
+            throw;
+        }
+
+        if (n != 0) {
+            head_.store(head + n, std::memory_order_release);
+            consumer_parker_.wake();
+        }
+        return n;
+    }
+
+    // Consumer only. Moves up to max elements to out, releasing all of
+    // their slots with one store. Returns the number dequeued.
+    template <typename OutputIt>
+    std::size_t pop_bulk(OutputIt out, std::size_t max) {
+        auto tail = tail_.load(std::memory_order_relaxed);
+
+        std::size_t available = cached_head_ - tail;
+        if (available < max) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            available    = cached_head_ - tail;
+        }
+
+        const std::size_t n = available < max ? available : max;
+        for (std::size_t i = 0; i < n; ++i) {
+            T* elem = ptr(tail + i);
+            *out = std::move(*elem);
+            ++out;
+            elem->~T();
+        }
+
+        if (n != 0) {
+            tail_.store(tail + n, std::memory_order_release);
+            producer_parker_.wake();
+        }
+        return n;
+    }
+
+    // ------------------------------------------------------------------
+    // Zero-copy claim/commit API
+    // ------------------------------------------------------------------
+
+    // Producer only. Returns up to max free slots, contiguous in memory
+    // (so possibly fewer than are free when the ring wraps; claim again
+    // after committing). The slots hold no objects yet: construct each one
+    // you use with std::construct_at (implicit-lifetime types may simply be
+    // written), then publish the first n with commit_write(n).
+    std::span<T> claim_write(std::size_t max = kAll) noexcept {
+        auto head = head_.load(std::memory_order_relaxed);
+
+        std::size_t free = capacity() - (head - cached_tail_);
+        if (free < max) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            free         = capacity() - (head - cached_tail_);
+        }
+        return {ptr(head), std::min({max, free, contiguous_from(head)})};
+    }
+
+    // Producer only. Publishes the first n slots of the last claim_write().
+    void commit_write(std::size_t n) noexcept {
+        head_.store(head_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        consumer_parker_.wake();
+    }
+
+    // Consumer only. Returns up to max ready elements, contiguous in memory,
+    // to be read in place. They stay in the queue until commit_read().
+    std::span<T> claim_read(std::size_t max = kAll) noexcept {
+        auto tail = tail_.load(std::memory_order_relaxed);
+
+        std::size_t available = cached_head_ - tail;
+        if (available < max) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            available    = cached_head_ - tail;
+        }
+        return {ptr(tail), std::min({max, available, contiguous_from(tail)})};
+    }
+
+    // Consumer only. Destroys the first n elements of the last claim_read()
+    // and hands their slots back to the producer.
+    void commit_read(std::size_t n) noexcept {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < n; ++i) {
+            ptr(tail + i)->~T();
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        producer_parker_.wake();
+    }
+
     // Returns true if queue is empty (approximate in concurrent context).
     // Safe to call from either producer or consumer, but not precise under contention.
     bool empty() const noexcept {
@@ -107,82 +323,104 @@ public:
     // Returns true if queue is full (approximate).
     // Safe to call from either producer or consumer, but not precise under contention.
     bool full() const noexcept {
-        auto head      = head_.load(std::memory_order_relaxed);
-        auto next_head = next_index(head);
-        auto tail      = tail_.load(std::memory_order_acquire);
-        return next_head == tail;
+        auto head = head_.load(std::memory_order_relaxed);
+        auto tail = tail_.load(std::memory_order_acquire);
+        return head - tail == capacity();
     }
 
     // Approximate size (not strictly accurate under concurrency, but fine for monitoring).
-    // Handles wrap-around arithmetic correctly.
+    // Free-running indices: unsigned subtraction handles wrap-around.
     std::size_t size() const noexcept {
-        auto head = head_.load(std::memory_order_acquire);
         auto tail = tail_.load(std::memory_order_acquire);
-        if (head >= tail) {
-            return head - tail;
-        }
-        return BufferSize - (tail - head);
+        auto head = head_.load(std::memory_order_acquire);
+        return head - tail;
     }
 
+    static constexpr std::size_t capacity() noexcept requires(!kDynamic) { return Capacity; }
+    std::size_t capacity() const noexcept requires(kDynamic) { return ring_.capacity(); }
+
+    // True if a runtime-sized queue got explicit 2 MB pages (PageSize::Huge2M)
+    bool huge_pages() const noexcept requires(kDynamic) { return ring_.huge_pages(); }
+
     // Drain queue, destroying remaining elements.
     // Should only be called when guaranteed no producer/consumer access.
     void clear() noexcept {
-        T tmp;
-        while (pop(tmp)) {
-            // drain
+        auto tail = tail_.load(std::memory_order_relaxed);
+        auto head = head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            ptr(tail)->~T();
         }
+        tail_.store(tail, std::memory_order_release);
+        cached_head_ = head;
     }
 
 private:
     // Internal emplace implementation (used by push and emplace)
-    // Atomically reserves head slot and constructs T in-place.
+    // Reserves the head slot and constructs T in-place.
     // Uses acquire-release semantics:
-    //   - Load tail with acquire to ensure memory ordering
+    //   - Refresh the cached tail with acquire only when the queue looks full
     //   - Store head with release to publish the new element
     template <typename... Args>
     bool emplace_impl(Args&&... args) {
-        auto head      = head_.load(std::memory_order_relaxed);
-        auto tail      = tail_.load(std::memory_order_acquire);
-        auto next_head = next_index(head);
+        auto head = head_.load(std::memory_order_relaxed);
 
-        if (next_head == tail) {
-            // full - can't enqueue
-            return false;
+        if (head - cached_tail_ == capacity()) {
+            // looks full - refresh our view of the consumer
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ == capacity()) {
+                // full - can't enqueue
+                return false;
+            }
         }
 
         T* elem = ptr(head);
         ::new (static_cast<void*>(elem)) T(std::forward<Args>(args)...);  // placement new
 
-        head_.store(next_head, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
+        consumer_parker_.wake();
         return true;
     }
 
-    // Circular buffer index increment (with wrap-around)
-    static std::size_t next_index(std::size_t i) noexcept {
-        return (i + 1) % BufferSize;
+    // Default claim size: as many slots as are available
+    static constexpr std::size_t kAll = std::numeric_limits<std::size_t>::max();
+
+    // Slots from index up to the physical end of the ring
+    std::size_t contiguous_from(std::size_t idx) const noexcept {
+        return ring_.slots() - (idx & ring_.mask());
     }
 
     // Unsafe cast from storage buffer to typed pointer (use with placement new/delete)
     T* ptr(std::size_t idx) noexcept {
-        return std::launder(reinterpret_cast<T*>(&buffer_[idx]));
+        return std::launder(reinterpret_cast<T*>(ring_.data() + (idx & ring_.mask())));
     }
 
     // Const version for safe reads
     const T* ptr(std::size_t idx) const noexcept {
-        return std::launder(reinterpret_cast<const T*>(&buffer_[idx]));
+        return std::launder(reinterpret_cast<const T*>(ring_.data() + (idx & ring_.mask())));
     }
 
-    // Producer head index (cache-line aligned to avoid false sharing with tail)
-    // Only modified by producer, read by consumer
+    // Producer line: head index + producer's cached copy of tail
+    // head_ only modified by producer, read by consumer
     alignas(64) std::atomic<std::size_t> head_{0};
-    
-    // Consumer tail index (cache-line aligned)
-    // Only modified by consumer, read by producer
+    std::size_t                          cached_tail_{0};
+
+    // Consumer line: tail index + consumer's cached copy of head
+    // tail_ only modified by consumer, read by producer
     alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t                          cached_head_{0};
 
-    // Ring buffer storage (cache-line aligned)
-    alignas(64) Storage buffer_[BufferSize];
+    // Sleeping flags (own cache lines; empty unless Wait parks)
+    [[no_unique_address]] Parker consumer_parker_;  // consumer waits for items
+    [[no_unique_address]] Parker producer_parker_;  // producer waits for space
+
+    // Ring buffer storage (cache-line aligned): the slots themselves, or the
+    // pointer/capacity/mask of a heap ring (read-only after construction)
+    alignas(64) Ring ring_;
 };
 
+// Runtime-sized SPSC queue with heap (optionally huge-page) storage
+template <typename T, typename Wait = SpinYieldWait>
+using HeapSPSCQueue = SPSCQueue<T, dynamic_capacity, Wait>;
+
 } // namespace lock_free
 
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "lock_free_queue/spsc_queue.hpp"
+
+namespace lock_free {
+
+/**
+ * Unbounded single-producer / single-consumer queue: a linked list of
+ * fixed-size segments.
+ *
+ * DESIGN:
+ * - The producer fills the tail segment slot by slot and publishes each
+ *   element by bumping the segment's `committed` count. When the segment is
+ *   full it takes a fresh one and links it as `next`.
+ * - The consumer drains the head segment up to `committed`. Once it has
+ *   consumed all SegmentSize slots and `next` is set, it moves on and hands
+ *   the drained segment back to the producer.
+ * - Drained segments travel back through a bounded HeapSPSCQueue<Segment*>
+ *   (consumer pushes, producer pops). The producer allocates only when that
+ *   cache is empty, so a queue whose depth stays within the cached segments
+ *   allocates nothing in steady state. Segments that do not fit in the cache
+ *   are freed by the consumer.
+ * - Like SPSCQueue, the consumer keeps a private copy of `committed` and only
+ *   re-reads the producer's line when the copy says empty.
+ *
+ * MEMORY ORDERING:
+ * - committed: release store by the producer after constructing an element,
+ *   acquire load by the consumer before reading it
+ * - next: release store after the new segment was reset, acquire load by
+ *   the consumer before touching the new segment
+ * - The recycle cache is an SPSCQueue, which orders the consumer's
+ *   destruction of the old elements before the producer's reuse
+ *
+ * LIMITATIONS:
+ * - Single producer, single consumer only
+ * - push never fails; it allocates a segment (and may throw std::bad_alloc)
+ *   when the recycle cache is empty
+ * - Memory is returned only down to the cache size: a burst's extra
+ *   segments are freed as the consumer drains them
+ *
+ * THREAD SAFETY:
+ * - push/emplace: producer only. pop/empty: consumer only.
+ * - Wait-free except for the allocation of a new segment
+ */
+template <typename T, std::size_t SegmentSize = 1024>
+class UnboundedSPSCQueue {
+    static_assert(SegmentSize >= 1, "SegmentSize must be at least 1");
+
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    struct Segment {
+        alignas(64) std::atomic<std::size_t> committed{0};  // slots published
+        std::atomic<Segment*>                next{nullptr};
+        alignas(64) Storage                  slots[SegmentSize];
+
+        T* ptr(std::size_t i) noexcept {
+            return std::launder(reinterpret_cast<T*>(&slots[i]));
+        }
+    };
+
+public:
+    static constexpr std::size_t kDefaultCachedSegments = 16;
+
+    // max_cached_segments (>= 1): drained segments kept for reuse
+    explicit UnboundedSPSCQueue(std::size_t max_cached_segments = kDefaultCachedSegments)
+        : free_(max_cached_segments) {
+        Segment* first = new Segment();
+        tail_seg_ = first;
+        head_seg_ = first;
+        allocated_ = 1;
+    }
+
+    UnboundedSPSCQueue(const UnboundedSPSCQueue&)            = delete;
+    UnboundedSPSCQueue& operator=(const UnboundedSPSCQueue&) = delete;
+
+    ~UnboundedSPSCQueue() {
+        // Destroy unconsumed elements and the segment chain
+        Segment*    seg = head_seg_;
+        std::size_t pos = read_pos_;
+        while (seg) {
+            const std::size_t end = seg->committed.load(std::memory_order_acquire);
+            for (; pos < end; ++pos) {
+                seg->ptr(pos)->~T();
+            }
+            Segment* next = seg->next.load(std::memory_order_acquire);
+            delete seg;
+            seg = next;
+            pos = 0;
+        }
+
+        Segment* cached = nullptr;
+        while (free_.pop(cached)) {
+            delete cached;
+        }
+    }
+
+    // Producer only. Always succeeds (allocates if the recycle cache is empty).
+    void push(const T& value) {
+        emplace(value);
+    }
+
+    void push(T&& value) {
+        emplace(std::move(value));
+    }
+
+    // Producer only. Constructs T directly in queue storage.
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        if (write_pos_ == SegmentSize) {
+            advance_tail();
+        }
+
+        ::new (static_cast<void*>(tail_seg_->ptr(write_pos_))) T(std::forward<Args>(args)...);
+
+        ++write_pos_;
+        tail_seg_->committed.store(write_pos_, std::memory_order_release);
+    }
+
+    // Consumer only. Moves the front element into out. Returns false if empty.
+    bool pop(T& out) {
+        if (read_pos_ == cached_committed_ && !refresh()) {
+            return false;
+        }
+
+        T* elem = head_seg_->ptr(read_pos_);
+        out = std::move(*elem);
+        elem->~T();
+        ++read_pos_;
+        return true;
+    }
+
+    // Consumer only.
+    bool empty() {
+        return read_pos_ == cached_committed_ && !refresh();
+    }
+
+    // Producer only. Segments allocated so far (including the first one);
+    // stays flat once the recycle cache covers the queue's working depth.
+    std::size_t allocated_segments() const noexcept { return allocated_; }
+
+    static constexpr std::size_t segment_size() noexcept { return SegmentSize; }
+
+private:
+    // Producer: current segment is full, continue in a recycled or new one
+    void advance_tail() {
+        Segment* seg = nullptr;
+        if (free_.pop(seg)) {
+            // Exclusively ours again: reset before publishing via next
+            seg->committed.store(0, std::memory_order_relaxed);
+            seg->next.store(nullptr, std::memory_order_relaxed);
+        } else {
+            seg = new Segment();
+            ++allocated_;
+        }
+
+        tail_seg_->next.store(seg, std::memory_order_release);
+        tail_seg_  = seg;
+        write_pos_ = 0;
+    }
+
+    // Consumer: look for more elements, crossing into the next segment once
+    // the current one is fully drained. Returns true if one is available.
+    bool refresh() {
+        cached_committed_ = head_seg_->committed.load(std::memory_order_acquire);
+        if (read_pos_ != cached_committed_) return true;
+        if (read_pos_ != SegmentSize) return false;  // producer still filling it
+
+        Segment* next = head_seg_->next.load(std::memory_order_acquire);
+        if (!next) return false;
+
+        Segment* drained = head_seg_;
+        head_seg_        = next;
+        read_pos_        = 0;
+        if (!free_.push(drained)) {
+            delete drained;  // cache full: give the memory back
+        }
+
+        cached_committed_ = head_seg_->committed.load(std::memory_order_acquire);
+        return read_pos_ != cached_committed_;
+    }
+
+    // Producer line
+    alignas(64) Segment* tail_seg_{nullptr};
+    std::size_t          write_pos_{0};
+    std::size_t          allocated_{0};
+
+    // Consumer line
+    alignas(64) Segment* head_seg_{nullptr};
+    std::size_t          read_pos_{0};
+    std::size_t          cached_committed_{0};
+
+    // Drained segments, consumer -> producer
+    HeapSPSCQueue<Segment*> free_;
+};
+
+} // namespace lock_free
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace lock_free {
+
+/**
+ * Wait strategies for the blocking SPSCQueue calls (pop_wait / push_wait).
+ *
+ * A strategy decides what a thread does while the queue is empty (consumer)
+ * or full (producer):
+ *
+ * | Strategy       | Idle cost         | Wake-up latency        | Cost on push/pop      |
+ * | -------------- | ----------------- | ---------------------- | --------------------- |
+ * | BusySpinWait   | one core at 100%  | ~ one cache miss       | none                  |
+ * | SpinYieldWait  | one core, yielded | scheduler quantum      | none                  |
+ * | SpinParkWait   | none (asleep)     | futex wake, a few us   | fence + flag check    |
+ *
+ * Strategy interface:
+ *   static constexpr bool kParks;   // needs the sleeping-flag handshake
+ *   template <typename Ready, typename Parker>
+ *   static bool wait_until(Ready&& ready, Deadline deadline, Parker& parker);
+ *
+ * ready() retries the operation and returns true once it succeeded;
+ * wait_until returns false if the deadline passed first.
+ */
+
+using WaitClock = std::chrono::steady_clock;
+using Deadline  = WaitClock::time_point;
+
+// now + timeout, saturating instead of overflowing for "forever" timeouts
+template <typename Rep, typename Period>
+Deadline deadline_after(std::chrono::duration<Rep, Period> timeout) noexcept {
+    using Seconds = std::chrono::duration<double>;
+
+    const auto now = WaitClock::now();
+    if (Seconds(timeout) >= Seconds(Deadline::max() - now)) {
+        return Deadline::max();
+    }
+    return now + std::chrono::ceil<WaitClock::duration>(timeout);
+}
+
+// Hint to the CPU that we are spinning (frees pipeline resources for the
+// sibling hyper-thread, avoids the memory-order mis-speculation on exit)
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+namespace detail {
+
+// Sleep while word == expected, until woken or the deadline passes.
+// Spurious returns are allowed; callers re-check their condition.
+//
+// On Linux this is the futex syscall directly: std::atomic::wait has no
+// timeout. Elsewhere, untimed waits use std::atomic::wait and timed waits
+// degrade to short sleeps.
+inline void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected,
+                       Deadline deadline, bool process_shared = false) noexcept {
+#if defined(__linux__)
+    const int op = process_shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE;
+    if (deadline == Deadline::max()) {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, expected,
+                nullptr, nullptr, 0);
+        return;
+    }
+
+    const auto remaining = deadline - WaitClock::now();
+    if (remaining <= WaitClock::duration::zero()) return;
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+    timespec rel{};
+    rel.tv_sec  = static_cast<time_t>(ns / 1'000'000'000);
+    rel.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, expected,
+            &rel, nullptr, 0);
+#else
+    (void)process_shared;
+    if (deadline == Deadline::max()) {
+        word.wait(expected, std::memory_order_relaxed);
+        return;
+    }
+    if (word.load(std::memory_order_relaxed) == expected && WaitClock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+#endif
+}
+
+inline void futex_wake_one(std::atomic<std::uint32_t>& word,
+                           bool process_shared = false) noexcept {
+#if defined(__linux__)
+    const int op = process_shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE;
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, 1, nullptr, nullptr, 0);
+#else
+    (void)process_shared;
+    word.notify_one();
+#endif
+}
+
+/**
+ * One side's sleeping flag (consumer waiting for items, or producer
+ * waiting for space). Shared = true uses process-shared futex operations,
+ * for flags that live in memory mapped by several processes.
+ *
+ * HANDSHAKE (Dekker-style, both sides use a seq_cst fence):
+ *   waiter: sleeping = 1; fence; re-check queue; futex_wait(sleeping, 1)
+ *   waker:  publish index; fence; if (sleeping) { sleeping = 0; wake }
+ * Either the waiter's re-check sees the new index, or the waker sees the
+ * flag; a wake-up cannot be lost.
+ */
+template <bool Shared>
+struct BasicParker {
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+    alignas(64) std::atomic<std::uint32_t> sleeping{0};
+
+    void prepare_park() noexcept {
+        sleeping.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void cancel_park() noexcept {
+        sleeping.store(0, std::memory_order_relaxed);
+    }
+
+    void park(Deadline deadline) noexcept {
+        futex_wait(sleeping, 1, deadline, Shared);
+    }
+
+    // Called by the other side after publishing
+    void wake() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed) != 0 &&
+            sleeping.exchange(0, std::memory_order_relaxed) != 0) {
+            futex_wake_one(sleeping, Shared);
+        }
+    }
+};
+
+using Parker       = BasicParker<false>;
+using SharedParker = BasicParker<true>;
+
+// Stand-in for strategies that never sleep: no state, no cost
+struct NoParker {
+    void wake() noexcept {}
+};
+
+} // namespace detail
+
+// Spin with a pause instruction. Lowest latency, burns a core while idle.
+struct BusySpinWait {
+    static constexpr bool kParks = false;
+
+    template <typename Ready, typename Parker>
+    static bool wait_until(Ready&& ready, Deadline deadline, Parker&) {
+        while (true) {
+            // Reading the clock costs more than a pause: check it every 64 spins
+            for (int i = 0; i < 64; ++i) {
+                if (ready()) return true;
+                cpu_relax();
+            }
+            if (WaitClock::now() >= deadline) return ready();
+        }
+    }
+};
+
+// Spin briefly, then yield the core between retries. Lets other threads
+// run but still wakes the CPU every scheduler tick.
+struct SpinYieldWait {
+    static constexpr bool kParks  = false;
+    static constexpr int  kSpins  = 256;
+
+    template <typename Ready, typename Parker>
+    static bool wait_until(Ready&& ready, Deadline deadline, Parker&) {
+        for (int i = 0; i < kSpins; ++i) {
+            if (ready()) return true;
+            cpu_relax();
+        }
+        while (true) {
+            if (ready()) return true;
+            if (WaitClock::now() >= deadline) return false;
+            std::this_thread::yield();
+        }
+    }
+};
+
+// Spin, then yield a few times, then sleep on a futex until the other side
+// publishes. Idle waiters cost nothing; the other side pays a fence and a
+// flag check per operation (plus a syscall only when someone sleeps).
+struct SpinParkWait {
+    static constexpr bool kParks  = true;
+    static constexpr int  kSpins  = 256;
+    static constexpr int  kYields = 8;
+
+    template <typename Ready, bool Shared>
+    static bool wait_until(Ready&& ready, Deadline deadline,
+                           detail::BasicParker<Shared>& parker) {
+        for (int i = 0; i < kSpins; ++i) {
+            if (ready()) return true;
+            cpu_relax();
+        }
+        for (int i = 0; i < kYields; ++i) {
+            if (ready()) return true;
+            std::this_thread::yield();
+        }
+
+        while (true) {
+            parker.prepare_park();
+            if (ready()) {
+                parker.cancel_park();
+                return true;
+            }
+            if (WaitClock::now() >= deadline) {
+                parker.cancel_park();
+                return false;
+            }
+            parker.park(deadline);
+        }
+    }
+};
+
+} // namespace lock_free
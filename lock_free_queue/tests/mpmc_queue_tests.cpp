@@ -0,0 +1,135 @@
+#include "lock_free_queue/mpmc_queue.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using lock_free::MPMCQueue;
+
+static void test_single_thread_basic() {
+    MPMCQueue<int, 4> q;
+
+    assert(q.empty());
+
+    assert(q.push(1));
+    assert(q.push(2));
+    assert(q.emplace(3));
+    assert(q.size() == 3);
+
+    int x = 0;
+    assert(q.pop(x) && x == 1);
+    assert(q.pop(x) && x == 2);
+    assert(q.pop(x) && x == 3);
+
+    assert(!q.pop(x)); // now empty
+    assert(q.empty());
+}
+
+static void test_single_thread_full_and_wraparound() {
+    MPMCQueue<int, 2> q;
+
+    for (int lap = 0; lap < 5; ++lap) {
+        assert(q.push(lap * 10));
+        assert(q.push(lap * 10 + 1));
+        assert(!q.push(99)); // full
+
+        int x = 0;
+        assert(q.pop(x) && x == lap * 10);
+        assert(q.pop(x) && x == lap * 10 + 1);
+        assert(q.empty());
+    }
+}
+
+static void test_move_only_and_clear() {
+    struct Tracked {
+        std::atomic<int>* live;
+        explicit Tracked(std::atomic<int>* l) : live(l) { live->fetch_add(1); }
+        ~Tracked() { live->fetch_sub(1); }
+    };
+
+    std::atomic<int> live{0};
+    {
+        MPMCQueue<std::unique_ptr<Tracked>, 8> q;
+        for (int i = 0; i < 5; ++i) {
+            assert(q.push(std::make_unique<Tracked>(&live)));
+        }
+
+        std::unique_ptr<Tracked> out;
+        assert(q.pop(out));
+        assert(out);
+        assert(live.load() == 5);
+        out.reset();
+        assert(live.load() == 4);
+        // Remaining elements are destroyed by the queue
+    }
+    assert(live.load() == 0);
+}
+
+static void test_multi_producer_multi_consumer() {
+    constexpr int producers    = 4;
+    constexpr int consumers    = 4;
+    constexpr int per_producer = 20000;
+
+    MPMCQueue<long, 64> q;
+    std::atomic<int>  consumed{0};
+    std::atomic<long> sum{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                // Encode (producer, sequence) so consumers can check ordering
+                const long item = static_cast<long>(p) << 32 | i;
+                while (!q.push(item)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::vector<long> last_seen(producers, -1);
+            long item = 0;
+            while (consumed.load(std::memory_order_relaxed) < producers * per_producer) {
+                if (!q.pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const int  p   = static_cast<int>(item >> 32);
+                const long seq = item & 0xffffffff;
+
+                // One producer's items reach any single consumer in FIFO order
+                assert(seq > last_seen[p]);
+                last_seen[p] = seq;
+
+                sum.fetch_add(seq, std::memory_order_relaxed);
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    const long per_producer_sum = static_cast<long>(per_producer) * (per_producer - 1) / 2;
+    assert(consumed.load() == producers * per_producer);
+    assert(sum.load() == producers * per_producer_sum);
+    assert(q.empty());
+}
+
+int main() {
+    std::cout << "Running mpmc_queue tests...\n";
+
+    test_single_thread_basic();
+    test_single_thread_full_and_wraparound();
+    test_move_only_and_clear();
+    test_multi_producer_multi_consumer();
+
+    std::cout << "All mpmc_queue tests passed.\n";
+    return 0;
+}
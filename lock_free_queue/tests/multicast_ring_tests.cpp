@@ -0,0 +1,173 @@
+#include "lock_free_queue/multicast_ring.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using lock_free::MulticastRing;
+
+static void test_every_consumer_sees_every_element() {
+    MulticastRing<int, 8> ring;
+    auto& a = ring.add_consumer();
+    auto& b = ring.add_consumer();
+
+    for (int i = 0; i < 5; ++i) {
+        assert(ring.push(i));
+    }
+
+    std::vector<int> seen_a;
+    std::vector<int> seen_b;
+    assert(a.poll([&](const int& v, std::size_t seq) {
+        assert(static_cast<std::size_t>(v) == seq);
+        seen_a.push_back(v);
+    }) == 5);
+    assert(b.poll([&](const int& v, std::size_t) { seen_b.push_back(v); }, 3) == 3);
+
+    assert(seen_a == std::vector<int>({0, 1, 2, 3, 4}));
+    assert(seen_b == std::vector<int>({0, 1, 2}));
+    assert(a.sequence() == 5 && b.sequence() == 3);
+}
+
+static void test_producer_gated_by_slowest_consumer() {
+    MulticastRing<int, 4> ring;
+    auto& fast = ring.add_consumer();
+    auto& slow = ring.add_consumer();
+
+    for (int i = 0; i < 4; ++i) {
+        assert(ring.push(i));
+    }
+    assert(!ring.push(4));  // full for the slow consumer
+
+    fast.poll([](const int&, std::size_t) {});
+    assert(!ring.push(4));  // fast consumer alone frees nothing
+
+    std::span<const int> r = slow.claim_read(2);
+    assert(r.size() == 2 && r[0] == 0 && r[1] == 1);
+    slow.commit_read(2);
+
+    assert(ring.push(4));
+    assert(ring.push(5));
+    assert(!ring.push(6));
+}
+
+static void test_claim_write_wraps_in_place() {
+    MulticastRing<int, 8> ring;
+    auto& c = ring.add_consumer();
+
+    std::span<int> w = ring.claim_write(6);
+    assert(w.size() == 6);
+    for (std::size_t i = 0; i < w.size(); ++i) {
+        w[i] = static_cast<int>(i);
+    }
+    ring.commit_write(6);
+    c.poll([](const int&, std::size_t) {});
+
+    w = ring.claim_write();
+    assert(w.size() == 2);  // up to the end of the ring
+    w[0] = 6;
+    w[1] = 7;
+    ring.commit_write(2);
+
+    w = ring.claim_write(3);
+    assert(w.size() == 3);  // wrapped to the start
+    w[0] = 8;
+    ring.commit_write(1);
+
+    std::vector<int> seen;
+    assert(c.poll([&](const int& v, std::size_t) { seen.push_back(v); }) == 3);
+    assert(seen == std::vector<int>({6, 7, 8}));
+}
+
+static void test_dependencies_order_consumers() {
+    MulticastRing<int, 8> ring;
+    auto& journal   = ring.add_consumer();
+    auto& replicate = ring.add_consumer();
+    auto& apply     = ring.add_consumer({&journal, &replicate});
+
+    for (int i = 0; i < 4; ++i) {
+        assert(ring.push(i));
+    }
+
+    // Nothing for apply until both upstream stages are done
+    assert(apply.claim_read().empty());
+    journal.poll([](const int&, std::size_t) {});
+    assert(apply.claim_read().empty());
+    replicate.poll([](const int&, std::size_t) {}, 2);
+    assert(apply.claim_read().size() == 2);
+    replicate.poll([](const int&, std::size_t) {});
+    assert(apply.poll([](const int&, std::size_t) {}) == 4);
+
+    bool threw = false;
+    try {
+        ring.add_consumer();
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw && "adding a consumer after publishing must throw");
+}
+
+static void test_threaded_pipeline() {
+    // producer -> {a, b} -> c, c checks that a and b finished each element
+    constexpr std::uint64_t N = 100000;
+    auto ring = std::make_unique<MulticastRing<std::uint64_t, 256>>();
+    auto& a = ring->add_consumer();
+    auto& b = ring->add_consumer();
+    auto& c = ring->add_consumer({&a, &b});
+
+    std::uint64_t sum_a = 0;
+    std::uint64_t sum_b = 0;
+    std::uint64_t sum_c = 0;
+
+    auto run = [](auto& consumer, std::uint64_t& sum, auto&& check) {
+        std::uint64_t seen = 0;
+        while (seen < N) {
+            const std::size_t n = consumer.poll([&](const std::uint64_t& v, std::size_t seq) {
+                assert(v == seq);
+                check(seq);
+                sum += v;
+            });
+            if (n == 0) std::this_thread::yield();
+            seen += n;
+        }
+    };
+
+    std::thread ta([&] { run(a, sum_a, [](std::size_t) {}); });
+    std::thread tb([&] { run(b, sum_b, [](std::size_t) {}); });
+    std::thread tc([&] {
+        run(c, sum_c, [&](std::size_t seq) {
+            assert(a.sequence() > seq && b.sequence() > seq);
+        });
+    });
+
+    for (std::uint64_t i = 0; i < N; ++i) {
+        while (!ring->push(i)) {
+            std::this_thread::yield();
+        }
+    }
+
+    ta.join();
+    tb.join();
+    tc.join();
+
+    const std::uint64_t expected = N * (N - 1) / 2;
+    assert(sum_a == expected && sum_b == expected && sum_c == expected);
+}
+
+int main() {
+    std::cout << "Running multicast_ring tests...\n";
+
+    test_every_consumer_sees_every_element();
+    test_producer_gated_by_slowest_consumer();
+    test_claim_write_wraps_in_place();
+    test_dependencies_order_consumers();
+    test_threaded_pipeline();
+
+    std::cout << "All multicast_ring tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include "lock_free_queue/shm_spsc_queue.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using lock_free::ShmSPSCQueue;
+
+namespace {
+
+struct Message {
+    std::uint64_t seq;
+    double        value;
+    char          tag[16];
+};
+
+std::string unique_name(const char* what) {
+    return "/lfq_test_" + std::to_string(::getpid()) + "_" + what;
+}
+
+} // namespace
+
+static void test_create_attach_round_trip() {
+    const std::string name = unique_name("basic");
+    auto producer = ShmSPSCQueue<Message>::create(name, 3);  // 4 slots, holds 3
+    auto consumer = ShmSPSCQueue<Message>::attach(name);
+    assert(ShmSPSCQueue<Message>::unlink(name));  // mappings stay valid
+
+    assert(consumer.capacity() == 3);
+    assert(consumer.empty());
+
+    for (std::uint64_t lap = 0; lap < 5; ++lap) {
+        for (std::uint64_t i = 0; i < 3; ++i) {
+            Message m{lap * 3 + i, 0.5 * static_cast<double>(i), "tick"};
+            assert(producer.push(m));
+        }
+        assert(!producer.push(Message{}));  // full
+        assert(consumer.size() == 3);
+
+        Message out{};
+        for (std::uint64_t i = 0; i < 3; ++i) {
+            assert(consumer.pop(out));
+            assert(out.seq == lap * 3 + i);
+            assert(std::string(out.tag) == "tick");
+        }
+        assert(!consumer.pop(out));
+    }
+}
+
+static void test_attach_errors() {
+    const std::string name = unique_name("errors");
+
+    bool threw = false;
+    try {
+        ShmSPSCQueue<int>::attach(name);
+    } catch (const std::system_error&) {
+        threw = true;
+    }
+    assert(threw && "attach to a missing segment must throw std::system_error");
+
+    auto q = ShmSPSCQueue<std::uint32_t>::create(name, 8);
+
+    threw = false;
+    try {
+        ShmSPSCQueue<std::uint32_t>::create(name, 8);
+    } catch (const std::system_error& e) {
+        threw = e.code() == std::errc::file_exists;
+    }
+    assert(threw && "create on an existing name must fail with EEXIST");
+
+    threw = false;
+    try {
+        ShmSPSCQueue<Message>::attach(name);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && "attach with a different element type must throw");
+
+    assert(ShmSPSCQueue<std::uint32_t>::unlink(name));
+    assert(!ShmSPSCQueue<std::uint32_t>::unlink(name));
+}
+
+static void test_file_backed() {
+    const std::string path = "/tmp/lfq_test_" + std::to_string(::getpid()) + ".ring";
+    {
+        auto producer = ShmSPSCQueue<int>::create_file(path, 16);
+        auto consumer = ShmSPSCQueue<int>::attach_file(path);
+        assert(producer.push(7));
+        int x = 0;
+        assert(consumer.pop(x) && x == 7);
+
+        // Moving hands over the mapping and leaves nothing behind
+        auto moved = std::move(consumer);
+        assert(producer.push(8));
+        assert(moved.pop(x) && x == 8);
+        consumer = std::move(moved);
+        assert(moved.mapped_bytes() == 0);
+        assert(consumer.capacity() == 16 && consumer.empty());
+    }
+    assert(ShmSPSCQueue<int>::unlink_file(path));
+    assert(!ShmSPSCQueue<int>::unlink_file(path));
+}
+
+static void test_corrupt_header() {
+    const std::string path = "/tmp/lfq_test_" + std::to_string(::getpid()) + ".corrupt";
+    auto              q    = ShmSPSCQueue<int>::create_file(path, 16);  // 16 slots
+
+    auto  mapping = lock_free::detail::ShmMapping::open(path, false);
+    auto* header  = static_cast<lock_free::detail::ShmQueueHeader*>(mapping.base());
+    for (std::uint64_t slots : {std::uint64_t{1} << 20, std::uint64_t{24}, std::uint64_t{8}}) {
+        header->slots = slots;  // past the mapping, not a power of two, too few
+        bool threw = false;
+        try {
+            ShmSPSCQueue<int>::attach_file(path);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw && "attach must reject a slot count that does not match the capacity");
+    }
+    header->slots    = 16;
+    header->capacity = std::uint64_t{1} << 40;  // larger than the segment
+    bool threw       = false;
+    try {
+        ShmSPSCQueue<int>::attach_file(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && "attach must reject a capacity larger than the segment");
+
+    std::remove(path.c_str());
+}
+
+static void test_cross_process_wait() {
+    constexpr std::uint64_t N = 20000;
+    const std::string name = unique_name("fork");
+
+    auto q = ShmSPSCQueue<Message>::create(name, 64);
+
+    std::cout.flush();  // do not duplicate buffered output in the child
+    const pid_t child = ::fork();
+    assert(child >= 0);
+    if (child == 0) {
+        // Producer process: attach by name, stream, pause once so the
+        // consumer parks on the shared futex
+        auto producer = ShmSPSCQueue<Message>::attach(name);
+        for (std::uint64_t i = 0; i < N; ++i) {
+            if (i == N / 2) {
+                ::usleep(20000);
+            }
+            producer.push_wait(Message{i, 0.0, "ipc"});
+        }
+        ::_exit(0);
+    }
+
+    for (std::uint64_t i = 0; i < N; ++i) {
+        Message m{};
+        assert(q.pop_wait(m, std::chrono::seconds(30)));
+        assert(m.seq == i);
+    }
+
+    int status = 0;
+    assert(::waitpid(child, &status, 0) == child);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(q.empty());
+    ShmSPSCQueue<Message>::unlink(name);
+}
+
+int main() {
+    std::cout << "Running shm_spsc_queue tests...\n";
+
+    test_create_attach_round_trip();
+    test_attach_errors();
+    test_file_backed();
+    test_corrupt_header();
+    test_cross_process_wait();
+
+    std::cout << "All shm_spsc_queue tests passed.\n";
+    return 0;
+}
@@ -1,10 +1,18 @@
 #include "lock_free_queue/spsc_queue.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
+using lock_free::HeapSPSCQueue;
 using lock_free::SPSCQueue;
 
 static void test_single_thread_basic() {
@@ -45,6 +53,278 @@ static void test_single_thread_full() {
     assert(q.empty());
 }
 
+static void test_non_power_of_two_capacity_wraparound() {
+    SPSCQueue<int, 3> q; // 4 slots internally, still holds exactly 3
+
+    int next_push = 0;
+    int next_pop  = 0;
+    for (int lap = 0; lap < 10; ++lap) {
+        while (q.push(next_push)) {
+            ++next_push;
+        }
+        assert(q.full());
+        assert(q.size() == 3);
+
+        int x = 0;
+        assert(q.pop(x) && x == next_pop++);
+        assert(q.pop(x) && x == next_pop++);
+        assert(q.size() == 1);
+    }
+}
+
+static void test_clear_destroys_remaining() {
+    struct Tracked {
+        int* live;
+        explicit Tracked(int* l) : live(l) { ++*live; }
+        Tracked(Tracked&& other) noexcept : live(other.live) { ++*live; }
+        Tracked& operator=(Tracked&&) noexcept = default;
+        ~Tracked() { --*live; }
+    };
+
+    int live = 0;
+    {
+        SPSCQueue<Tracked, 8> q; // Tracked has no default constructor
+        for (int i = 0; i < 5; ++i) {
+            assert(q.emplace(&live));
+        }
+        assert(live == 5);
+    }
+    assert(live == 0);
+}
+
+static void test_bulk_push_pop() {
+    SPSCQueue<int, 8> q;
+
+    std::vector<int> in = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    assert(q.push_bulk(in.begin(), in.end()) == 8); // stops when full
+    assert(q.full());
+
+    std::vector<int> out;
+    assert(q.pop_bulk(std::back_inserter(out), 5) == 5);
+    assert(out == std::vector<int>({0, 1, 2, 3, 4}));
+
+    // Wraps around the end of the ring
+    assert(q.push_bulk(in.begin() + 8, in.end()) == 4);
+    assert(q.pop_bulk(std::back_inserter(out), 100) == 7);
+    assert(out == in);
+    assert(q.empty());
+    assert(q.pop_bulk(std::back_inserter(out), 4) == 0);
+}
+
+static void test_claim_commit() {
+    SPSCQueue<int, 8> q;
+
+    // Advance the indices so the free region wraps: 6 slots at the end, 2 at the start
+    std::vector<int> warmup = {0, 0};
+    q.push_bulk(warmup.begin(), warmup.end());
+    std::vector<int> sink;
+    q.pop_bulk(std::back_inserter(sink), 2);
+
+    std::span<int> w = q.claim_write();
+    assert(w.size() == 6); // contiguous part only
+    for (std::size_t i = 0; i < w.size(); ++i) {
+        w[i] = static_cast<int>(i);
+    }
+    q.commit_write(4); // publish only the first four
+    assert(q.size() == 4);
+
+    std::span<int> r = q.claim_read();
+    assert(r.size() == 4);
+    assert(r[0] == 0 && r[3] == 3);
+    q.commit_read(3);
+    assert(q.size() == 1);
+
+    w = q.claim_write(3);
+    assert(w.size() == 2); // up to the end of the ring
+    w[0] = 4;
+    w[1] = 5;
+    q.commit_write(2);
+
+    w = q.claim_write(3);
+    assert(w.size() == 3); // wrapped to the start
+    w[0] = 6;
+    q.commit_write(1);
+
+    std::vector<int> out;
+    assert(q.pop_bulk(std::back_inserter(out), 8) == 4);
+    assert(out == std::vector<int>({3, 4, 5, 6}));
+}
+
+static void test_two_thread_bulk() {
+    constexpr int N     = 100000;
+    constexpr int Batch = 37;
+    SPSCQueue<int, 256> q;
+
+    std::thread producer([&] {
+        std::vector<int> batch(Batch);
+        int next = 0;
+        while (next < N) {
+            const int count = std::min(Batch, N - next);
+            for (int i = 0; i < count; ++i) {
+                batch[i] = next + i;
+            }
+            int pushed = 0;
+            while (pushed < count) {
+                pushed += static_cast<int>(
+                    q.push_bulk(batch.begin() + pushed, batch.begin() + count));
+                if (pushed < count) std::this_thread::yield();
+            }
+            next += count;
+        }
+    });
+
+    std::thread consumer([&] {
+        int expected = 0;
+        while (expected < N) {
+            std::span<int> r = q.claim_read(Batch);
+            if (r.empty()) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (int v : r) {
+                assert(v == expected);
+                ++expected;
+            }
+            q.commit_read(r.size());
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    assert(q.empty());
+}
+
+template <typename Wait>
+static void test_pop_wait_timeout() {
+    SPSCQueue<int, 4, Wait> q;
+
+    int x = 0;
+    const auto start = std::chrono::steady_clock::now();
+    assert(!q.pop_wait(x, std::chrono::milliseconds(20)));
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    assert(q.push(7));
+    assert(q.pop_wait(x, std::chrono::milliseconds(20)) && x == 7);
+}
+
+template <typename Wait>
+static void test_wait_streaming() {
+    constexpr int N = 20000;
+    SPSCQueue<int, 16, Wait> q;
+
+    std::thread producer([&] {
+        for (int i = 0; i < N; ++i) {
+            q.push_wait(i);
+            if (i % 4096 == 0) {
+                // Let the consumer go idle (and park, for SpinParkWait)
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+    });
+
+    for (int i = 0; i < N; ++i) {
+        int x = -1;
+        q.pop_wait(x);
+        assert(x == i);
+        if (i % 4099 == 0) {
+            // Let the producer fill the queue and wait for space
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    producer.join();
+}
+
+static void test_parked_consumer_is_woken() {
+    SPSCQueue<int, 4, lock_free::SpinParkWait> q;
+
+    std::atomic<bool> got{false};
+    std::thread consumer([&] {
+        int x = 0;
+        // Far longer than the test: only a wake-up can end this wait early
+        assert(q.pop_wait(x, std::chrono::seconds(30)));
+        assert(x == 42);
+        got.store(true);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // consumer is parked by now
+    const auto start = std::chrono::steady_clock::now();
+    assert(q.push(42));  // plain push still wakes a parked consumer
+    consumer.join();
+
+    assert(got.load());
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+}
+
+static void test_heap_queue_runtime_capacity() {
+    HeapSPSCQueue<int> q(5); // 8 slots internally, still holds exactly 5
+    assert(q.capacity() == 5);
+    assert(!q.huge_pages());
+
+    int next_push = 0;
+    int next_pop  = 0;
+    for (int lap = 0; lap < 10; ++lap) {
+        while (q.push(next_push)) {
+            ++next_push;
+        }
+        assert(q.full() && q.size() == 5);
+
+        std::vector<int> out;
+        assert(q.pop_bulk(std::back_inserter(out), 3) == 3);
+        for (int v : out) {
+            assert(v == next_pop++);
+        }
+    }
+
+    bool threw = false;
+    try {
+        HeapSPSCQueue<int> empty(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "HeapSPSCQueue(capacity=0) must throw std::invalid_argument");
+}
+
+static void test_heap_queue_alignment_and_destruction() {
+    struct alignas(128) Wide {
+        int* live;
+        explicit Wide(int* l) : live(l) { ++*live; }
+        ~Wide() { --*live; }
+    };
+
+    int live = 0;
+    {
+        HeapSPSCQueue<Wide> q(3);
+        std::span<Wide> w = q.claim_write(1);
+        assert(w.size() == 1);
+        assert(reinterpret_cast<std::uintptr_t>(w.data()) % 128 == 0);
+
+        assert(q.emplace(&live) && q.emplace(&live));
+        assert(live == 2);
+    }
+    assert(live == 0);
+}
+
+static void test_heap_queue_huge_pages() {
+    // Falls back to transparent huge pages when none are reserved
+    constexpr int N = 200000;
+    HeapSPSCQueue<std::uint64_t> q(1 << 16, lock_free::PageSize::Huge2M);
+    assert(q.capacity() == (1 << 16));
+
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < N; ++i) {
+            q.push_wait(i);
+        }
+    });
+
+    for (std::uint64_t i = 0; i < N; ++i) {
+        std::uint64_t x = 0;
+        q.pop_wait(x);
+        assert(x == i);
+    }
+    producer.join();
+    assert(q.empty());
+}
+
 static void test_two_thread_spsc() {
     constexpr int N = 10000;
     SPSCQueue<int, 1024> q;
@@ -82,7 +362,22 @@ int main() {
 
     test_single_thread_basic();
     test_single_thread_full();
+    test_non_power_of_two_capacity_wraparound();
+    test_clear_destroys_remaining();
     test_two_thread_spsc();
+    test_bulk_push_pop();
+    test_claim_commit();
+    test_two_thread_bulk();
+    test_heap_queue_runtime_capacity();
+    test_heap_queue_alignment_and_destruction();
+    test_heap_queue_huge_pages();
+    test_pop_wait_timeout<lock_free::BusySpinWait>();
+    test_pop_wait_timeout<lock_free::SpinYieldWait>();
+    test_pop_wait_timeout<lock_free::SpinParkWait>();
+    // BusySpinWait streaming needs a core per side; covered by the benchmarks
+    test_wait_streaming<lock_free::SpinYieldWait>();
+    test_wait_streaming<lock_free::SpinParkWait>();
+    test_parked_consumer_is_woken();
 
     std::cout << "All lock_free_queue tests passed.\n";
     return 0;
@@ -0,0 +1,122 @@
+#include "lock_free_queue/unbounded_spsc_queue.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using lock_free::UnboundedSPSCQueue;
+
+static void test_single_thread_basic() {
+    UnboundedSPSCQueue<int, 4> q;
+
+    assert(q.empty());
+
+    q.push(1);
+    q.push(2);
+    q.emplace(3);
+    assert(!q.empty());
+
+    int x = 0;
+    assert(q.pop(x) && x == 1);
+    assert(q.pop(x) && x == 2);
+    assert(q.pop(x) && x == 3);
+
+    assert(!q.pop(x)); // now empty
+    assert(q.empty());
+}
+
+static void test_grows_across_segments() {
+    UnboundedSPSCQueue<int, 4> q;
+
+    // A burst far larger than one segment never fails
+    for (int i = 0; i < 1000; ++i) {
+        q.push(i);
+    }
+    assert(q.allocated_segments() == 250);
+
+    int x = 0;
+    for (int i = 0; i < 1000; ++i) {
+        assert(q.pop(x) && x == i);
+    }
+    assert(!q.pop(x));
+}
+
+static void test_steady_state_reuses_segments() {
+    UnboundedSPSCQueue<int, 8> q(4);
+
+    // Queue depth stays below one segment: drained segments come back
+    int next_pop = 0;
+    for (int i = 0; i < 10000; ++i) {
+        q.push(i);
+        if (i % 5 == 4) {
+            int x = 0;
+            while (q.pop(x)) {
+                assert(x == next_pop++);
+            }
+        }
+    }
+    assert(next_pop == 10000);
+    assert(q.allocated_segments() <= 3);
+}
+
+static void test_destroys_unconsumed_elements() {
+    auto tracker = std::make_shared<int>(0);
+    {
+        UnboundedSPSCQueue<std::shared_ptr<int>, 4> q(1);
+        for (int i = 0; i < 10; ++i) {
+            q.push(tracker);
+        }
+        std::shared_ptr<int> out;
+        for (int i = 0; i < 6; ++i) {
+            assert(q.pop(out));
+        }
+        out.reset();
+        assert(tracker.use_count() == 5);
+    }
+    assert(tracker.use_count() == 1);
+}
+
+static void test_two_thread_spsc() {
+    constexpr int N = 200000;
+    UnboundedSPSCQueue<int, 64> q;
+
+    std::thread producer([&] {
+        for (int i = 0; i < N; ++i) {
+            q.push(i);
+            if (i % 10000 == 0) {
+                std::this_thread::yield(); // let the consumer catch up now and then
+            }
+        }
+    });
+
+    std::thread consumer([&] {
+        int expected = 0;
+        int x        = 0;
+        while (expected < N) {
+            if (q.pop(x)) {
+                assert(x == expected);
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    assert(q.empty());
+}
+
+int main() {
+    std::cout << "Running unbounded_spsc_queue tests...\n";
+
+    test_single_thread_basic();
+    test_grows_across_segments();
+    test_steady_state_reuses_segments();
+    test_destroys_unconsumed_elements();
+    test_two_thread_spsc();
+
+    std::cout << "All unbounded_spsc_queue tests passed.\n";
+    return 0;
+}
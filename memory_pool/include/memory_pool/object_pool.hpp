@@ -1,34 +1,62 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <new>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <utility>
 #include <type_traits>
 
 namespace memory_pool {
 
+/**
+ * Fixed-capacity object pool with an owner thread.
+ *
+ * OWNERSHIP MODEL:
+ * - The pool is owned by one thread (the constructing thread by default,
+ *   see bind_to_current_thread()). Only the owner may allocate.
+ * - deallocate() from the owner returns the slot to the local freelist.
+ * - deallocate() from any other thread pushes the slot onto a lock-free
+ *   MPSC "remote-free" stack instead; no locks on the cross-thread path.
+ * - The owner drains the remote-free stack in one batch the next time its
+ *   local freelist runs dry (or explicitly via reclaim_remote_frees()).
+ *
+ * The remote stack is only ever emptied with a single exchange(nullptr),
+ * so pushes never race with a pop of an individual node (no ABA).
+ */
 template <typename T, std::size_t N>
 class ObjectPool {
+    // A freed slot doubles as a node of the remote-free stack, so every
+    // slot must be able to hold either a T or a link pointer.
+    struct RemoteNode {
+        RemoteNode* next;
+    };
+
+    struct alignas(std::max(alignof(T), alignof(RemoteNode))) Slot {
+        std::byte storage[std::max(sizeof(T), sizeof(RemoteNode))];
+    };
+
 public:
     ObjectPool() {
         static_assert(N > 0, "ObjectPool capacity N must be > 0");
         freelist_.reserve(N);
 
-        pool_ = static_cast<T*>(
-            ::operator new(sizeof(T) * N, std::align_val_t{alignof(T)})
+        pool_ = static_cast<Slot*>(
+            ::operator new(sizeof(Slot) * N, std::align_val_t{alignof(Slot)})
         );
 
         for (std::size_t i = 0; i < N; ++i) {
-            freelist_.push_back(std::launder(pool_ + i));
+            freelist_.push_back(reinterpret_cast<T*>(pool_ + i));
         }
     }
 
     ~ObjectPool() {
         // We assume all objects have been returned.
         // If you want to be stricter, you can track live objects.
-        ::operator delete(pool_, std::align_val_t{alignof(T)});
+        ::operator delete(pool_, std::align_val_t{alignof(Slot)});
     }
 
     ObjectPool(const ObjectPool&) = delete;
@@ -37,9 +65,10 @@ public:
     ObjectPool& operator=(ObjectPool&&) = delete;
 
     /// Allocate and construct a T with forwarded args.
+    /// Owner thread only. Drains pending remote frees before giving up.
     template <class... Args>
     [[nodiscard]] T* allocate(Args&&... args) {
-        if (freelist_.empty()) {
+        if (freelist_.empty() && reclaim_remote_frees() == 0) {
             throw std::bad_alloc{};
         }
 
@@ -54,11 +83,41 @@ public:
         }
     }
 
-    /// Destroy and return the slot to the freelist.
+    /// Destroy and return the slot to the pool.
+    /// Safe to call from any thread: frees from non-owner threads go
+    /// through the lock-free remote-free stack.
     void deallocate(T* ptr) noexcept {
         if (!ptr) return;
         std::destroy_at(ptr);
-        freelist_.push_back(ptr);
+
+        if (std::this_thread::get_id() == owner_) {
+            freelist_.push_back(ptr);
+        } else {
+            push_remote(ptr);
+        }
+    }
+
+    /// Move every slot freed by other threads onto the local freelist.
+    /// Owner thread only. Returns the number of slots reclaimed.
+    std::size_t reclaim_remote_frees() noexcept {
+        RemoteNode* node = remote_head_.exchange(nullptr, std::memory_order_acquire);
+
+        std::size_t reclaimed = 0;
+        while (node) {
+            RemoteNode* next = node->next;
+            std::destroy_at(node);
+            freelist_.push_back(reinterpret_cast<T*>(node));
+            node = next;
+            ++reclaimed;
+        }
+        return reclaimed;
+    }
+
+    /// Transfer ownership to the calling thread (e.g. after constructing
+    /// the pool on a setup thread and handing it to the producer).
+    /// Must not race with allocate()/deallocate() on the previous owner.
+    void bind_to_current_thread() noexcept {
+        owner_ = std::this_thread::get_id();
     }
 
     struct Deleter {
@@ -80,12 +139,30 @@ public:
     }
 
     [[nodiscard]] std::size_t capacity() const noexcept { return N; }
+
+    /// Slots on the owner's local freelist. Slots still parked on the
+    /// remote-free stack are not counted until they are reclaimed.
     [[nodiscard]] std::size_t free_slots() const noexcept { return freelist_.size(); }
 
+    [[nodiscard]] std::thread::id owner_thread() const noexcept { return owner_; }
+
 private:
-    T* pool_{nullptr};
+    void push_remote(T* ptr) noexcept {
+        auto* node = std::construct_at(reinterpret_cast<RemoteNode*>(ptr));
+        node->next = remote_head_.load(std::memory_order_relaxed);
+        while (!remote_head_.compare_exchange_weak(node->next, node,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+            // node->next refreshed with the current head; retry
+        }
+    }
+
+    Slot* pool_{nullptr};
     std::vector<T*> freelist_;
+    std::thread::id owner_{std::this_thread::get_id()};
+
+    // Written by non-owner threads; kept off the owner's cache lines.
+    alignas(64) std::atomic<RemoteNode*> remote_head_{nullptr};
 };
 
 } // namespace memory_pool
-
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "memory_pool/fixed_block_memory_pool.hpp"
+
+namespace memory_pool {
+
+/**
+ * STL-style allocator adapter over a FixedBlockMemoryPool.
+ *
+ * Every allocation is a single block, so this suits node-based users that
+ * allocate one object at a time (std::list, allocate_shared control blocks,
+ * ...), not contiguous containers. Requests for n != 1 objects, or objects
+ * larger than the pool's block size, throw std::bad_alloc.
+ *
+ * The pool must outlive every allocator (and allocation) that refers to it.
+ * Not thread-safe, same as the underlying pool.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(FixedBlockMemoryPool& pool) noexcept
+        : pool_(&pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+        : pool_(other.pool_) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        // Blocks are only guaranteed pointer alignment
+        static_assert(alignof(T) <= alignof(void*),
+                      "PoolAllocator does not support over-aligned types");
+
+        if (n != 1 || sizeof(T) > pool_->block_size()) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(pool_->allocate());
+    }
+
+    void deallocate(T* ptr, std::size_t) noexcept {
+        pool_->deallocate(ptr);
+    }
+
+    [[nodiscard]] FixedBlockMemoryPool& pool() const noexcept { return *pool_; }
+
+    template <typename U>
+    friend bool operator==(const PoolAllocator& a, const PoolAllocator<U>& b) noexcept {
+        return &a.pool() == &b.pool();
+    }
+
+private:
+    template <typename U> friend class PoolAllocator;
+
+    FixedBlockMemoryPool* pool_;
+};
+
+} // namespace memory_pool
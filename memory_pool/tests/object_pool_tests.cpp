@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "memory_pool/object_pool.hpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using memory_pool::ObjectPool;
 
 struct TestObject {
@@ -167,3 +171,143 @@ TEST(ObjectPool, ConstructorArgumentsForwarded)
     EXPECT_EQ(TestObject::live_count, 0);
 }
 
+
+TEST(ObjectPool, RemoteFreeIsReclaimedOnAllocationMiss)
+{
+    TestObject::reset_counters();
+
+    constexpr std::size_t N = 2;
+    ObjectPool<TestObject, N> pool;
+
+    auto* a = pool.allocate(1, "a");
+    auto* b = pool.allocate(2, "b");
+    EXPECT_EQ(pool.free_slots(), 0);
+
+    std::thread consumer([&] {
+        pool.deallocate(a);
+        pool.deallocate(b);
+    });
+    consumer.join();
+
+    // Destroyed on the consumer, but parked on the remote-free stack
+    EXPECT_EQ(TestObject::live_count, 0);
+    EXPECT_EQ(pool.free_slots(), 0);
+
+    // Local freelist is empty, so this allocation drains the remote frees
+    auto* c = pool.allocate(3, "c");
+    EXPECT_EQ(c->id, 3);
+    EXPECT_EQ(pool.free_slots(), 1);
+
+    pool.deallocate(c);
+    EXPECT_EQ(pool.free_slots(), 2);
+}
+
+TEST(ObjectPool, ExplicitReclaimRemoteFrees)
+{
+    constexpr std::size_t N = 4;
+    ObjectPool<int, N> pool;
+
+    std::vector<int*> objs;
+    for (std::size_t i = 0; i < N; ++i) {
+        objs.push_back(pool.allocate(static_cast<int>(i)));
+    }
+
+    std::thread consumer([&] {
+        for (auto* p : objs) {
+            pool.deallocate(p);
+        }
+    });
+    consumer.join();
+
+    EXPECT_EQ(pool.free_slots(), 0);
+    EXPECT_EQ(pool.reclaim_remote_frees(), N);
+    EXPECT_EQ(pool.free_slots(), N);
+    EXPECT_EQ(pool.reclaim_remote_frees(), 0);
+}
+
+TEST(ObjectPool, BindToCurrentThreadTransfersOwnership)
+{
+    constexpr std::size_t N = 1;
+    ObjectPool<int, N> pool;
+
+    std::thread producer([&] {
+        pool.bind_to_current_thread();
+        EXPECT_EQ(pool.owner_thread(), std::this_thread::get_id());
+
+        // Owner frees go straight to the local freelist
+        pool.deallocate(pool.allocate(5));
+        EXPECT_EQ(pool.free_slots(), 1);
+    });
+    producer.join();
+}
+
+// Destructors run concurrently on consumer threads, so count with an atomic
+struct Message {
+    inline static std::atomic<int> live_count{0};
+
+    int id;
+
+    explicit Message(int i) : id(i) { live_count.fetch_add(1); }
+    ~Message() { live_count.fetch_sub(1); }
+};
+
+TEST(ObjectPool, ProducerWithManyRemoteConsumers)
+{
+    constexpr std::size_t N         = 64;
+    constexpr int         consumers = 4;
+    constexpr int         total     = 20000;
+
+    ObjectPool<Message, N> pool;
+
+    std::atomic<Message*> mailbox[consumers] = {};
+    std::atomic<bool>        done{false};
+    std::atomic<int>         freed{0};
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            while (true) {
+                Message* obj = mailbox[c].exchange(nullptr, std::memory_order_acquire);
+                if (obj) {
+                    pool.deallocate(obj);
+                    freed.fetch_add(1, std::memory_order_relaxed);
+                } else if (done.load(std::memory_order_acquire)) {
+                    break;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < total; ++i) {
+        Message* obj = nullptr;
+        while (!obj) {
+            try {
+                obj = pool.allocate(i);
+            } catch (const std::bad_alloc&) {
+                std::this_thread::yield();  // wait for consumers to free
+            }
+        }
+
+        auto& slot = mailbox[i % consumers];
+        Message* expected = nullptr;
+        while (!slot.compare_exchange_weak(expected, obj, std::memory_order_release)) {
+            expected = nullptr;
+            std::this_thread::yield();
+        }
+    }
+
+    // Wait for the consumers to empty their mailboxes before stopping them
+    while (freed.load(std::memory_order_relaxed) < total) {
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    pool.reclaim_remote_frees();
+    EXPECT_EQ(Message::live_count.load(), 0);
+    EXPECT_EQ(pool.free_slots(), N);
+}
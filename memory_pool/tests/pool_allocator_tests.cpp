@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "memory_pool/pool_allocator.hpp"
+
+#include <list>
+
+using memory_pool::FixedBlockMemoryPool;
+using memory_pool::PoolAllocator;
+
+TEST(PoolAllocator, ListNodesComeFromPool)
+{
+    // std::list nodes are {prev, next, value}
+    FixedBlockMemoryPool pool(4 * sizeof(void*), 8);
+
+    std::list<int, PoolAllocator<int>> list{PoolAllocator<int>(pool)};
+    for (int i = 0; i < 8; ++i) {
+        list.push_back(i);
+    }
+
+    // The pool holds exactly 8 blocks
+    EXPECT_THROW(list.push_back(8), std::bad_alloc);
+
+    list.pop_front();
+    list.push_back(8);  // freed block is reused
+    EXPECT_EQ(list.size(), 8u);
+    EXPECT_EQ(list.back(), 8);
+}
+
+TEST(PoolAllocator, RebindSharesPool)
+{
+    FixedBlockMemoryPool pool(64, 2);
+
+    PoolAllocator<int>    ints(pool);
+    PoolAllocator<double> doubles(ints);
+
+    EXPECT_TRUE(ints == doubles);
+    EXPECT_EQ(&doubles.pool(), &pool);
+
+    double* d = doubles.allocate(1);
+    ints.deallocate(reinterpret_cast<int*>(d), 1);
+}
+
+TEST(PoolAllocator, RejectsArrayAndOversizedRequests)
+{
+    FixedBlockMemoryPool pool(sizeof(int), 4);
+    PoolAllocator<int> alloc(pool);
+
+    EXPECT_THROW((void)alloc.allocate(2), std::bad_alloc);
+
+    struct Big { char bytes[64]; };
+    PoolAllocator<Big> big(alloc);
+    EXPECT_THROW((void)big.allocate(1), std::bad_alloc);
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace reclamation::detail {
+
+// Type-erased object awaiting reclamation
+struct Retired {
+    void*         ptr;
+    void        (*deleter)(void*);
+    std::uint64_t epoch;  // retire epoch (EBR only)
+
+    void reclaim() const noexcept { deleter(ptr); }
+};
+
+template <typename T>
+void delete_object(void* p) noexcept {
+    delete static_cast<T*>(p);
+}
+
+/**
+ * Lock-free, push-only registry of per-thread records.
+ *
+ * Records are never unlinked while the registry lives: a thread that exits
+ * marks its record free, and the next thread to register reuses it. Scans
+ * walk the list without locks.
+ */
+template <typename Record>
+class RecordRegistry {
+public:
+    RecordRegistry() = default;
+    RecordRegistry(const RecordRegistry&)            = delete;
+    RecordRegistry& operator=(const RecordRegistry&) = delete;
+
+    ~RecordRegistry() {
+        Record* rec = head_.load(std::memory_order_acquire);
+        while (rec) {
+            Record* next = rec->next;
+            delete rec;
+            rec = next;
+        }
+    }
+
+    // Claim a free record, or allocate and publish a new one
+    Record* acquire() {
+        for (Record* rec = head_.load(std::memory_order_acquire); rec; rec = rec->next) {
+            bool expected = false;
+            if (!rec->in_use.load(std::memory_order_relaxed) &&
+                rec->in_use.compare_exchange_strong(expected, true,
+                                                    std::memory_order_acquire)) {
+                return rec;
+            }
+        }
+
+        auto* rec = new Record();
+        rec->in_use.store(true, std::memory_order_relaxed);
+        rec->next = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(rec->next, rec,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+        count_.fetch_add(1, std::memory_order_relaxed);
+        return rec;
+    }
+
+    void release(Record* rec) noexcept {
+        rec->in_use.store(false, std::memory_order_release);
+    }
+
+    template <typename F>
+    void for_each(F&& fn) const {
+        for (Record* rec = head_.load(std::memory_order_acquire); rec; rec = rec->next) {
+            fn(*rec);
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<Record*>     head_{nullptr};
+    std::atomic<std::size_t> count_{0};
+};
+
+/**
+ * Retired objects left behind by exited threads. Any later reclaim pass
+ * adopts them. Exits are rare, so a mutex is fine here; the hot path only
+ * checks the atomic counter.
+ */
+class OrphanList {
+public:
+    OrphanList() = default;
+    OrphanList(const OrphanList&)            = delete;
+    OrphanList& operator=(const OrphanList&) = delete;
+
+    ~OrphanList() {
+        for (const Retired& r : items_) {
+            r.reclaim();
+        }
+    }
+
+    void add(std::vector<Retired>&& items) {
+        if (items.empty()) return;
+        std::lock_guard<std::mutex> lk(mutex_);
+        items_.insert(items_.end(), items.begin(), items.end());
+        pending_.store(items_.size(), std::memory_order_release);
+        items.clear();
+    }
+
+    // Move all orphans into out (no-op when there are none)
+    void adopt(std::vector<Retired>& out) {
+        if (pending_.load(std::memory_order_acquire) == 0) return;
+        std::lock_guard<std::mutex> lk(mutex_);
+        out.insert(out.end(), items_.begin(), items_.end());
+        items_.clear();
+        pending_.store(0, std::memory_order_release);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return pending_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::mutex               mutex_;
+    std::vector<Retired>     items_;
+    std::atomic<std::size_t> pending_{0};
+};
+
+} // namespace reclamation::detail
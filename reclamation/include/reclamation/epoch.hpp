@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "reclamation/detail/retired.hpp"
+
+namespace reclamation {
+
+class EpochGuard;
+
+/**
+ * Epoch-based reclamation (Fraser, 2004).
+ *
+ * DESIGN:
+ * - A global epoch counter. A thread entering a critical section (EpochGuard)
+ *   announces the epoch it observed; leaving clears the announcement.
+ * - retire() tags the node with the current global epoch and parks it on a
+ *   per-thread list.
+ * - The epoch may advance from e to e+1 only once every active thread has
+ *   announced e. A node retired in epoch e is therefore unreachable by any
+ *   reader once the global epoch reaches e+2, and is freed then.
+ * - Reclamation runs when a thread's list reaches kRetireThreshold (or on
+ *   an explicit reclaim()), so its cost is batched across many retires.
+ *
+ * COST MODEL vs hazard pointers:
+ * - Read side: one store + one fence per critical section, regardless of how
+ *   many nodes are touched inside it (hazard pointers pay per node).
+ * - A reader stalled inside a guard blocks all reclamation; garbage is
+ *   unbounded in that case (hazard pointers bound it).
+ *
+ * Guards nest; only the outermost one announces. One process-wide domain:
+ * EpochDomain::global().
+ */
+class EpochDomain {
+public:
+    static constexpr std::size_t kRetireThreshold = 128;
+
+    static EpochDomain& global() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    EpochDomain(const EpochDomain&)            = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Defer `delete ptr` until no critical section can still reference it.
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, &detail::delete_object<T>);
+    }
+
+    void retire(void* ptr, void (*deleter)(void*)) {
+        auto& st = local();
+        st.retired.push_back({ptr, deleter, epoch_.load(std::memory_order_acquire)});
+        if (st.retired.size() >= kRetireThreshold) {
+            collect(st);
+        }
+    }
+
+    // Try to advance the epoch and free what has become safe.
+    // Returns the number of nodes freed.
+    std::size_t reclaim() {
+        return collect(local());
+    }
+
+    [[nodiscard]] std::uint64_t epoch() const noexcept {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    // Nodes retired by the calling thread (or orphaned by exited threads)
+    // and not yet freed
+    [[nodiscard]] std::size_t pending() {
+        return local().retired.size() + orphans_.size();
+    }
+
+private:
+    friend class EpochGuard;
+
+    static constexpr std::uint64_t kActive = 1;
+
+    struct Record {
+        std::atomic<std::uint64_t> state{0};  // (epoch << 1) | kActive, 0 when idle
+        std::atomic<bool>          in_use{false};
+        Record*                    next{nullptr};
+    };
+
+    struct ThreadState {
+        EpochDomain*                 domain;
+        Record*                      rec;
+        unsigned                     depth{0};
+        std::vector<detail::Retired> retired;
+
+        explicit ThreadState(EpochDomain* d)
+            : domain(d), rec(d->registry_.acquire()) {}
+
+        ~ThreadState() {
+            rec->state.store(0, std::memory_order_release);
+            domain->registry_.release(rec);
+            domain->collect(*this);
+            domain->orphans_.add(std::move(retired));
+        }
+    };
+
+    EpochDomain() = default;
+
+    ThreadState& local() {
+        thread_local ThreadState state(this);
+        return state;
+    }
+
+    void enter() {
+        auto& st = local();
+        if (st.depth++ == 0) {
+            const std::uint64_t e = epoch_.load(std::memory_order_relaxed);
+            st.rec->state.store((e << 1) | kActive, std::memory_order_relaxed);
+            // Announcement must be visible before any shared pointer is read
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void exit() noexcept {
+        auto& st = local();
+        if (--st.depth == 0) {
+            st.rec->state.store(0, std::memory_order_release);
+        }
+    }
+
+    bool try_advance() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t e = epoch_.load(std::memory_order_acquire);
+
+        bool all_caught_up = true;
+        registry_.for_each([&](const Record& rec) {
+            const std::uint64_t s = rec.state.load(std::memory_order_acquire);
+            if ((s & kActive) && (s >> 1) != e) {
+                all_caught_up = false;
+            }
+        });
+
+        return all_caught_up &&
+               epoch_.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+    }
+
+    std::size_t collect(ThreadState& st) {
+        orphans_.adopt(st.retired);
+        if (st.retired.empty()) return 0;
+
+        try_advance();
+        const std::uint64_t e = epoch_.load(std::memory_order_acquire);
+
+        std::size_t freed = 0;
+        std::size_t kept  = 0;
+        for (std::size_t i = 0; i < st.retired.size(); ++i) {
+            if (st.retired[i].epoch + 2 <= e) {
+                st.retired[i].reclaim();
+                ++freed;
+            } else {
+                st.retired[kept++] = st.retired[i];
+            }
+        }
+        st.retired.resize(kept);
+        return freed;
+    }
+
+    std::atomic<std::uint64_t>     epoch_{0};
+    detail::RecordRegistry<Record> registry_;
+    detail::OrphanList             orphans_;
+};
+
+/**
+ * RAII critical section. Pointers loaded from shared structures while a
+ * guard is alive stay valid until the guard is destroyed.
+ *
+ * USAGE:
+ *   {
+ *       EpochGuard guard;
+ *       for (Node* n = head_.load(std::memory_order_acquire); n; n = n->next) { ... }
+ *   }
+ */
+class EpochGuard {
+public:
+    EpochGuard()
+        : domain_(&EpochDomain::global()) {
+        domain_->enter();
+    }
+
+    ~EpochGuard() {
+        domain_->exit();
+    }
+
+    EpochGuard(const EpochGuard&)            = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+private:
+    EpochDomain* domain_;
+};
+
+} // namespace reclamation
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "reclamation/detail/retired.hpp"
+
+namespace reclamation {
+
+class HazardPointer;
+
+/**
+ * Hazard-pointer safe memory reclamation (Michael, 2004).
+ *
+ * DESIGN:
+ * - Every reader publishes the pointer it is about to dereference in a
+ *   hazard slot (one slot per live HazardPointer guard).
+ * - Unlinked nodes are retire()d onto a per-thread list instead of deleted.
+ * - Once a thread's list reaches the threshold (max(64, 2 * slots)), it
+ *   snapshots all hazard slots and frees every retired node nobody protects.
+ *   Amortized O(1) per retire, and at most O(threads * slots) garbage.
+ *
+ * MEMORY ORDERING:
+ * - protect(): store hazard, seq_cst fence, re-read the source. If the source
+ *   still holds the pointer, any later retire() scan is guaranteed to see it.
+ * - scan: seq_cst fence before reading hazard slots pairs with the above.
+ *
+ * THREAD EXIT:
+ * - Cached slots go back to the shared registry; still-protected retired
+ *   nodes move to an orphan list that the next reclaim pass adopts.
+ *
+ * One process-wide domain: HazardPointerDomain::global().
+ */
+class HazardPointerDomain {
+public:
+    static constexpr std::size_t kRetireThresholdBase = 64;
+
+    static HazardPointerDomain& global() {
+        static HazardPointerDomain domain;
+        return domain;
+    }
+
+    HazardPointerDomain(const HazardPointerDomain&)            = delete;
+    HazardPointerDomain& operator=(const HazardPointerDomain&) = delete;
+
+    // Defer `delete ptr` until no hazard pointer protects it.
+    template <typename T>
+    void retire(T* ptr) {
+        retire(ptr, &detail::delete_object<T>);
+    }
+
+    void retire(void* ptr, void (*deleter)(void*)) {
+        auto& st = local();
+        st.retired.push_back({ptr, deleter, 0});
+        if (st.retired.size() >= retire_threshold()) {
+            scan(st);
+        }
+    }
+
+    // Scan now: free this thread's (and orphaned) unprotected retired nodes.
+    // Returns the number of nodes freed.
+    std::size_t reclaim() {
+        return scan(local());
+    }
+
+    // Nodes retired by the calling thread (or orphaned by exited threads)
+    // and not yet freed
+    [[nodiscard]] std::size_t pending() {
+        return local().retired.size() + orphans_.size();
+    }
+
+    // Total hazard slots ever created (the scan cost)
+    [[nodiscard]] std::size_t slot_count() const noexcept { return registry_.size(); }
+
+    [[nodiscard]] std::size_t retire_threshold() const noexcept {
+        return std::max(kRetireThresholdBase, 2 * registry_.size());
+    }
+
+private:
+    friend class HazardPointer;
+
+    struct Record {
+        std::atomic<const void*> hazard{nullptr};
+        std::atomic<bool>        in_use{false};
+        Record*                  next{nullptr};
+    };
+
+    struct ThreadState {
+        HazardPointerDomain*          domain;
+        std::vector<detail::Retired>  retired;
+        std::vector<Record*>          cached;  // slots owned by this thread, currently unused
+
+        explicit ThreadState(HazardPointerDomain* d) : domain(d) {}
+
+        ~ThreadState() {
+            for (Record* rec : cached) {
+                domain->registry_.release(rec);
+            }
+            domain->scan(*this);
+            domain->orphans_.add(std::move(retired));
+        }
+    };
+
+    HazardPointerDomain() = default;
+
+    ThreadState& local() {
+        thread_local ThreadState state(this);
+        return state;
+    }
+
+    Record* acquire_record() {
+        auto& st = local();
+        if (!st.cached.empty()) {
+            Record* rec = st.cached.back();
+            st.cached.pop_back();
+            return rec;
+        }
+        return registry_.acquire();
+    }
+
+    void release_record(Record* rec) {
+        rec->hazard.store(nullptr, std::memory_order_release);
+        local().cached.push_back(rec);
+    }
+
+    std::size_t scan(ThreadState& st) {
+        orphans_.adopt(st.retired);
+        if (st.retired.empty()) return 0;
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::vector<const void*> hazards;
+        hazards.reserve(registry_.size());
+        registry_.for_each([&hazards](const Record& rec) {
+            if (const void* p = rec.hazard.load(std::memory_order_acquire)) {
+                hazards.push_back(p);
+            }
+        });
+        std::sort(hazards.begin(), hazards.end());
+
+        const auto keep_begin = std::partition(
+            st.retired.begin(), st.retired.end(),
+            [&hazards](const detail::Retired& r) {
+                return !std::binary_search(hazards.begin(), hazards.end(), r.ptr);
+            });
+
+        const auto freed = static_cast<std::size_t>(keep_begin - st.retired.begin());
+        for (auto it = st.retired.begin(); it != keep_begin; ++it) {
+            it->reclaim();
+        }
+        st.retired.erase(st.retired.begin(), keep_begin);
+        return freed;
+    }
+
+    detail::RecordRegistry<Record> registry_;
+    detail::OrphanList             orphans_;
+};
+
+/**
+ * RAII owner of one hazard slot.
+ *
+ * USAGE:
+ *   HazardPointer hp;
+ *   Node* n = hp.protect(head_);   // safe to dereference n until reset/destruction
+ *
+ * Not shareable between threads; cheap to create after the first use on a
+ * thread (slots are cached per thread).
+ */
+class HazardPointer {
+public:
+    HazardPointer()
+        : domain_(&HazardPointerDomain::global())
+        , rec_(domain_->acquire_record()) {}
+
+    ~HazardPointer() {
+        if (rec_) {
+            domain_->release_record(rec_);
+        }
+    }
+
+    HazardPointer(const HazardPointer&)            = delete;
+    HazardPointer& operator=(const HazardPointer&) = delete;
+
+    HazardPointer(HazardPointer&& other) noexcept
+        : domain_(other.domain_), rec_(std::exchange(other.rec_, nullptr)) {}
+
+    HazardPointer& operator=(HazardPointer&& other) noexcept {
+        if (this != &other) {
+            if (rec_) {
+                domain_->release_record(rec_);
+            }
+            domain_ = other.domain_;
+            rec_    = std::exchange(other.rec_, nullptr);
+        }
+        return *this;
+    }
+
+    // Load src and protect the result; loops until the protection is stable.
+    template <typename T>
+    T* protect(const std::atomic<T*>& src) noexcept {
+        T* ptr = src.load(std::memory_order_relaxed);
+        while (!try_protect(ptr, src)) {
+        }
+        return ptr;
+    }
+
+    // Protect ptr if src still holds it. On failure ptr is updated to the
+    // current value of src and the slot is left unprotected.
+    template <typename T>
+    bool try_protect(T*& ptr, const std::atomic<T*>& src) noexcept {
+        rec_->hazard.store(ptr, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        T* current = src.load(std::memory_order_acquire);
+        if (current == ptr) {
+            return true;
+        }
+        rec_->hazard.store(nullptr, std::memory_order_release);
+        ptr = current;
+        return false;
+    }
+
+    // Replace the protected pointer (must already be known to be live) or clear it.
+    void reset_protection(const void* ptr = nullptr) noexcept {
+        rec_->hazard.store(ptr, std::memory_order_release);
+    }
+
+private:
+    HazardPointerDomain*         domain_;
+    HazardPointerDomain::Record* rec_;
+};
+
+} // namespace reclamation
@@ -0,0 +1,77 @@
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "reclamation/epoch.hpp"
+#include "reclamation/hazard_pointer.hpp"
+
+using namespace reclamation;
+
+struct Config {
+    std::string name;
+    int         version;
+
+    Config(std::string n, int v) : name(std::move(n)), version(v) {}
+    ~Config() {
+        std::cout << "Config v" << version << " reclaimed\n";
+    }
+};
+
+static void demo_hazard_pointers() {
+    std::cout << "=== Hazard pointer demo ===\n";
+
+    std::atomic<Config*> current{new Config("primary", 1)};
+    auto& domain = HazardPointerDomain::global();
+
+    {
+        HazardPointer hp;
+        Config* cfg = hp.protect(current);
+
+        // A writer swaps in a new version and retires the old one
+        domain.retire(current.exchange(new Config("primary", 2)));
+        domain.reclaim();
+        std::cout << "still reading v" << cfg->version
+                  << " (pending = " << domain.pending() << ")\n";
+    }
+
+    domain.reclaim();
+    std::cout << "after release, pending = " << domain.pending() << "\n";
+
+    domain.retire(current.exchange(nullptr));
+    domain.reclaim();
+}
+
+static void demo_epochs() {
+    std::cout << "\n=== Epoch-based reclamation demo ===\n";
+
+    std::atomic<Config*> current{new Config("replica", 1)};
+    auto& domain = EpochDomain::global();
+
+    {
+        EpochGuard guard;
+        Config* cfg = current.load(std::memory_order_acquire);
+
+        domain.retire(current.exchange(new Config("replica", 2)));
+        domain.reclaim();
+        std::cout << "still reading v" << cfg->version
+                  << " (epoch = " << domain.epoch() << ")\n";
+    }
+
+    // Two epoch advances are needed before v1 can be freed
+    domain.reclaim();
+    domain.reclaim();
+    std::cout << "after guard, pending = " << domain.pending()
+              << " (epoch = " << domain.epoch() << ")\n";
+
+    domain.retire(current.exchange(nullptr));
+    while (domain.pending() > 0) {
+        domain.reclaim();
+    }
+}
+
+int main() {
+    demo_hazard_pointers();
+    demo_epochs();
+    return 0;
+}
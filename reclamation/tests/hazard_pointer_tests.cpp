@@ -0,0 +1,175 @@
+#include "reclamation/hazard_pointer.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using reclamation::HazardPointer;
+using reclamation::HazardPointerDomain;
+
+struct Node {
+    inline static std::atomic<int> destroyed{0};
+
+    int   value;
+    Node* next{nullptr};
+
+    explicit Node(int v) : value(v) {}
+    ~Node() { destroyed.fetch_add(1, std::memory_order_relaxed); }
+};
+
+// Treiber stack whose pops are made safe by hazard pointers
+class Stack {
+public:
+    ~Stack() {
+        Node* n = head_.load();
+        while (n) {
+            Node* next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    void push(int v) {
+        auto* n = new Node(v);
+        n->next = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(n->next, n,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+
+    bool pop(int& out) {
+        HazardPointer hp;
+        while (true) {
+            Node* top = hp.protect(head_);
+            if (!top) return false;
+
+            Node* next = top->next;  // safe: top cannot be freed while protected
+            if (head_.compare_exchange_weak(top, next,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+                out = top->value;
+                hp.reset_protection();
+                HazardPointerDomain::global().retire(top);
+                return true;
+            }
+        }
+    }
+
+private:
+    std::atomic<Node*> head_{nullptr};
+};
+
+static void drain_retired() {
+    auto& domain = HazardPointerDomain::global();
+    while (domain.pending() > 0) {
+        domain.reclaim();
+    }
+}
+
+static void test_protected_node_is_not_freed() {
+    drain_retired();
+    Node::destroyed.store(0);
+
+    std::atomic<Node*> src{new Node(1)};
+
+    std::atomic<bool> protected_flag{false};
+    std::atomic<bool> release_flag{false};
+
+    std::thread reader([&] {
+        HazardPointer hp;
+        Node* n = hp.protect(src);
+        protected_flag.store(true);
+        while (!release_flag.load()) {
+            std::this_thread::yield();
+        }
+        assert(n->value == 1);  // still alive
+    });
+
+    while (!protected_flag.load()) {
+        std::this_thread::yield();
+    }
+
+    Node* old = src.exchange(nullptr);
+    HazardPointerDomain::global().retire(old);
+    HazardPointerDomain::global().reclaim();
+    assert(Node::destroyed.load() == 0);
+
+    release_flag.store(true);
+    reader.join();
+
+    drain_retired();
+    assert(Node::destroyed.load() == 1);
+}
+
+static void test_retire_threshold_triggers_scan() {
+    drain_retired();
+    auto& domain = HazardPointerDomain::global();
+
+    const std::size_t threshold = domain.retire_threshold();
+    for (std::size_t i = 0; i + 1 < threshold; ++i) {
+        domain.retire(new Node(0));
+    }
+    assert(domain.pending() == threshold - 1);
+
+    domain.retire(new Node(0));  // hits the threshold: nothing protected, all freed
+    assert(domain.pending() == 0);
+}
+
+static void test_stack_stress() {
+    drain_retired();
+    Node::destroyed.store(0);
+
+    constexpr int threads   = 4;
+    constexpr int per_thread = 20000;
+
+    {
+        Stack stack;
+        std::atomic<long> popped_sum{0};
+        std::atomic<int>  popped{0};
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    stack.push(t * per_thread + i);
+                    int v = 0;
+                    if (stack.pop(v)) {
+                        popped_sum.fetch_add(v, std::memory_order_relaxed);
+                        popped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        int v = 0;
+        while (stack.pop(v)) {
+            popped_sum.fetch_add(v);
+            popped.fetch_add(1);
+        }
+
+        const long n = static_cast<long>(threads) * per_thread;
+        assert(popped.load() == n);
+        assert(popped_sum.load() == n * (n - 1) / 2);
+    }
+
+    // Exited threads left their leftovers as orphans; adopt and free them
+    drain_retired();
+    assert(Node::destroyed.load() == threads * per_thread);
+}
+
+int main() {
+    std::cout << "Running hazard pointer tests...\n";
+
+    test_protected_node_is_not_freed();
+    test_retire_threshold_triggers_scan();
+    test_stack_stress();
+
+    std::cout << "All hazard pointer tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "smart_pointers/ref_count.hpp"
+#include "smart_pointers/shared_ptr.hpp"
+
+namespace smart_pointers {
+
+/**
+ * Lock-free atomic holder of a SharedPtr<T, AtomicRefCount>, for publishing
+ * read-mostly snapshots (configs, routing tables) to many reader threads.
+ *
+ * DESIGN (split reference counts with pre-credited batches):
+ * - One 64-bit word packs the control-block pointer (low 48 bits) and a
+ *   16-bit "credit" count (high bits).
+ * - Whenever a block is published, kBatch strong references are added to
+ *   its count up front and recorded as credits in the word.
+ * - load() takes a credit with a single fetch_sub on the word. The credit
+ *   already *is* a strong reference, so the common read path never touches
+ *   the control block and never retries.
+ * - When credits run low, the reader that notices tops them up (add to the
+ *   block count, then CAS the credits back up; undone if the CAS loses).
+ * - exchange()/store() swap the word and return the unused credits of the
+ *   old block to its count.
+ *
+ * Every transition keeps `strong_count == owners + credits`, and credits are
+ * interchangeable, so the scheme has no ABA problem even if the same block
+ * is republished.
+ *
+ * MEMORY ORDERING:
+ * - publishing (exchange/CAS) is acq_rel, load's fetch_sub is acquire, so a
+ *   reader sees the snapshot contents written before it was published.
+ *
+ * LIMITATIONS:
+ * - Needs 64-bit pointers with user-space addresses below 2^48
+ *   (x86-64 and AArch64 with 4-level page tables).
+ * - While a block is published, use_count() on its SharedPtrs includes the
+ *   outstanding credits, so it is not meaningful for uniqueness checks.
+ * - At most ~16k threads may be inside load() concurrently.
+ */
+template <typename T>
+class AtomicSharedPtr {
+    static_assert(sizeof(void*) == 8, "AtomicSharedPtr packs pointers into 48 bits");
+
+    using Block = ControlBlockBase<T, AtomicRefCount>;
+
+    static constexpr unsigned      kCreditShift = 48;
+    static constexpr std::uint64_t kCreditOne   = std::uint64_t{1} << kCreditShift;
+    static constexpr std::uint64_t kPtrMask     = kCreditOne - 1;
+
+    static constexpr std::uint64_t kBatch           = 1u << 15;  // credits per refill
+    static constexpr std::uint64_t kRefillThreshold = 1u << 14;  // refill below this
+
+public:
+    using value_type = SharedPtr<T, AtomicRefCount>;
+
+    static constexpr bool is_always_lock_free = std::atomic<std::uint64_t>::is_always_lock_free;
+
+    AtomicSharedPtr() noexcept
+        : word_(pack(nullptr, kBatch)) {}
+
+    explicit AtomicSharedPtr(value_type desired) noexcept
+        : word_(publish(std::move(desired))) {}
+
+    AtomicSharedPtr(const AtomicSharedPtr&)            = delete;
+    AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+    ~AtomicSharedPtr() {
+        retire(word_.load(std::memory_order_acquire));
+    }
+
+    // Take a snapshot. Lock-free; one RMW on the shared word in the common case.
+    [[nodiscard]] value_type load() const noexcept {
+        const std::uint64_t old = word_.fetch_sub(kCreditOne, std::memory_order_acquire);
+        Block* block = ptr(old);
+        if (!block) {
+            // Credits on a null word are meaningless; wrap-around stays in the
+            // credit bits and never disturbs the (null) pointer.
+            return value_type{};
+        }
+
+        if (credits(old) - 1 < kRefillThreshold) {
+            refill(block, old - kCreditOne);
+        }
+        return value_type(block);  // adopts the credit we took
+    }
+
+    void store(value_type desired) noexcept {
+        retire(word_.exchange(publish(std::move(desired)), std::memory_order_acq_rel));
+    }
+
+    [[nodiscard]] value_type exchange(value_type desired) noexcept {
+        const std::uint64_t old =
+            word_.exchange(publish(std::move(desired)), std::memory_order_acq_rel);
+        return take_published(old);
+    }
+
+    // Succeeds if the stored pointer equals expected.get(); otherwise loads
+    // the current value into expected. Never fails spuriously.
+    bool compare_exchange_strong(value_type& expected, value_type desired) noexcept {
+        std::uint64_t cur = word_.load(std::memory_order_relaxed);
+        if (ptr(cur) != expected.ctrl_) {
+            expected = load();
+            return false;
+        }
+
+        const std::uint64_t replacement = publish(std::move(desired));
+        while (true) {
+            if (ptr(cur) != expected.ctrl_) {
+                // Lost the race: hand the pre-credited reference back
+                value_type rollback = take_published(replacement);
+                expected = load();
+                return false;
+            }
+            if (word_.compare_exchange_weak(cur, replacement,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                retire(cur);
+                return true;
+            }
+            // Either the pointer changed or only the credits moved; re-check
+        }
+    }
+
+    bool compare_exchange_weak(value_type& expected, value_type desired) noexcept {
+        return compare_exchange_strong(expected, std::move(desired));
+    }
+
+    [[nodiscard]] bool is_lock_free() const noexcept { return word_.is_lock_free(); }
+
+private:
+    static Block* ptr(std::uint64_t word) noexcept {
+        return reinterpret_cast<Block*>(static_cast<std::uintptr_t>(word & kPtrMask));
+    }
+
+    static std::uint64_t credits(std::uint64_t word) noexcept {
+        return word >> kCreditShift;
+    }
+
+    static std::uint64_t pack(Block* block, std::uint64_t credit_count) noexcept {
+        return (credit_count << kCreditShift) |
+               static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(block));
+    }
+
+    // Turn desired's reference into the holder's own reference and pre-credit
+    // a batch of reader references. Returns the word to publish.
+    static std::uint64_t publish(value_type desired) noexcept {
+        Block* block = desired.ctrl_;
+        desired.ctrl_ = nullptr;
+        desired.ptr_  = nullptr;
+
+        if (block) {
+            block->strong_count.add(kBatch);
+        }
+        return pack(block, kBatch);
+    }
+
+    // Undo publish() for a word that is no longer (or never was) visible:
+    // give back unused credits, return the holder's own reference.
+    static value_type take_published(std::uint64_t word) noexcept {
+        Block* block = ptr(word);
+        if (!block) {
+            return value_type{};
+        }
+        // Never reaches zero: the holder's own reference is still counted
+        block->strong_count.subtract(credits(word));
+        return value_type(block);
+    }
+
+    static void retire(std::uint64_t word) noexcept {
+        value_type released = take_published(word);
+    }
+
+    void refill(Block* block, std::uint64_t seen) const noexcept {
+        block->strong_count.add(kBatch);
+
+        std::uint64_t cur = seen;
+        while (ptr(cur) == block && credits(cur) < kRefillThreshold) {
+            // release: readers spending these credits must see the add above
+            if (word_.compare_exchange_weak(cur, cur + kBatch * kCreditOne,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        // Someone else refilled or the block was unpublished. We still hold
+        // the reference taken in load(), so this cannot drop the last one.
+        block->strong_count.subtract(kBatch);
+    }
+
+    mutable std::atomic<std::uint64_t> word_;
+};
+
+} // namespace smart_pointers
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "smart_pointers/ref_count.hpp"
+
+namespace smart_pointers {
+
+/**
+ * Biased reference count (Choi, Shull, Torrellas, PACT 2018).
+ *
+ * Most objects are copied and released almost only by the thread that
+ * created them. The count is biased towards that owner thread:
+ *
+ * DESIGN:
+ * - biased_: references taken on the owner thread. Only the owner writes it,
+ *   with plain relaxed load + store (no RMW), so an owner-side copy costs
+ *   about as much as NonAtomicRefCount.
+ * - shared_: references taken on any other thread, atomic, with two flag
+ *   bits: MERGED (biased_ has been folded in, everyone now uses shared_)
+ *   and QUEUED (the count sits in the owner's merge queue).
+ * - The object's true count is biased_ + shared_. When biased_ reaches zero
+ *   the owner sets MERGED; from then on the count behaves like
+ *   AtomicRefCount and the object dies when shared_ reaches zero.
+ * - A reference created by the owner can be released by another thread,
+ *   driving shared_ negative. That thread cannot read biased_, so it marks
+ *   the count QUEUED and pushes it onto the owner's merge queue. The owner
+ *   folds biased_ into shared_ when it processes the queue, and finishes
+ *   the release if that makes the total zero. Queued counts are never freed
+ *   before the owner has processed them.
+ *
+ * WHEN THE OWNER PROCESSES ITS QUEUE:
+ * - on its next owner-side decrement of any biased count (one extra load of
+ *   its own, rarely written queue head),
+ * - on process_queued() (call it from long-running loops that rarely
+ *   release owner-side references, e.g. a worker's idle path),
+ * - at thread exit. After that the record is marked dead and threads that
+ *   would queue for it merge themselves instead.
+ * Until then, objects released this way stay alive (delayed, never leaked),
+ * and their destructors run on the owner thread.
+ *
+ * The holder of the count (control block, IntrusiveRefCounted) installs a
+ * release handler, which runs when a queue merge finds the count at zero.
+ *
+ * LIMITATIONS:
+ * - An object created with a count of 0 (IntrusiveRefCounted) must take its
+ *   first reference on the creating thread.
+ * - WeakPtr uses weak_count_type (AtomicRefCount): weak traffic is rare.
+ */
+class BiasedRefCount {
+public:
+    using weak_count_type = AtomicRefCount;
+
+    explicit BiasedRefCount(std::size_t initial) noexcept {
+        OwnerRecord* rec = current_record();
+        if (!rec) {
+            // Exiting thread: behave like a plain atomic count
+            shared_.store(static_cast<std::int64_t>(initial) * kOne | kMerged,
+                          std::memory_order_relaxed);
+            return;
+        }
+        rec->refs.fetch_add(1, std::memory_order_relaxed);
+        record_ = rec;
+        owner_.store(rec, std::memory_order_relaxed);
+        biased_.store(static_cast<std::int64_t>(initial), std::memory_order_relaxed);
+    }
+
+    ~BiasedRefCount() {
+        if (record_) {
+            release_record(record_);
+        }
+    }
+
+    BiasedRefCount(const BiasedRefCount&)            = delete;
+    BiasedRefCount& operator=(const BiasedRefCount&) = delete;
+
+    void increment() noexcept {
+        if (is_owner()) {
+            biased_.store(biased_.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+            return;
+        }
+        shared_.fetch_add(kOne, std::memory_order_relaxed);
+    }
+
+    bool try_increment() noexcept {
+        if (is_owner()) {
+            const std::int64_t b = biased_.load(std::memory_order_relaxed);
+            if (b > 0) {
+                biased_.store(b + 1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Unmerged means the owner still holds biased references: alive
+        std::int64_t cur = shared_.load(std::memory_order_relaxed);
+        do {
+            if ((cur & kMerged) && counter(cur) <= 0) return false;
+        } while (!shared_.compare_exchange_weak(cur, cur + kOne,
+                                                std::memory_order_acquire,
+                                                std::memory_order_relaxed));
+        return true;
+    }
+
+    bool decrement() noexcept {
+        if (is_owner()) {
+            const std::int64_t b = biased_.load(std::memory_order_relaxed) - 1;
+            biased_.store(b, std::memory_order_relaxed);
+
+            OwnerRecord* rec = record_;
+            const bool last = b == 0 && merge_owner_released();
+
+            // Settle releases other threads queued for us. A queued *this
+            // may be freed here, so nothing below may touch members.
+            if (rec->queue.load(std::memory_order_relaxed)) {
+                drain(rec);
+            }
+            return last;
+        }
+        return decrement_shared();
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept {
+        const std::int64_t total = biased_.load(std::memory_order_relaxed) +
+                                   counter(shared_.load(std::memory_order_relaxed));
+        return total > 0 ? static_cast<std::size_t>(total) : 0;
+    }
+
+    // fn(context) finishes a release discovered by a queue merge
+    void set_release_handler(void (*fn)(void*), void* context) noexcept {
+        release_fn_  = fn;
+        release_ctx_ = context;
+    }
+
+    // Merge the counts other threads queued for the calling thread.
+    // Returns the number of objects released.
+    static std::size_t process_queued() noexcept {
+        OwnerRecord* rec = tls_record_;
+        return rec ? drain(rec) : 0;
+    }
+
+private:
+    static constexpr std::int64_t kMerged = 1;
+    static constexpr std::int64_t kQueued = 2;
+    static constexpr std::int64_t kOne    = 4;  // counter lives above the flags
+
+    // Per-thread owner identity and merge queue. Outlives the thread while
+    // counts still point at it.
+    struct OwnerRecord {
+        std::atomic<BiasedRefCount*> queue{nullptr};
+        std::atomic<bool>            alive{true};
+        std::atomic<std::size_t>     refs{1};  // the thread + every count it owns
+    };
+
+    struct ThreadOwner {
+        OwnerRecord* record{new OwnerRecord()};
+
+        ThreadOwner() noexcept { tls_record_ = record; }
+
+        ~ThreadOwner() {
+            // From here on this thread takes the shared path like any other
+            tls_record_  = nullptr;
+            tls_exiting_ = true;
+            record->alive.store(false, std::memory_order_seq_cst);
+            drain(record);
+            release_record(record);
+        }
+    };
+
+    static inline thread_local OwnerRecord* tls_record_  = nullptr;
+    static inline thread_local bool         tls_exiting_ = false;
+
+    static OwnerRecord* current_record() {
+        if (tls_record_ || tls_exiting_) return tls_record_;
+        thread_local ThreadOwner owner;
+        return owner.record;
+    }
+
+    static void release_record(OwnerRecord* rec) noexcept {
+        if (rec->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete rec;
+        }
+    }
+
+    static std::int64_t counter(std::int64_t word) noexcept {
+        return word >> 2;  // arithmetic: the counter may be negative
+    }
+
+    bool is_owner() const noexcept {
+        const OwnerRecord* owner = owner_.load(std::memory_order_relaxed);
+        return owner != nullptr && owner == tls_record_;
+    }
+
+    // Owner dropped its last biased reference
+    bool merge_owner_released() noexcept {
+        owner_.store(nullptr, std::memory_order_relaxed);
+        const std::int64_t old = shared_.fetch_or(kMerged, std::memory_order_acq_rel);
+        return counter(old) == 0 && !(old & kQueued);
+    }
+
+    bool decrement_shared() noexcept {
+        std::int64_t old = shared_.load(std::memory_order_relaxed);
+        std::int64_t desired;
+        do {
+            desired = old - kOne;
+            if (!(old & (kMerged | kQueued)) && counter(desired) < 0) {
+                desired |= kQueued;
+            }
+        } while (!shared_.compare_exchange_weak(old, desired,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_relaxed));
+
+        if ((desired & kQueued) && !(old & kQueued)) {
+            enqueue();
+            return false;
+        }
+        return (desired & kMerged) && !(desired & kQueued) && counter(desired) == 0;
+    }
+
+    // Hand this count to its owner for merging
+    void enqueue() noexcept {
+        OwnerRecord* rec = record_;
+        // The owner may free us as soon as we are visible in its queue
+        rec->refs.fetch_add(1, std::memory_order_relaxed);
+
+        BiasedRefCount* head = rec->queue.load(std::memory_order_relaxed);
+        do {
+            queue_next_ = head;
+        } while (!rec->queue.compare_exchange_weak(head, this,
+                                                   std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed));
+
+        // Pairs with ThreadOwner's store + drain: either the owner's drain
+        // sees this entry, or we see the owner is gone and merge ourselves
+        if (!rec->alive.load(std::memory_order_seq_cst)) {
+            drain(rec);
+        }
+        release_record(rec);
+    }
+
+    static std::size_t drain(OwnerRecord* rec) noexcept {
+        std::size_t released = 0;
+        BiasedRefCount* node = rec->queue.exchange(nullptr, std::memory_order_seq_cst);
+        while (node) {
+            BiasedRefCount* next = node->queue_next_;
+            if (node->merge_queued() && node->release_fn_) {
+                node->release_fn_(node->release_ctx_);
+                ++released;
+            }
+            node = next;
+        }
+        return released;
+    }
+
+    // Fold biased_ into shared_ and leave biased mode. Runs on the owner,
+    // or on any thread once the owner has exited (biased_ is then frozen).
+    bool merge_queued() noexcept {
+        const std::int64_t b = biased_.load(std::memory_order_relaxed);
+        biased_.store(0, std::memory_order_relaxed);
+        owner_.store(nullptr, std::memory_order_relaxed);
+
+        std::int64_t old = shared_.load(std::memory_order_relaxed);
+        std::int64_t desired;
+        do {
+            desired = ((old + b * kOne) | kMerged) & ~kQueued;
+        } while (!shared_.compare_exchange_weak(old, desired,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_relaxed));
+        return counter(desired) == 0;
+    }
+
+    std::atomic<OwnerRecord*>   owner_{nullptr};  // record_, or null once merged
+    std::atomic<std::int64_t>   biased_{0};
+    std::atomic<std::int64_t>   shared_{0};
+    OwnerRecord*                record_{nullptr};
+    BiasedRefCount*             queue_next_{nullptr};
+    void                      (*release_fn_)(void*){nullptr};
+    void*                       release_ctx_{nullptr};
+};
+
+} // namespace smart_pointers
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "smart_pointers/ref_count.hpp"
+
+namespace smart_pointers {
+
+/**
+ * Intrusive reference-counted pointer.
+ *
+ * The count lives inside the object (see IntrusiveRefCounted), so an
+ * IntrusivePtr is exactly one pointer, creating one costs no allocation
+ * beyond the object itself, and a new owner can be made from any raw
+ * pointer to a live object, including `this`.
+ *
+ * T must provide add_ref() and release_ref() const member functions;
+ * inheriting from IntrusiveRefCounted<T> supplies both.
+ */
+template <typename T>
+class IntrusivePtr {
+public:
+    using element_type = T;
+
+    constexpr IntrusivePtr() noexcept = default;
+
+    // add_ref = false adopts a reference the caller already holds
+    explicit IntrusivePtr(T* ptr, bool add_ref = true) noexcept
+        : ptr_(ptr) {
+        if (ptr_ && add_ref) {
+            ptr_->add_ref();
+        }
+    }
+
+    // copy
+    IntrusivePtr(const IntrusivePtr& other) noexcept
+        : ptr_(other.ptr_) {
+        if (ptr_) {
+            ptr_->add_ref();
+        }
+    }
+
+    IntrusivePtr& operator=(const IntrusivePtr& other) noexcept {
+        IntrusivePtr(other).swap(*this);
+        return *this;
+    }
+
+    // move
+    IntrusivePtr(IntrusivePtr&& other) noexcept
+        : ptr_(other.ptr_) {
+        other.ptr_ = nullptr;
+    }
+
+    IntrusivePtr& operator=(IntrusivePtr&& other) noexcept {
+        IntrusivePtr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~IntrusivePtr() {
+        if (ptr_) {
+            ptr_->release_ref();
+        }
+    }
+
+    // observers
+    [[nodiscard]] T* get() const noexcept { return ptr_; }
+    [[nodiscard]] T& operator*() const noexcept { return *ptr_; }
+    [[nodiscard]] T* operator->() const noexcept { return ptr_; }
+    [[nodiscard]] explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    // modifiers
+    void reset() noexcept {
+        IntrusivePtr().swap(*this);
+    }
+
+    void reset(T* new_ptr, bool add_ref = true) noexcept {
+        IntrusivePtr(new_ptr, add_ref).swap(*this);
+    }
+
+    // Give up ownership without touching the count
+    [[nodiscard]] T* detach() noexcept {
+        T* tmp = ptr_;
+        ptr_ = nullptr;
+        return tmp;
+    }
+
+    void swap(IntrusivePtr& other) noexcept {
+        using std::swap;
+        swap(ptr_, other.ptr_);
+    }
+
+    friend bool operator==(const IntrusivePtr& a, const IntrusivePtr& b) noexcept {
+        return a.ptr_ == b.ptr_;
+    }
+
+private:
+    T* ptr_{nullptr};
+};
+
+/**
+ * CRTP base that embeds the reference count in Derived.
+ *
+ * RefCount is one of the policies from ref_count.hpp (NonAtomicRefCount by
+ * default, AtomicRefCount when references cross threads) or BiasedRefCount.
+ *
+ * When the last reference goes away Derived::intrusive_dispose(Derived*) is
+ * called; the default deletes the object. Derived may declare its own
+ * public static intrusive_dispose to recycle objects instead (see
+ * PooledRefCounted).
+ */
+template <typename Derived, typename RefCount = NonAtomicRefCount>
+class IntrusiveRefCounted {
+public:
+    void add_ref() const noexcept {
+        ref_count_.increment();
+    }
+
+    void release_ref() const noexcept {
+        if (ref_count_.decrement()) {
+            release_last();
+        }
+    }
+
+    [[nodiscard]] std::size_t ref_count() const noexcept {
+        return ref_count_.count();
+    }
+
+    // New owning pointer to this object. The object must already be owned
+    // by an IntrusivePtr or be about to be (count 0 -> 1 adopts it).
+    [[nodiscard]] IntrusivePtr<Derived> intrusive_from_this() noexcept {
+        return IntrusivePtr<Derived>(static_cast<Derived*>(this));
+    }
+
+protected:
+    IntrusiveRefCounted() noexcept
+        : ref_count_(0) {
+        set_release_handler(ref_count_, &IntrusiveRefCounted::deferred_release, this);
+    }
+
+    // Copies are new objects: they start with no owners
+    IntrusiveRefCounted(const IntrusiveRefCounted&) noexcept
+        : ref_count_(0) {
+        set_release_handler(ref_count_, &IntrusiveRefCounted::deferred_release, this);
+    }
+
+    IntrusiveRefCounted& operator=(const IntrusiveRefCounted&) noexcept {
+        return *this;
+    }
+
+    ~IntrusiveRefCounted() = default;
+
+    static void intrusive_dispose(Derived* ptr) noexcept {
+        delete ptr;
+    }
+
+private:
+    // Last release found by the count itself (BiasedRefCount queue merge)
+    static void deferred_release(void* self) noexcept {
+        static_cast<IntrusiveRefCounted*>(self)->release_last();
+    }
+
+    void release_last() const noexcept {
+        Derived::intrusive_dispose(
+            const_cast<Derived*>(static_cast<const Derived*>(this)));
+    }
+
+    mutable RefCount ref_count_;
+};
+
+/**
+ * IntrusiveRefCounted variant whose objects come from a pool and go back
+ * to it on the last release, e.g. memory_pool::ObjectPool<Derived, N>.
+ * Pool only needs `Derived* allocate(Args...)` and `void deallocate(Derived*)`.
+ *
+ * With AtomicRefCount and ObjectPool, the last release may happen on any
+ * thread: the slot is handed back through the pool's remote-free stack.
+ */
+template <typename Derived, typename Pool, typename RefCount = NonAtomicRefCount>
+class PooledRefCounted : public IntrusiveRefCounted<Derived, RefCount> {
+public:
+    static void intrusive_dispose(Derived* ptr) noexcept {
+        auto* self = static_cast<PooledRefCounted*>(ptr);
+        if (self->owning_pool_) {
+            self->owning_pool_->deallocate(ptr);
+        } else {
+            delete ptr;
+        }
+    }
+
+    [[nodiscard]] Pool* owning_pool() const noexcept { return owning_pool_; }
+
+protected:
+    PooledRefCounted() noexcept = default;
+    PooledRefCounted(const PooledRefCounted&) noexcept
+        : IntrusiveRefCounted<Derived, RefCount>() {}
+    PooledRefCounted& operator=(const PooledRefCounted&) noexcept { return *this; }
+    ~PooledRefCounted() = default;
+
+private:
+    template <typename T, typename P, typename... Args>
+    friend IntrusivePtr<T> allocate_intrusive(P& pool, Args&&... args);
+
+    Pool* owning_pool_{nullptr};
+};
+
+// make_shared analogue: heap-allocate and take the first reference
+template <typename T, typename... Args>
+[[nodiscard]] IntrusivePtr<T> make_intrusive(Args&&... args) {
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+// Take an object from pool; it is returned to pool on the last release.
+// T must derive from PooledRefCounted<T, Pool, ...>.
+template <typename T, typename Pool, typename... Args>
+[[nodiscard]] IntrusivePtr<T> allocate_intrusive(Pool& pool, Args&&... args) {
+    T* obj = pool.allocate(std::forward<Args>(args)...);
+    obj->owning_pool_ = &pool;
+    return IntrusivePtr<T>(obj);
+}
+
+} // namespace smart_pointers
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace smart_pointers {
+
+/**
+ * Reference-count policies for SharedPtr / WeakPtr.
+ *
+ * A policy is a counter type with:
+ *   explicit Policy(std::size_t initial)
+ *   void        increment()     noexcept  // caller already holds a reference
+ *   bool        try_increment() noexcept  // increment unless the count is 0
+ *   bool        decrement()     noexcept  // true if this dropped the last ref
+ *   std::size_t count() const   noexcept  // approximate under concurrency
+ *
+ * Optional members:
+ *   using weak_count_type = ...;             // policy for the weak count
+ *   void set_release_handler(void (*)(void*), void*) noexcept
+ *                                            // for counts that can discover the
+ *                                            // last release outside decrement()
+ */
+
+// Plain integer count. Cheapest option, single-threaded use only.
+class NonAtomicRefCount {
+public:
+    explicit NonAtomicRefCount(std::size_t initial) noexcept
+        : count_(initial) {}
+
+    void increment() noexcept { ++count_; }
+
+    bool try_increment() noexcept {
+        if (count_ == 0) return false;
+        ++count_;
+        return true;
+    }
+
+    bool decrement() noexcept { return --count_ == 0; }
+
+    [[nodiscard]] std::size_t count() const noexcept { return count_; }
+
+private:
+    std::size_t count_;
+};
+
+/**
+ * Thread-safe count.
+ *
+ * MEMORY ORDERING:
+ * - increment: relaxed. A new reference can only be made from an existing
+ *   one, so there is nothing to publish.
+ * - decrement: acq_rel. Release orders this owner's writes to the object
+ *   before the count drop; acquire makes every other owner's writes visible
+ *   to whichever thread ends up destroying the object.
+ * - try_increment: CAS loop so a WeakPtr can never resurrect a count of 0.
+ */
+class AtomicRefCount {
+public:
+    explicit AtomicRefCount(std::size_t initial) noexcept
+        : count_(initial) {}
+
+    void increment() noexcept {
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool try_increment() noexcept {
+        std::size_t cur = count_.load(std::memory_order_relaxed);
+        while (cur != 0) {
+            if (count_.compare_exchange_weak(cur, cur + 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool decrement() noexcept {
+        return count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    // Bulk adjustments, used by AtomicSharedPtr to pre-credit references
+    void add(std::size_t n) noexcept {
+        count_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    bool subtract(std::size_t n) noexcept {
+        return count_.fetch_sub(n, std::memory_order_acq_rel) == n;
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::size_t> count_;
+};
+
+namespace detail {
+
+template <typename RefCount>
+struct weak_count {
+    using type = RefCount;
+};
+
+template <typename RefCount>
+    requires requires { typename RefCount::weak_count_type; }
+struct weak_count<RefCount> {
+    using type = typename RefCount::weak_count_type;
+};
+
+} // namespace detail
+
+// Policy used for the weak count of a block whose strong count is RefCount
+template <typename RefCount>
+using weak_count_t = typename detail::weak_count<RefCount>::type;
+
+// Install handler(context) on counts that support deferred releases
+template <typename RefCount>
+void set_release_handler(RefCount& count, void (*handler)(void*), void* context) noexcept {
+    if constexpr (requires { count.set_release_handler(handler, context); }) {
+        count.set_release_handler(handler, context);
+    }
+}
+
+} // namespace smart_pointers
@@ -1,28 +1,112 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <new>
 #include <utility>
 
+#include "smart_pointers/ref_count.hpp"
+
 namespace smart_pointers {
 
-// Simple non-thread-safe control block
-template <typename T>
-struct ControlBlock {
-    T*        ptr;
-    std::size_t strong_count;
-    std::size_t weak_count;
+// Control block interface; thread safety is decided by the RefCount policy.
+// weak_count starts at 1: all strong owners together hold one weak
+// reference, dropped after the object is destroyed. This keeps the block
+// alive until the last strong release has finished touching it.
+template <typename T, typename RefCount = NonAtomicRefCount>
+struct ControlBlockBase {
+    T*                     ptr;
+    RefCount               strong_count;
+    weak_count_t<RefCount> weak_count;
+
+    explicit ControlBlockBase(T* p)
+        : ptr(p), strong_count(1), weak_count(1) {
+        set_release_handler(strong_count, &ControlBlockBase::deferred_release, this);
+    }
+
+    virtual void dispose() noexcept = 0;  // destroy the managed object
+    virtual void destroy() noexcept = 0;  // free the control block itself
+
+    // After the strong count hit zero: destroy the object, then drop the
+    // weak reference held on behalf of all strong owners.
+    void release_last_strong() noexcept {
+        dispose();
+        if (weak_count.decrement()) {
+            destroy();
+        }
+    }
 
+protected:
+    ~ControlBlockBase() = default;
+
+private:
+    // Last release found by the count itself (BiasedRefCount queue merge)
+    static void deferred_release(void* self) noexcept {
+        static_cast<ControlBlockBase*>(self)->release_last_strong();
+    }
+};
+
+// Block for SharedPtr(T*): object and counts live in separate allocations.
+template <typename T, typename RefCount = NonAtomicRefCount>
+struct ControlBlock final : ControlBlockBase<T, RefCount> {
     explicit ControlBlock(T* p)
-        : ptr(p), strong_count(1), weak_count(0) {}
+        : ControlBlockBase<T, RefCount>(p) {}
+
+    void dispose() noexcept override { delete this->ptr; }
+    void destroy() noexcept override { delete this; }
 };
 
-template <typename T> class SharedPtr;
-template <typename T> class WeakPtr;
+// Block for make_shared / allocate_shared: the object is constructed inside
+// the block, so one allocation holds both and the counts share its cache
+// lines. Memory comes from Alloc (rebound to the block type).
+template <typename T, typename RefCount, typename Alloc>
+class InplaceControlBlock final : public ControlBlockBase<T, RefCount> {
+public:
+    using allocator_type =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<InplaceControlBlock>;
+
+    // May throw whatever T's constructor throws; the caller owns the memory.
+    template <typename... Args>
+    explicit InplaceControlBlock(const Alloc& alloc, Args&&... args)
+        : ControlBlockBase<T, RefCount>(nullptr), alloc_(alloc) {
+        this->ptr = ::new (static_cast<void*>(&storage_)) T(std::forward<Args>(args)...);
+    }
+
+    void dispose() noexcept override { std::destroy_at(this->ptr); }
 
-template <typename T>
+    void destroy() noexcept override {
+        allocator_type alloc(std::move(alloc_));
+        this->~InplaceControlBlock();
+        std::allocator_traits<allocator_type>::deallocate(alloc, this, 1);
+    }
+
+private:
+    allocator_type alloc_;
+    alignas(T) std::byte storage_[sizeof(T)];
+};
+
+template <typename T, typename RefCount = NonAtomicRefCount> class SharedPtr;
+template <typename T, typename RefCount = NonAtomicRefCount> class WeakPtr;
+template <typename T> class AtomicSharedPtr;
+
+template <typename T, typename RefCount = NonAtomicRefCount,
+          typename Alloc, typename... Args>
+[[nodiscard]] SharedPtr<T, RefCount> allocate_shared(const Alloc& alloc, Args&&... args);
+
+/**
+ * Reference-counted owning pointer.
+ *
+ * RefCount selects the counting policy:
+ * - NonAtomicRefCount (default): plain integers, single-threaded only
+ * - AtomicRefCount: copies and releases may race across threads
+ * - BiasedRefCount: thread-safe, but copies on the creating thread are
+ *   nearly as cheap as NonAtomicRefCount (biased_ref_count.hpp)
+ */
+template <typename T, typename RefCount>
 class SharedPtr {
 public:
     using element_type = T;
+    using ref_count_type = RefCount;
 
     // ctors
     constexpr SharedPtr() noexcept = default;
@@ -30,7 +114,12 @@ public:
     explicit SharedPtr(T* ptr)
         : ctrl_(nullptr), ptr_(ptr) {
         if (ptr_) {
-            ctrl_ = new ControlBlock<T>(ptr_);
+            try {
+                ctrl_ = new ControlBlock<T, RefCount>(ptr_);
+            } catch (...) {
+                delete ptr_;
+                throw;
+            }
         }
     }
 
@@ -77,7 +166,7 @@ public:
     [[nodiscard]] explicit operator bool() const noexcept { return ptr_ != nullptr; }
 
     [[nodiscard]] std::size_t use_count() const noexcept {
-        return ctrl_ ? ctrl_->strong_count : 0;
+        return ctrl_ ? ctrl_->strong_count.count() : 0;
     }
 
     // modifiers
@@ -88,7 +177,7 @@ public:
     void reset(T* new_ptr) {
         release();
         if (new_ptr) {
-            ctrl_ = new ControlBlock<T>(new_ptr);
+            ctrl_ = new ControlBlock<T, RefCount>(new_ptr);
             ptr_  = new_ptr;
         }
     }
@@ -100,47 +189,43 @@ public:
     }
 
 private:
-    friend class WeakPtr<T>;
+    friend class WeakPtr<T, RefCount>;
+    friend class AtomicSharedPtr<T>;
 
-    explicit SharedPtr(ControlBlock<T>* ctrl) noexcept
-        : ctrl_(ctrl), ptr_(ctrl ? ctrl->ptr : nullptr) {
-        inc_strong();
-    }
+    template <typename U, typename RC, typename Alloc, typename... Args>
+    friend SharedPtr<U, RC> allocate_shared(const Alloc& alloc, Args&&... args);
+
+    // Adopts a strong reference the caller has already taken on ctrl.
+    explicit SharedPtr(ControlBlockBase<T, RefCount>* ctrl) noexcept
+        : ctrl_(ctrl), ptr_(ctrl ? ctrl->ptr : nullptr) {}
 
     void inc_strong() noexcept {
         if (ctrl_) {
-            ++ctrl_->strong_count;
+            ctrl_->strong_count.increment();
         }
     }
 
     void release() noexcept {
         if (!ctrl_) return;
 
-        if (--ctrl_->strong_count == 0) {
-            // destroy managed object
-            delete ctrl_->ptr;
-            ctrl_->ptr = nullptr;
-
-            // if no weak refs either, delete control block
-            if (ctrl_->weak_count == 0) {
-                delete ctrl_;
-            }
+        if (ctrl_->strong_count.decrement()) {
+            ctrl_->release_last_strong();
         }
 
         ctrl_ = nullptr;
         ptr_  = nullptr;
     }
 
-    ControlBlock<T>* ctrl_{nullptr};
-    T*               ptr_{nullptr};
+    ControlBlockBase<T, RefCount>* ctrl_{nullptr};
+    T*                             ptr_{nullptr};
 };
 
-template <typename T>
+template <typename T, typename RefCount>
 class WeakPtr {
 public:
     constexpr WeakPtr() noexcept = default;
 
-    WeakPtr(const SharedPtr<T>& sp) noexcept
+    WeakPtr(const SharedPtr<T, RefCount>& sp) noexcept
         : ctrl_(sp.ctrl_) {
         inc_weak();
     }
@@ -180,45 +265,65 @@ public:
     }
 
     [[nodiscard]] bool expired() const noexcept {
-        return !ctrl_ || ctrl_->strong_count == 0;
+        return !ctrl_ || ctrl_->strong_count.count() == 0;
     }
 
     [[nodiscard]] std::size_t use_count() const noexcept {
-        return ctrl_ ? ctrl_->strong_count : 0;
+        return ctrl_ ? ctrl_->strong_count.count() : 0;
     }
 
-    // Try to obtain a SharedPtr; returns empty if expired
-    [[nodiscard]] SharedPtr<T> lock() const noexcept {
-        if (expired()) {
-            return SharedPtr<T>{};
+    // Try to obtain a SharedPtr; returns empty if expired.
+    // try_increment makes this safe against a concurrent last release.
+    [[nodiscard]] SharedPtr<T, RefCount> lock() const noexcept {
+        if (!ctrl_ || !ctrl_->strong_count.try_increment()) {
+            return SharedPtr<T, RefCount>{};
         }
-        return SharedPtr<T>(ctrl_);
+        return SharedPtr<T, RefCount>(ctrl_);
     }
 
 private:
     void inc_weak() noexcept {
         if (ctrl_) {
-            ++ctrl_->weak_count;
+            ctrl_->weak_count.increment();
         }
     }
 
     void release() noexcept {
         if (!ctrl_) return;
 
-        if (--ctrl_->weak_count == 0 && ctrl_->strong_count == 0) {
-            delete ctrl_;
+        if (ctrl_->weak_count.decrement()) {
+            ctrl_->destroy();
         }
         ctrl_ = nullptr;
     }
 
-    ControlBlock<T>* ctrl_{nullptr};
+    ControlBlockBase<T, RefCount>* ctrl_{nullptr};
 };
 
-// make_shared equivalent
-template <typename T, typename... Args>
-[[nodiscard]] SharedPtr<T> make_shared(Args&&... args) {
-    T* raw = new T(std::forward<Args>(args)...);
-    return SharedPtr<T>(raw);
+// Single allocation for control block + object, obtained from alloc
+// (e.g. memory_pool::PoolAllocator). The block outlives the object while
+// WeakPtrs remain, so the memory is returned on the last weak release.
+template <typename T, typename RefCount, typename Alloc, typename... Args>
+[[nodiscard]] SharedPtr<T, RefCount> allocate_shared(const Alloc& alloc, Args&&... args) {
+    using Block  = InplaceControlBlock<T, RefCount, Alloc>;
+    using Traits = std::allocator_traits<typename Block::allocator_type>;
+
+    typename Block::allocator_type block_alloc(alloc);
+    Block* block = Traits::allocate(block_alloc, 1);
+    try {
+        ::new (static_cast<void*>(block)) Block(alloc, std::forward<Args>(args)...);
+    } catch (...) {
+        Traits::deallocate(block_alloc, block, 1);
+        throw;
+    }
+    return SharedPtr<T, RefCount>(block);
+}
+
+// make_shared equivalent; make_shared<T, AtomicRefCount>(...) for the
+// thread-safe policy. One heap allocation per object.
+template <typename T, typename RefCount = NonAtomicRefCount, typename... Args>
+[[nodiscard]] SharedPtr<T, RefCount> make_shared(Args&&... args) {
+    return allocate_shared<T, RefCount>(std::allocator<T>{}, std::forward<Args>(args)...);
 }
 
 } // namespace smart_pointers
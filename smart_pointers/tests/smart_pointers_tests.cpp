@@ -1,8 +1,16 @@
 #include "smart_pointers/unique_ptr.hpp"
 #include "smart_pointers/shared_ptr.hpp"
+#include "smart_pointers/intrusive_ptr.hpp"
+#include "smart_pointers/atomic_shared_ptr.hpp"
+#include "smart_pointers/biased_ref_count.hpp"
+#include "memory_pool/object_pool.hpp"
+#include "memory_pool/pool_allocator.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace smart_pointers;
 
@@ -97,6 +105,446 @@ static void test_weak_ptr_lock() {
     assert(!locked2);
 }
 
+static void test_atomic_shared_ptr_concurrent_copies() {
+    std::atomic<int> destroyed{0};
+
+    struct Counted {
+        std::atomic<int>* destroyed;
+        ~Counted() { destroyed->fetch_add(1); }
+    };
+
+    {
+        auto sp = make_shared<Counted, AtomicRefCount>(Counted{&destroyed});
+        destroyed.store(0);  // ignore the temporary passed to make_shared
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([sp] {
+                for (int i = 0; i < 10000; ++i) {
+                    SharedPtr<Counted, AtomicRefCount> copy = sp;
+                    assert(copy.use_count() >= 2);
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        assert(sp.use_count() == 1);
+        assert(destroyed.load() == 0);
+    }
+
+    assert(destroyed.load() == 1);
+}
+
+static void test_atomic_weak_ptr_lock_races_release() {
+    for (int round = 0; round < 200; ++round) {
+        bool destroyed = false;
+        auto sp = make_shared<TestObj, AtomicRefCount>(round, &destroyed);
+        WeakPtr<TestObj, AtomicRefCount> wp(sp);
+
+        std::thread locker([wp] {
+            while (auto locked = wp.lock()) {
+                // Object must stay alive while we hold a lock()ed reference
+                assert(locked->value >= 0);
+            }
+        });
+
+        sp.reset();
+        locker.join();
+
+        assert(destroyed);
+        assert(wp.expired());
+    }
+}
+
+// Allocator that counts live allocations made through it
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    int* live;
+
+    explicit CountingAllocator(int* l) noexcept : live(l) {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept : live(other.live) {}
+
+    T* allocate(std::size_t n) {
+        ++*live;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        --*live;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+};
+
+static void test_allocate_shared_single_allocation() {
+    int  live      = 0;
+    bool destroyed = false;
+
+    WeakPtr<TestObj> wp;
+    {
+        auto sp = allocate_shared<TestObj>(CountingAllocator<TestObj>(&live), 50, &destroyed);
+        assert(live == 1);  // object and counts share one allocation
+        assert(sp->value == 50);
+
+        wp = WeakPtr<TestObj>(sp);
+    }
+
+    // Object destroyed, but the block stays until the last WeakPtr goes
+    assert(destroyed);
+    assert(wp.expired());
+    assert(!wp.lock());
+    assert(live == 1);
+
+    wp.reset();
+    assert(live == 0);
+}
+
+static void test_allocate_shared_from_memory_pool() {
+    using memory_pool::FixedBlockMemoryPool;
+    using memory_pool::PoolAllocator;
+
+    FixedBlockMemoryPool pool(128, 2);
+    PoolAllocator<TestObj> alloc(pool);
+
+    bool d1 = false;
+    bool d2 = false;
+    {
+        auto a = allocate_shared<TestObj>(alloc, 1, &d1);
+        auto b = allocate_shared<TestObj>(alloc, 2, &d2);
+        assert(a->value == 1 && b->value == 2);
+
+        // Pool exhausted: two blocks, two objects
+        bool threw = false;
+        try {
+            auto c = allocate_shared<TestObj>(alloc, 3, nullptr);
+        } catch (const std::bad_alloc&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    assert(d1 && d2);
+
+    // Both blocks went back to the pool
+    auto again = allocate_shared<TestObj, AtomicRefCount>(alloc, 4, nullptr);
+    assert(again.use_count() == 1);
+}
+
+struct Node : IntrusiveRefCounted<Node> {
+    int   value;
+    bool* destroyed;
+
+    Node(int v, bool* d) : value(v), destroyed(d) {}
+    ~Node() { if (destroyed) *destroyed = true; }
+
+    IntrusivePtr<Node> self() { return intrusive_from_this(); }
+};
+
+static void test_intrusive_ptr_basic() {
+    static_assert(sizeof(IntrusivePtr<Node>) == sizeof(Node*));
+
+    bool destroyed = false;
+    {
+        auto p = make_intrusive<Node>(60, &destroyed);
+        assert(p->ref_count() == 1);
+
+        IntrusivePtr<Node> q = p;
+        assert(p->ref_count() == 2);
+        assert(q == p);
+
+        // Rebuilding from a raw pointer (or this) shares the same count
+        IntrusivePtr<Node> from_raw(p.get());
+        IntrusivePtr<Node> from_this = p->self();
+        assert(p->ref_count() == 4);
+
+        IntrusivePtr<Node> moved = std::move(q);
+        assert(!q);
+        assert(p->ref_count() == 4);
+    }
+    assert(destroyed);
+}
+
+static void test_intrusive_ptr_detach_adopt() {
+    bool destroyed = false;
+
+    auto p = make_intrusive<Node>(70, &destroyed);
+    Node* raw = p.detach();
+    assert(!p);
+    assert(raw->ref_count() == 1 && !destroyed);
+
+    IntrusivePtr<Node> adopted(raw, /*add_ref=*/false);
+    assert(adopted->ref_count() == 1);
+
+    adopted.reset();
+    assert(destroyed);
+}
+
+struct PooledPayload;
+using PayloadPool = memory_pool::ObjectPool<PooledPayload, 4>;
+
+struct PooledPayload : PooledRefCounted<PooledPayload, PayloadPool, AtomicRefCount> {
+    int value;
+    explicit PooledPayload(int v) : value(v) {}
+};
+
+static void test_intrusive_ptr_returns_to_pool() {
+    PayloadPool pool;
+
+    {
+        auto a = allocate_intrusive<PooledPayload>(pool, 1);
+        auto b = allocate_intrusive<PooledPayload>(pool, 2);
+        assert(pool.free_slots() == 2);
+        assert(a->owning_pool() == &pool);
+
+        auto a2 = a;
+        a.reset();
+        assert(pool.free_slots() == 2);  // a2 still holds it
+    }
+    assert(pool.free_slots() == 4);
+
+    // Last release on another thread goes back via the remote-free stack
+    auto c = allocate_intrusive<PooledPayload>(pool, 3);
+    std::thread consumer([c = std::move(c)]() mutable {
+        assert(c->value == 3);
+        c.reset();
+    });
+    consumer.join();
+
+    assert(pool.free_slots() == 3);
+    assert(pool.reclaim_remote_frees() == 1);
+    assert(pool.free_slots() == 4);
+}
+
+static void test_atomic_shared_ptr_basic_ops() {
+    using Ptr = SharedPtr<int, AtomicRefCount>;
+
+    AtomicSharedPtr<int> slot;
+    assert(!slot.load());
+    assert(slot.is_lock_free());
+
+    auto one = make_shared<int, AtomicRefCount>(1);
+    slot.store(one);
+    assert(slot.load().get() == one.get());
+
+    auto two = make_shared<int, AtomicRefCount>(2);
+    Ptr prev = slot.exchange(two);
+    assert(prev.get() == one.get());
+    assert(*slot.load() == 2);
+
+    // CAS fails against a stale expected and reports the current value
+    Ptr expected = one;
+    assert(!slot.compare_exchange_strong(expected, make_shared<int, AtomicRefCount>(3)));
+    assert(expected.get() == two.get());
+
+    // ...and succeeds once expected is current
+    assert(slot.compare_exchange_strong(expected, make_shared<int, AtomicRefCount>(4)));
+    assert(*slot.load() == 4);
+
+    // Null round trip
+    slot.store(Ptr{});
+    assert(!slot.load());
+    Ptr null_expected;
+    assert(slot.compare_exchange_strong(null_expected, one));
+    assert(slot.load().get() == one.get());
+}
+
+static void test_atomic_shared_ptr_refill_and_release() {
+    bool destroyed = false;
+    {
+        AtomicSharedPtr<TestObj> slot(make_shared<TestObj, AtomicRefCount>(80, &destroyed));
+
+        // Hold enough snapshots to exhaust several credit batches
+        std::vector<SharedPtr<TestObj, AtomicRefCount>> held;
+        for (int i = 0; i < 100000; ++i) {
+            held.push_back(slot.load());
+        }
+        assert(held.back()->value == 80);
+
+        held.clear();
+        assert(!destroyed);
+
+        // Once unpublished, the count is exact again
+        auto last = slot.exchange({});
+        assert(last.use_count() == 1);
+    }
+    assert(destroyed);
+}
+
+static void test_atomic_shared_ptr_one_writer_many_readers() {
+    struct Snapshot {
+        int version;
+        int checksum;  // always version * 7
+        std::atomic<int>* live;
+
+        Snapshot(int v, std::atomic<int>* l) : version(v), checksum(v * 7), live(l) {
+            live->fetch_add(1);
+        }
+        ~Snapshot() { live->fetch_sub(1); }
+    };
+
+    std::atomic<int> live{0};
+    {
+        AtomicSharedPtr<Snapshot> current(make_shared<Snapshot, AtomicRefCount>(0, &live));
+        std::atomic<bool> stop{false};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&] {
+                int last_seen = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto snap = current.load();
+                    assert(snap);
+                    assert(snap->checksum == snap->version * 7);
+                    assert(snap->version >= last_seen);  // single writer: monotonic
+                    last_seen = snap->version;
+                }
+            });
+        }
+
+        for (int v = 1; v <= 20000; ++v) {
+            current.store(make_shared<Snapshot, AtomicRefCount>(v, &live));
+        }
+        stop.store(true);
+        for (auto& t : readers) {
+            t.join();
+        }
+        assert(current.load()->version == 20000);
+    }
+    assert(live.load() == 0);
+}
+
+using BiasedPtr = SharedPtr<TestObj, BiasedRefCount>;
+
+static void test_biased_owner_thread_only() {
+    bool destroyed = false;
+    {
+        auto sp = make_shared<TestObj, BiasedRefCount>(1, &destroyed);
+        {
+            BiasedPtr a = sp;
+            BiasedPtr b = a;
+            assert(sp.use_count() == 3);
+        }
+        assert(sp.use_count() == 1);
+
+        WeakPtr<TestObj, BiasedRefCount> wp(sp);
+        assert(wp.lock()->value == 1);
+        assert(!destroyed);
+    }
+    assert(destroyed);
+}
+
+static void test_biased_cross_thread_copies() {
+    std::atomic<int> destroyed{0};
+
+    struct Counted {
+        std::atomic<int>* destroyed;
+        ~Counted() { destroyed->fetch_add(1); }
+    };
+
+    {
+        auto sp = make_shared<Counted, BiasedRefCount>(Counted{&destroyed});
+        destroyed.store(0);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([sp] {
+                for (int i = 0; i < 10000; ++i) {
+                    SharedPtr<Counted, BiasedRefCount> copy = sp;
+                    assert(copy.use_count() >= 2);
+                }
+            });
+        }
+        // Owner-side copies race with the shared-side ones
+        for (int i = 0; i < 10000; ++i) {
+            SharedPtr<Counted, BiasedRefCount> copy = sp;
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        assert(sp.use_count() == 1);
+        assert(destroyed.load() == 0);
+    }
+
+    assert(destroyed.load() == 1);
+}
+
+static void test_biased_last_release_on_other_thread() {
+    bool destroyed = false;
+    {
+        auto sp = make_shared<TestObj, BiasedRefCount>(2, &destroyed);
+        BiasedPtr copy = sp;  // counted on the owner side
+
+        std::thread consumer([c = std::move(copy)]() mutable {
+            assert(c->value == 2);
+            c.reset();  // drives the shared count negative: queued for the owner
+        });
+        consumer.join();
+        assert(!destroyed);
+    }
+
+    // The owner merged its biased count when it reached zero
+    assert(destroyed);
+
+    // Same, but the owner still holds biased references when the queue is
+    // processed
+    destroyed = false;
+    auto sp = make_shared<TestObj, BiasedRefCount>(3, &destroyed);
+    BiasedPtr keep = sp;
+
+    std::thread consumer([c = std::move(sp)]() mutable { c.reset(); });
+    consumer.join();
+
+    BiasedRefCount::process_queued();
+    assert(!destroyed);
+    assert(keep.use_count() == 1);
+
+    // Merged: the count now lives entirely on the shared side
+    std::thread last([k = std::move(keep)]() mutable { k.reset(); });
+    last.join();
+    assert(destroyed);
+}
+
+static void test_biased_owner_exits_first() {
+    bool destroyed = false;
+    BiasedPtr handed_over;
+
+    std::thread producer([&] {
+        auto sp = make_shared<TestObj, BiasedRefCount>(4, &destroyed);
+        handed_over = sp;  // owner-side reference that outlives the owner
+    });
+    producer.join();
+
+    assert(!destroyed);
+    assert(handed_over->value == 4);
+
+    // Owner is gone: the releasing thread merges on its behalf
+    handed_over.reset();
+    assert(destroyed);
+}
+
+struct BiasedNode : IntrusiveRefCounted<BiasedNode, BiasedRefCount> {
+    inline static std::atomic<int> destroyed{0};
+    ~BiasedNode() { destroyed.fetch_add(1); }
+};
+
+static void test_biased_intrusive_ptr() {
+    BiasedNode::destroyed.store(0);
+
+    auto node = make_intrusive<BiasedNode>();
+    IntrusivePtr<BiasedNode> copy = node;
+
+    std::thread consumer([c = std::move(copy)]() mutable { c.reset(); });
+    consumer.join();
+
+    node.reset();  // owner count reaches zero and settles the queued release
+    assert(BiasedNode::destroyed.load() == 1);
+}
+
 int main() {
     std::cout << "Running smart_pointers tests...\n";
 
@@ -104,6 +552,21 @@ int main() {
     test_unique_ptr_release_reset();
     test_shared_ptr_basic();
     test_weak_ptr_lock();
+    test_atomic_shared_ptr_concurrent_copies();
+    test_atomic_weak_ptr_lock_races_release();
+    test_allocate_shared_single_allocation();
+    test_allocate_shared_from_memory_pool();
+    test_intrusive_ptr_basic();
+    test_intrusive_ptr_detach_adopt();
+    test_intrusive_ptr_returns_to_pool();
+    test_atomic_shared_ptr_basic_ops();
+    test_atomic_shared_ptr_refill_and_release();
+    test_atomic_shared_ptr_one_writer_many_readers();
+    test_biased_owner_thread_only();
+    test_biased_cross_thread_copies();
+    test_biased_last_release_on_other_thread();
+    test_biased_owner_exits_first();
+    test_biased_intrusive_ptr();
 
     std::cout << "All smart_pointers tests passed.\n";
     return 0;
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace thread_pool {
+
+/**
+ * Process-wide recycling allocator for the pool's small, short-lived
+ * objects: task nodes and future shared states.
+ *
+ * DESIGN:
+ * - Four size classes (64, 128, 256, 512 bytes), all blocks 64-byte aligned;
+ *   larger requests go straight to operator new
+ * - Each thread keeps a free list per class. allocate/deallocate touch only
+ *   that list, so the common case is a vector push/pop with no lock
+ * - A task is often allocated on one thread (the submitter) and freed on
+ *   another (the worker). To keep memory circulating, a thread whose list
+ *   reaches kLocalCapacity moves kBatch blocks to a global free list; a
+ *   thread whose list is empty takes up to kBatch from it before falling
+ *   back to operator new. The global list is mutex-protected but touched
+ *   once per kBatch blocks.
+ * - A thread's cached blocks go back to the global list when it exits
+ *
+ * LIMITATIONS:
+ * - Memory is never returned to the system before process exit: the pool
+ *   holds on to the high-water mark of live blocks
+ *
+ * THREAD SAFETY:
+ * - allocate/deallocate: any thread; a block may be freed by a different
+ *   thread than the one that allocated it
+ */
+class BlockPool {
+public:
+    static constexpr std::size_t kBlockAlign    = 64;
+    static constexpr std::size_t kMaxBlockSize  = 512;
+    static constexpr std::size_t kLocalCapacity = 64;  // per thread, per class
+    static constexpr std::size_t kBatch         = 32;  // moved to/from the global list
+
+    static void* allocate(std::size_t bytes) {
+        if (bytes > kMaxBlockSize) {
+            return ::operator new(bytes, std::align_val_t{kBlockAlign});
+        }
+        const std::size_t cls = size_class(bytes);
+
+        if (!tls_exited_) {
+            std::vector<void*>& list = local().free[cls];
+            if (list.empty()) {
+                global().take(cls, list);
+            }
+            if (!list.empty()) {
+                void* block = list.back();
+                list.pop_back();
+                return block;
+            }
+        }
+        return ::operator new(class_size(cls), std::align_val_t{kBlockAlign});
+    }
+
+    // bytes must match the allocate() call
+    static void deallocate(void* block, std::size_t bytes) noexcept {
+        if (bytes > kMaxBlockSize) {
+            ::operator delete(block, std::align_val_t{kBlockAlign});
+            return;
+        }
+        const std::size_t cls = size_class(bytes);
+
+        if (tls_exited_) {
+            // Thread-local cache already gone (thread_local destructors)
+            global().put(cls, block);
+            return;
+        }
+        std::vector<void*>& list = local().free[cls];
+        if (list.size() >= kLocalCapacity) {
+            global().give(cls, list, kBatch);
+        }
+        list.push_back(block);  // capacity reserved: never allocates
+    }
+
+private:
+    static constexpr std::size_t kClasses = 4;
+
+    static constexpr std::size_t size_class(std::size_t bytes) noexcept {
+        return bytes <= 64 ? 0 : bytes <= 128 ? 1 : bytes <= 256 ? 2 : 3;
+    }
+
+    static constexpr std::size_t class_size(std::size_t cls) noexcept {
+        return std::size_t{64} << cls;
+    }
+
+    static void free_block(void* block) noexcept {
+        ::operator delete(block, std::align_val_t{kBlockAlign});
+    }
+
+    struct Global {
+        ~Global() {
+            for (auto& list : free) {
+                std::for_each(list.begin(), list.end(), free_block);
+            }
+        }
+
+        // Refill an empty thread list with up to kBatch blocks
+        void take(std::size_t cls, std::vector<void*>& out) {
+            std::lock_guard<std::mutex> lk(mutex);
+            std::vector<void*>& list = free[cls];
+            const std::size_t   n    = std::min(kBatch, list.size());
+            out.insert(out.end(), list.end() - static_cast<std::ptrdiff_t>(n), list.end());
+            list.resize(list.size() - n);
+        }
+
+        // Move the last n blocks of a thread list here
+        void give(std::size_t cls, std::vector<void*>& from, std::size_t n) noexcept {
+            std::lock_guard<std::mutex> lk(mutex);
+            std::vector<void*>& list = free[cls];
+            try {
+                list.insert(list.end(), from.end() - static_cast<std::ptrdiff_t>(n), from.end());
+            } catch (...) {
+                std::for_each(from.end() - static_cast<std::ptrdiff_t>(n), from.end(), free_block);
+            }
+            from.resize(from.size() - n);
+        }
+
+        void put(std::size_t cls, void* block) noexcept {
+            std::lock_guard<std::mutex> lk(mutex);
+            try {
+                free[cls].push_back(block);
+            } catch (...) {
+                free_block(block);
+            }
+        }
+
+        std::mutex                                 mutex;
+        std::array<std::vector<void*>, kClasses>   free;
+    };
+
+    struct Local {
+        Local() {
+            global();  // constructed first, so destroyed after every Local
+            for (auto& list : free) {
+                list.reserve(kLocalCapacity + 1);
+            }
+        }
+
+        ~Local() {
+            for (std::size_t cls = 0; cls < kClasses; ++cls) {
+                if (!free[cls].empty()) {
+                    global().give(cls, free[cls], free[cls].size());
+                }
+            }
+            tls_exited_ = true;
+        }
+
+        std::array<std::vector<void*>, kClasses> free;
+    };
+
+    static Global& global() {
+        static Global instance;
+        return instance;
+    }
+
+    static Local& local() {
+        thread_local Local instance;
+        return instance;
+    }
+
+    static inline thread_local bool tls_exited_ = false;
+};
+
+/**
+ * Standard allocator over BlockPool (stateless: all instances are equal).
+ * Used for std::promise shared states, see WorkStealingThreadPool::submit.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        static_assert(alignof(T) <= BlockPool::kBlockAlign,
+                      "PoolAllocator does not support over-aligned types");
+        return static_cast<T*>(BlockPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        BlockPool::deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    friend bool operator==(const PoolAllocator&, const PoolAllocator<U>&) noexcept {
+        return true;
+    }
+};
+
+} // namespace thread_pool
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace thread_pool {
+
+/**
+ * Lock-free work-stealing deque (Chase & Lev, SPAA 2005), with the C11
+ * memory orderings of Lê, Pop, Cohen & Zappa Nardelli (PPoPP 2013).
+ *
+ * DESIGN:
+ * - One owner thread pushes and pops at the bottom (LIFO); any number of
+ *   thieves steal from the top (FIFO)
+ * - top_ / bottom_ are free-running 64-bit indices into a circular array;
+ *   the array doubles when full (old arrays are kept until the deque dies,
+ *   since a thief may still be reading one)
+ * - push: plain stores (the last one release), no RMW
+ * - pop: a seq_cst fence, no RMW, except a CAS on top_ when racing thieves
+ *   for the last element
+ * - steal: one CAS on top_
+ *
+ * MEMORY ORDERING:
+ * - push: write slot, store bottom (release; the paper's release fence
+ *   folded into the store, which also lets ThreadSanitizer follow it)
+ * - pop: store bottom - 1, seq_cst fence, load top; the fence pairs with
+ *   the one in steal so owner and thief cannot both take the last element
+ * - steal: load top (acquire), seq_cst fence, load bottom (acquire), read
+ *   slot, CAS top. A thief that loses the CAS discards what it read.
+ *
+ * LIMITATIONS:
+ * - T must be trivially copyable and lock-free as std::atomic<T> (use a
+ *   pointer to the real work item): thieves read slots speculatively
+ * - The array only grows
+ *
+ * THREAD SAFETY:
+ * - push/pop: owner thread only. steal/size/empty: any thread.
+ */
+template <typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "ChaseLevDeque holds trivially copyable items");
+    static_assert(std::atomic<T>::is_always_lock_free, "ChaseLevDeque items must be lock-free");
+
+    struct Array {
+        explicit Array(std::int64_t cap)
+            : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[static_cast<std::size_t>(cap)]) {}
+
+        T get(std::int64_t i) const noexcept {
+            return slots[static_cast<std::size_t>(i & mask)].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t i, T item) noexcept {
+            slots[static_cast<std::size_t>(i & mask)].store(item, std::memory_order_relaxed);
+        }
+
+        const std::int64_t                capacity;
+        const std::int64_t                mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+public:
+    static constexpr std::size_t kDefaultCapacity = 256;
+
+    // initial_capacity is rounded up to a power of two
+    explicit ChaseLevDeque(std::size_t initial_capacity = kDefaultCapacity) {
+        std::int64_t cap = 2;
+        while (static_cast<std::size_t>(cap) < initial_capacity) {
+            cap <<= 1;
+        }
+        arrays_.push_back(std::make_unique<Array>(cap));
+        array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&)            = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Owner only. Grows the array when full; throws std::bad_alloc only if
+    // that allocation fails, leaving the deque unchanged.
+    void push(T item) {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t t = top_.load(std::memory_order_acquire);
+        Array* a = array_.load(std::memory_order_relaxed);
+
+        if (b - t > a->capacity - 1) {
+            a = grow(a, t, b);
+        }
+        a->put(b, item);
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    // Owner only. Takes the most recently pushed item. Returns false if empty
+    // (or a thief won the race for the last item).
+    bool pop(T& out) noexcept {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Empty: restore
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = a->get(b);
+        if (t == b) {
+            // Last item: race thieves for it
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread. Takes the oldest item. Returns false if empty or if
+    // another thread took it first (callers usually move on to another
+    // victim rather than retry).
+    bool steal(T& out) noexcept {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return false;
+        }
+
+        // Acquire pairs with the release store in grow(): a new array is
+        // fully copied before a thief can see it
+        Array* a = array_.load(std::memory_order_acquire);
+        const T item = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return false;
+        }
+        out = item;
+        return true;
+    }
+
+    // Approximate under concurrency
+    std::size_t size() const noexcept {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    // Current array capacity (owner only)
+    std::size_t capacity() const noexcept {
+        return static_cast<std::size_t>(array_.load(std::memory_order_relaxed)->capacity);
+    }
+
+private:
+    // Owner only: double the array, copying the live range [t, b)
+    Array* grow(Array* old, std::int64_t t, std::int64_t b) {
+        auto bigger = std::make_unique<Array>(old->capacity * 2);
+        for (std::int64_t i = t; i < b; ++i) {
+            bigger->put(i, old->get(i));
+        }
+        Array* a = bigger.get();
+        arrays_.push_back(std::move(bigger));  // keep the old one for late thieves
+        array_.store(a, std::memory_order_release);
+        return a;
+    }
+
+    // Thieves write top_, the owner writes bottom_: separate cache lines
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<Array*>                    array_{nullptr};
+    std::vector<std::unique_ptr<Array>>    arrays_;  // owner only; every array ever used
+};
+
+} // namespace thread_pool
@@ -0,0 +1,557 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+// C++20 coroutines on WorkStealingThreadPool. These live in
+// thread_pool::coro because thread_pool::Task is the pool's type-erased
+// callable (task.hpp).
+namespace thread_pool::coro {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * Completion handshake between a task and its awaiter: both the awaiter
+ * (once it has started the task and is ready to suspend) and the task
+ * (at final suspend) exchange `rendezvous_`, and whoever comes second
+ * continues the awaiter.
+ * - Task still running when the awaiter checks in (it suspended on the
+ *   pool): the awaiter suspends, and the task transfers to it from its
+ *   final suspend, on the thread that finished it
+ * - Task already finished by then: the awaiter just carries on, inside
+ *   the same await_suspend call. Nothing nests, so a loop of awaits on
+ *   synchronously completing tasks runs in constant stack even where the
+ *   compiler does not turn symmetric transfer into a tail call (GCC
+ *   without optimization, or with sanitizers).
+ */
+class PromiseBase {
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept
+        {
+            PromiseBase& promise = self.promise();
+            if (promise.rendezvous_.exchange(true, std::memory_order_acq_rel)) {
+                return promise.continuation_;  // the awaiter is suspended: resume it here
+            }
+            return std::noop_coroutine();  // the awaiter continues on its own
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+public:
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter        final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept { error_ = std::current_exception(); }
+
+    /**
+     * Start the (initially suspended) task with `awaiter` as its
+     * continuation. Returns whether the awaiter must suspend: false if
+     * the task already finished.
+     */
+    bool start(std::coroutine_handle<> self, std::coroutine_handle<> awaiter) noexcept
+    {
+        continuation_ = awaiter;
+        self.resume();
+        return !rendezvous_.exchange(true, std::memory_order_acq_rel);
+    }
+
+protected:
+    void rethrow_if_failed() const
+    {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    std::coroutine_handle<> continuation_;
+    std::atomic<bool>       rendezvous_{false};
+    std::exception_ptr      error_;
+};
+
+template <typename T>
+class Promise : public PromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value)
+    {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T result()
+    {
+        rethrow_if_failed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class Promise<void> : public PromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void result() const { rethrow_if_failed(); }
+};
+
+} // namespace detail
+
+/**
+ * Lazily started coroutine producing a T (or an exception).
+ *
+ * DESIGN:
+ * - Starts suspended; runs when awaited (or via sync_wait / when_all /
+ *   when_any), on the awaiting thread
+ * - `co_await task` starts it inline; if it suspends, its final suspend
+ *   transfers straight back to the awaiter (symmetric transfer). The
+ *   awaiter therefore continues on whichever thread finished the task
+ *   (e.g. the pool worker that ran its last step), with no extra hop
+ *   through a queue. A task that completes without suspending returns to
+ *   its awaiter as a plain return (see detail::PromiseBase), so await
+ *   chains never grow the stack.
+ * - `co_await pool.schedule()` (WorkStealingThreadPool::schedule) is the
+ *   only thing that moves a coroutine between threads
+ *
+ * LIMITATIONS:
+ * - T must be void or an object type (no references)
+ * - A Task is awaited at most once; its result is moved out
+ * - Destroying a Task that was started but has not finished is undefined
+ *   (same as destroying any suspended-in-flight coroutine)
+ *
+ * THREAD SAFETY:
+ * - A Task object belongs to one coroutine/thread at a time; the frame may
+ *   move between pool workers as it runs
+ *
+ * EXAMPLE:
+ *   coro::Task<int> answer(WorkStealingThreadPool& pool) {
+ *       co_await pool.schedule();  // now on a worker
+ *       co_return 42;
+ *   }
+ *   int x = coro::sync_wait(answer(pool));
+ */
+template <typename T>
+class [[nodiscard]] Task {
+    static_assert(!std::is_reference_v<T>, "coro::Task<T&> is not supported");
+
+public:
+    using promise_type = detail::Promise<T>;
+    using value_type   = T;
+
+    Task() noexcept = default;
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // Runs the task (if not finished yet) and returns its result
+    auto operator co_await() && noexcept { return ResultAwaiter{handle_}; }
+    auto operator co_await() & noexcept { return ResultAwaiter{handle_}; }
+
+    // Runs the task (if not finished yet) without taking its result or
+    // rethrowing its exception. Used by the combinators.
+    auto when_ready() noexcept { return ReadyAwaiter{handle_}; }
+
+    [[nodiscard]] bool is_ready() const noexcept { return !handle_ || handle_.done(); }
+
+private:
+    friend class detail::Promise<T>;
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle handle) noexcept : handle_(handle) {}
+
+    struct ReadyAwaiter {
+        bool await_ready() const noexcept { return handle.done(); }
+
+        bool await_suspend(std::coroutine_handle<> awaiter) noexcept
+        {
+            return handle.promise().start(handle, awaiter);
+        }
+
+        void await_resume() const noexcept {}
+
+        Handle handle;
+    };
+
+    struct ResultAwaiter : ReadyAwaiter {
+        T await_resume() { return this->handle.promise().result(); }
+    };
+
+    Handle handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+// Result of a finished task (rethrows its exception)
+template <typename T>
+T take_result(Task<T>& task)
+{
+    return std::move(task).operator co_await().await_resume();
+}
+
+// Tuple element for when_all: void results become std::monostate
+template <typename T>
+using NonVoid = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+template <typename T>
+NonVoid<T> take_non_void(Task<T>& task)
+{
+    if constexpr (std::is_void_v<T>) {
+        take_result(task);
+        return {};
+    } else {
+        return take_result(task);
+    }
+}
+
+/**
+ * Completion counter for when_all. Starts at n + 1: the extra count is the
+ * awaiting coroutine's, so children that finish before it suspends do not
+ * try to resume it.
+ */
+class WhenAllLatch {
+public:
+    explicit WhenAllLatch(std::size_t children) noexcept : count_(children + 1) {}
+
+    // Child finished: the awaiter to resume if this was the last one
+    std::coroutine_handle<> count_down() noexcept
+    {
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            return waiter_;
+        }
+        return std::noop_coroutine();
+    }
+
+    bool await_ready() const noexcept { return count_.load(std::memory_order_acquire) == 1; }
+
+    bool await_suspend(std::coroutine_handle<> waiter) noexcept
+    {
+        waiter_ = waiter;
+        return count_.fetch_sub(1, std::memory_order_acq_rel) > 1;
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    std::atomic<std::size_t> count_;
+    std::coroutine_handle<>  waiter_;
+};
+
+/**
+ * Per-child driver for when_all: awaits the child, then counts down the
+ * latch and, if last, transfers to the when_all coroutine. Owned (and
+ * destroyed) by the when_all frame.
+ */
+class WhenAllNotifier {
+public:
+    struct promise_type {
+        WhenAllLatch* latch = nullptr;
+
+        WhenAllNotifier get_return_object() noexcept
+        {
+            return WhenAllNotifier(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        auto final_suspend() const noexcept
+        {
+            struct CountDown {
+                bool await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<promise_type> self) noexcept
+                {
+                    return self.promise().latch->count_down();
+                }
+
+                void await_resume() const noexcept {}
+            };
+            return CountDown{};
+        }
+
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }  // when_ready() never throws
+    };
+
+    WhenAllNotifier(WhenAllNotifier&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    WhenAllNotifier(const WhenAllNotifier&)            = delete;
+    WhenAllNotifier& operator=(const WhenAllNotifier&) = delete;
+    WhenAllNotifier& operator=(WhenAllNotifier&&)      = delete;
+
+    ~WhenAllNotifier()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    void start(WhenAllLatch& latch) noexcept
+    {
+        handle_.promise().latch = &latch;
+        handle_.resume();
+    }
+
+private:
+    explicit WhenAllNotifier(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+WhenAllNotifier make_when_all_notifier(Task<T>& task)
+{
+    co_await task.when_ready();
+}
+
+/**
+ * Fire-and-forget coroutine: starts immediately, frees its own frame when
+ * it finishes.
+ */
+struct Detached {
+    struct promise_type {
+        Detached            get_return_object() const noexcept { return {}; }
+        std::suspend_never  initial_suspend() const noexcept { return {}; }
+        std::suspend_never  final_suspend() const noexcept { return {}; }
+        void                return_void() const noexcept {}
+        void                unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template <typename T>
+struct WhenAnyState {
+    explicit WhenAnyState(std::vector<Task<T>> t) : tasks(std::move(t)) {}
+
+    std::vector<Task<T>>    tasks;
+    std::atomic<bool>       decided{false};
+    std::size_t             winner{0};
+    std::coroutine_handle<> waiter;
+};
+
+// Awaits child i; the first child to finish resumes the when_any
+// coroutine, on its own thread. Keeps the shared state (and so every
+// child) alive until it is done.
+template <typename T>
+Detached when_any_notifier(std::shared_ptr<WhenAnyState<T>> state, std::size_t i)
+{
+    co_await state->tasks[i].when_ready();
+    if (!state->decided.exchange(true, std::memory_order_acq_rel)) {
+        state->winner = i;
+        state->waiter.resume();
+    }
+}
+
+template <typename T>
+struct WhenAnyAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> waiter)
+    {
+        // The first child may finish, and the waiter resume and destroy
+        // this awaiter, inside the loop: use a local copy of the state
+        std::shared_ptr<WhenAnyState<T>> shared = state;
+        shared->waiter = waiter;
+        for (std::size_t i = 0; i < shared->tasks.size(); ++i) {
+            when_any_notifier(shared, i);
+        }
+    }
+
+    void await_resume() const noexcept {}
+
+    // Refers to the when_any frame's pointer rather than holding a copy:
+    // GCC 12 can destroy a co_await operand temporary twice when the
+    // coroutine is resumed from inside await_suspend, which would drop a
+    // reference that is not ours
+    std::shared_ptr<WhenAnyState<T>>& state;
+};
+
+template <typename T>
+Detached sync_wait_notifier(Task<T>& task, std::mutex& mutex, std::condition_variable& cv,
+                            bool& done)
+{
+    co_await task.when_ready();
+    std::lock_guard<std::mutex> lk(mutex);
+    done = true;
+    cv.notify_one();
+}
+
+} // namespace detail
+
+/**
+ * Runs every task and completes with all their results, in argument
+ * order (void results as std::monostate). Rethrows the first failed
+ * task's exception, in argument order, once all have finished.
+ *
+ * The children start one after another on the awaiting thread and run
+ * concurrently from their first suspension on, so a child that should
+ * run in parallel begins with `co_await pool.schedule()`. The when_all
+ * coroutine resumes on the thread that finished the last child.
+ */
+template <typename... Ts>
+Task<std::tuple<detail::NonVoid<Ts>...>> when_all(Task<Ts>... tasks)
+{
+    detail::WhenAllLatch latch(sizeof...(Ts));
+    std::array<detail::WhenAllNotifier, sizeof...(Ts)> notifiers{
+        detail::make_when_all_notifier(tasks)...};
+    for (auto& notifier : notifiers) {
+        notifier.start(latch);
+    }
+    co_await latch;
+
+    co_return std::tuple<detail::NonVoid<Ts>...>{detail::take_non_void(tasks)...};
+}
+
+/**
+ * when_all over a runtime number of tasks of one type: completes with a
+ * vector of results in input order (nothing for Task<void>).
+ */
+template <typename T>
+Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>
+when_all(std::vector<Task<T>> tasks)
+{
+    detail::WhenAllLatch latch(tasks.size());
+    std::vector<detail::WhenAllNotifier> notifiers;
+    notifiers.reserve(tasks.size());
+    for (auto& task : tasks) {
+        notifiers.push_back(detail::make_when_all_notifier(task));
+    }
+    for (auto& notifier : notifiers) {
+        notifier.start(latch);
+    }
+    co_await latch;
+
+    if constexpr (std::is_void_v<T>) {
+        for (auto& task : tasks) {
+            detail::take_result(task);
+        }
+    } else {
+        std::vector<T> results;
+        results.reserve(tasks.size());
+        for (auto& task : tasks) {
+            results.push_back(detail::take_result(task));
+        }
+        co_return results;
+    }
+}
+
+template <typename T>
+struct WhenAnyResult {
+    std::size_t index;  // which task finished first
+    T           value;
+};
+
+template <>
+struct WhenAnyResult<void> {
+    std::size_t index;
+};
+
+/**
+ * Completes as soon as the first of `tasks` finishes, with its index and
+ * result (or its exception), resuming on the thread that finished it.
+ *
+ * The other tasks keep running in the background and their results are
+ * dropped; they are destroyed once the last of them finishes. Throws
+ * std::invalid_argument for an empty vector.
+ */
+template <typename T>
+Task<WhenAnyResult<T>> when_any(std::vector<Task<T>> tasks)
+{
+    if (tasks.empty()) {
+        throw std::invalid_argument("when_any needs at least one task");
+    }
+    auto state = std::make_shared<detail::WhenAnyState<T>>(std::move(tasks));
+    co_await detail::WhenAnyAwaiter<T>{state};
+
+    Task<T>& first = state->tasks[state->winner];
+    if constexpr (std::is_void_v<T>) {
+        detail::take_result(first);
+        co_return WhenAnyResult<void>{state->winner};
+    } else {
+        co_return WhenAnyResult<T>{state->winner, detail::take_result(first)};
+    }
+}
+
+/**
+ * Runs a task from ordinary code and blocks the calling thread until it
+ * finishes. Returns its result or rethrows its exception.
+ *
+ * Blocks for real: do not call it from a pool worker on a task that needs
+ * that worker (use TaskGroup / help_until there, or stay in coroutines).
+ */
+template <typename T>
+T sync_wait(Task<T> task)
+{
+    std::mutex              mutex;
+    std::condition_variable cv;
+    bool                    done = false;
+
+    detail::sync_wait_notifier(task, mutex, cv, done);
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        cv.wait(lk, [&] { return done; });
+    }
+    return detail::take_result(task);
+}
+
+} // namespace thread_pool::coro
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "thread_pool/priority.hpp"
+
+// Scheduler counters are compiled in only with THREAD_POOL_METRICS=1 (CMake
+// option THREAD_POOL_METRICS). Every translation unit of a program must
+// agree on it.
+#ifndef THREAD_POOL_METRICS
+#define THREAD_POOL_METRICS 0
+#endif
+
+namespace thread_pool {
+
+inline constexpr bool kMetricsEnabled = THREAD_POOL_METRICS != 0;
+
+/**
+ * Counters of one worker, as of a snapshot.
+ *
+ * - tasks: tasks run by the worker (deadline tasks count once)
+ * - local_pops / injector_pops / steals: where its tasks came from
+ * - failed_steals: steal scans of one class that found nothing
+ * - parks: times it went to sleep; wakeups: times a submitter or searcher
+ *   woke it (as opposed to noticing work itself, or shutdown)
+ * - busy_ns: time awake (running tasks or searching), idle_ns: parked
+ */
+struct WorkerMetrics {
+    std::uint64_t tasks         = 0;
+    std::uint64_t local_pops    = 0;
+    std::uint64_t injector_pops = 0;
+    std::uint64_t steals        = 0;
+    std::uint64_t failed_steals = 0;
+    std::uint64_t parks         = 0;
+    std::uint64_t wakeups       = 0;
+    std::int64_t  busy_ns       = 0;
+    std::int64_t  idle_ns       = 0;
+
+    WorkerMetrics& operator+=(const WorkerMetrics& other) noexcept
+    {
+        tasks += other.tasks;
+        local_pops += other.local_pops;
+        injector_pops += other.injector_pops;
+        steals += other.steals;
+        failed_steals += other.failed_steals;
+        parks += other.parks;
+        wakeups += other.wakeups;
+        busy_ns += other.busy_ns;
+        idle_ns += other.idle_ns;
+        return *this;
+    }
+};
+
+/**
+ * Snapshot of a pool's scheduler metrics (WorkStealingThreadPool::metrics()).
+ *
+ * Histograms come from the tasks sampled for queueing latency
+ * (SchedulingConfig::latency_sample_period); start_latency is always
+ * filled, everything else only when kMetricsEnabled. Not atomic across
+ * fields: counters keep moving while a snapshot is taken.
+ */
+struct SchedulerMetrics {
+    bool                       enabled = kMetricsEnabled;
+    std::vector<WorkerMetrics> workers;
+
+    // Submit until a thread starts it, per class (ns)
+    std::array<LatencyHistogram::Snapshot, kPriorityCount> start_latency{};
+    // Time spent running a task (ns)
+    LatencyHistogram::Snapshot run_time;
+    // Tasks queued in the picking worker's deques plus the injectors,
+    // seen when it picks a sampled task (values are task counts)
+    LatencyHistogram::Snapshot queue_depth;
+
+    [[nodiscard]] WorkerMetrics total() const noexcept
+    {
+        WorkerMetrics sum;
+        for (const WorkerMetrics& w : workers) {
+            sum += w;
+        }
+        return sum;
+    }
+
+    /**
+     * The snapshot as one JSON object: totals, per-worker counters, and
+     * p50/p90/p99/max plus count for each histogram.
+     */
+    [[nodiscard]] std::string to_json() const
+    {
+        std::ostringstream out;
+        out << "{\"enabled\":" << (enabled ? "true" : "false");
+        out << ",\"total\":";
+        write(out, total());
+        out << ",\"workers\":[";
+        for (std::size_t i = 0; i < workers.size(); ++i) {
+            out << (i ? "," : "");
+            write(out, workers[i]);
+        }
+        out << "],\"start_latency_ns\":{";
+        static constexpr const char* kClassNames[kPriorityCount] = {"high", "normal", "low"};
+        for (std::size_t cls = 0; cls < kPriorityCount; ++cls) {
+            out << (cls ? "," : "") << '"' << kClassNames[cls] << "\":";
+            write(out, start_latency[cls]);
+        }
+        out << "},\"run_time_ns\":";
+        write(out, run_time);
+        out << ",\"queue_depth\":";
+        write(out, queue_depth);
+        out << "}";
+        return out.str();
+    }
+
+private:
+    static void write(std::ostringstream& out, const WorkerMetrics& w)
+    {
+        out << "{\"tasks\":" << w.tasks << ",\"local_pops\":" << w.local_pops
+            << ",\"injector_pops\":" << w.injector_pops << ",\"steals\":" << w.steals
+            << ",\"failed_steals\":" << w.failed_steals << ",\"parks\":" << w.parks
+            << ",\"wakeups\":" << w.wakeups << ",\"busy_ns\":" << w.busy_ns
+            << ",\"idle_ns\":" << w.idle_ns << "}";
+    }
+
+    static void write(std::ostringstream& out, const LatencyHistogram::Snapshot& h)
+    {
+        out << "{\"count\":" << h.count << ",\"p50\":" << h.percentile(0.5)
+            << ",\"p90\":" << h.percentile(0.9) << ",\"p99\":" << h.percentile(0.99)
+            << ",\"max\":" << h.percentile(1.0) << "}";
+    }
+};
+
+namespace detail {
+
+// Steady clock in ns (same epoch as the pool's clock_ns())
+inline std::int64_t metrics_clock_ns() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * A worker's counters. Only the owning worker writes them: each update is
+ * a relaxed load and store, no RMW, so counting costs a few plain
+ * instructions. Histograms take a fetch_add (helping non-workers share
+ * theirs). Clock reads happen only around parking and for sampled tasks.
+ */
+class alignas(64) WorkerCounters {
+public:
+    void task() noexcept { bump(tasks_); }
+    void local_pop() noexcept { bump(local_pops_); }
+    void injector_pop() noexcept { bump(injector_pops_); }
+    void steal(bool found) noexcept { bump(found ? steals_ : failed_steals_); }
+
+    void start() noexcept { started_ns_.store(metrics_clock_ns(), std::memory_order_relaxed); }
+    void stop() noexcept { stopped_ns_.store(metrics_clock_ns(), std::memory_order_relaxed); }
+
+    void park_begin() noexcept
+    {
+        bump(parks_);
+        parked_since_ns_.store(metrics_clock_ns(), std::memory_order_relaxed);
+    }
+
+    void park_end(bool woken) noexcept
+    {
+        const std::int64_t since = parked_since_ns_.load(std::memory_order_relaxed);
+        idle_ns_.store(idle_ns_.load(std::memory_order_relaxed) + (metrics_clock_ns() - since),
+                       std::memory_order_relaxed);
+        parked_since_ns_.store(0, std::memory_order_relaxed);
+        if (woken) {
+            bump(wakeups_);
+        }
+    }
+
+    // A sampled task was picked with `depth` tasks queued / ran for `ns`
+    void queue_depth(std::size_t depth) noexcept { queue_depth_.record(static_cast<std::int64_t>(depth)); }
+    void run_time(std::int64_t ns) noexcept { run_time_.record(ns); }
+
+    [[nodiscard]] WorkerMetrics snapshot() const noexcept
+    {
+        WorkerMetrics m;
+        m.tasks         = tasks_.load(std::memory_order_relaxed);
+        m.local_pops    = local_pops_.load(std::memory_order_relaxed);
+        m.injector_pops = injector_pops_.load(std::memory_order_relaxed);
+        m.steals        = steals_.load(std::memory_order_relaxed);
+        m.failed_steals = failed_steals_.load(std::memory_order_relaxed);
+        m.parks         = parks_.load(std::memory_order_relaxed);
+        m.wakeups       = wakeups_.load(std::memory_order_relaxed);
+
+        const std::int64_t started = started_ns_.load(std::memory_order_relaxed);
+        if (started == 0) {
+            return m;  // not a worker, or not started yet
+        }
+        const std::int64_t stopped = stopped_ns_.load(std::memory_order_relaxed);
+        const std::int64_t now     = stopped != 0 ? stopped : metrics_clock_ns();
+        const std::int64_t parked  = parked_since_ns_.load(std::memory_order_relaxed);
+        m.idle_ns = idle_ns_.load(std::memory_order_relaxed) + (parked != 0 ? now - parked : 0);
+        m.busy_ns = std::max<std::int64_t>(0, now - started - m.idle_ns);
+        return m;
+    }
+
+    void add_histograms(LatencyHistogram::Snapshot& run_time, LatencyHistogram::Snapshot& depth) const noexcept
+    {
+        run_time += run_time_.snapshot();
+        depth += queue_depth_.snapshot();
+    }
+
+private:
+    static void bump(std::atomic<std::uint64_t>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> tasks_{0};
+    std::atomic<std::uint64_t> local_pops_{0};
+    std::atomic<std::uint64_t> injector_pops_{0};
+    std::atomic<std::uint64_t> steals_{0};
+    std::atomic<std::uint64_t> failed_steals_{0};
+    std::atomic<std::uint64_t> parks_{0};
+    std::atomic<std::uint64_t> wakeups_{0};
+    std::atomic<std::int64_t>  started_ns_{0};
+    std::atomic<std::int64_t>  stopped_ns_{0};
+    std::atomic<std::int64_t>  parked_since_ns_{0};  // 0: not parked
+    std::atomic<std::int64_t>  idle_ns_{0};
+    LatencyHistogram           run_time_;
+    LatencyHistogram           queue_depth_;
+};
+
+// Stand-in when metrics are compiled out: every hook is an empty inline
+// function, so the scheduler's code is what it is without metrics
+struct NoCounters {
+    void task() noexcept {}
+    void local_pop() noexcept {}
+    void injector_pop() noexcept {}
+    void steal(bool) noexcept {}
+    void start() noexcept {}
+    void stop() noexcept {}
+    void park_begin() noexcept {}
+    void park_end(bool) noexcept {}
+    void queue_depth(std::size_t) noexcept {}
+    void run_time(std::int64_t) noexcept {}
+
+    [[nodiscard]] WorkerMetrics snapshot() const noexcept { return {}; }
+    void add_histograms(LatencyHistogram::Snapshot&, LatencyHistogram::Snapshot&) const noexcept {}
+};
+
+} // namespace detail
+
+} // namespace thread_pool
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "thread_pool/task_group.hpp"
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+namespace thread_pool {
+
+/**
+ * Data-parallel algorithms on a WorkStealingThreadPool.
+ *
+ * DESIGN:
+ * - Recursive binary splitting: a range is halved, the right half becomes a
+ *   task, the left half runs inline, and the caller joins the two
+ *   (detail::fork_join, on a TaskGroup)
+ * - Lazy splitting (Tzannes et al., "Lazy Binary Splitting", PPoPP 2010):
+ *   a worker only splits while its own deque is empty, i.e. when the half it
+ *   pushed last has been stolen. Otherwise it runs the next grain-sized
+ *   chunk itself and checks again. Splits follow steal demand: a busy pool
+ *   splits a range a handful of times, an idle one splits it down to the
+ *   grain.
+ * - Grain 0 (the default) picks n / (16 * thread_count()), at least 1. The
+ *   grain is the smallest chunk handed to the body, so it only needs to be
+ *   big enough to amortize the per-chunk check (two relaxed loads).
+ * - Joining helps: while its right half is outstanding, the waiting thread
+ *   runs other queued tasks (TaskGroup::wait), its own first. A worker
+ *   never blocks, so nested calls (parallel_for inside a pool task) cannot
+ *   deadlock the pool.
+ * - A caller outside the pool splits eagerly down to the grain (it has no
+ *   deque to measure demand with), pushes the halves through the injector,
+ *   and helps execute them until its call completes.
+ *
+ * ORDERING:
+ * - parallel_reduce and parallel_scan combine partial results in index
+ *   order, so op needs to be associative but not commutative
+ *
+ * EXCEPTIONS:
+ * - An exception thrown by the body is rethrown by the algorithm, after
+ *   every chunk already started has finished (other chunks may or may not
+ *   have run). If several chunks throw, one of the exceptions is rethrown.
+ *
+ * LIMITATIONS:
+ * - Iterators must be random access
+ * - parallel_sort splits eagerly (a sort cannot be split halfway through)
+ *   and merges with std::inplace_merge; the final merge is serial
+ */
+
+namespace detail {
+
+inline constexpr std::size_t kAutoChunksPerThread = 16;
+inline constexpr std::size_t kMinSortGrain        = 2048;
+
+inline std::size_t auto_grain(const WorkStealingThreadPool& pool, std::size_t n,
+                              std::size_t grain) noexcept
+{
+    if (grain != 0) {
+        return grain;
+    }
+    return std::max<std::size_t>(1, n / (pool.thread_count() * kAutoChunksPerThread));
+}
+
+// Split demand: the calling worker's last split-off half has been taken
+inline bool split_wanted(const WorkStealingThreadPool& pool) noexcept
+{
+    return !pool.in_worker_thread() || pool.local_queue_size() == 0;
+}
+
+/**
+ * Run left() inline and right() as a pool task, and return once both are
+ * done, helping with queued work meanwhile. Rethrows left's exception,
+ * else right's.
+ */
+template <typename Left, typename Right>
+void fork_join(WorkStealingThreadPool& pool, Left&& left, Right&& right)
+{
+    TaskGroup group(pool);
+    group.spawn(std::forward<Right>(right));
+    left();  // if this throws, ~TaskGroup still waits for right()
+    group.wait();
+}
+
+// body(b, e) over [b, e), in grain-sized chunks, splitting on demand
+template <typename Body>
+void for_range(WorkStealingThreadPool& pool, std::size_t b, std::size_t e,
+               std::size_t grain, Body& body)
+{
+    while (b < e) {
+        if (e - b > grain && split_wanted(pool)) {
+            const std::size_t mid = b + (e - b) / 2;
+            fork_join(pool,
+                      [&] { for_range(pool, b, mid, grain, body); },
+                      [&] { for_range(pool, mid, e, grain, body); });
+            return;
+        }
+        const std::size_t chunk_end = std::min(e, b + grain);
+        body(b, chunk_end);
+        b = chunk_end;
+    }
+}
+
+// Left fold of a non-empty range [b, e)
+template <typename T, typename It, typename Op>
+T fold(It b, It e, Op& op)
+{
+    T acc = *b;
+    for (++b; b != e; ++b) {
+        acc = op(std::move(acc), *b);
+    }
+    return acc;
+}
+
+// Fold of first[b, e), b < e, splitting on demand; partials combined in order
+template <typename T, typename It, typename Op>
+T reduce_range(WorkStealingThreadPool& pool, It first, std::size_t b, std::size_t e,
+               std::size_t grain, Op& op)
+{
+    std::optional<T> acc;
+    while (b < e) {
+        if (e - b > grain && split_wanted(pool)) {
+            const std::size_t mid = b + (e - b) / 2;
+            std::optional<T>  left;
+            std::optional<T>  right;
+            fork_join(pool,
+                      [&] { left.emplace(reduce_range<T>(pool, first, b, mid, grain, op)); },
+                      [&] { right.emplace(reduce_range<T>(pool, first, mid, e, grain, op)); });
+            T joined = op(std::move(*left), std::move(*right));
+            return acc ? op(std::move(*acc), std::move(joined)) : joined;
+        }
+        const std::size_t chunk_end = std::min(e, b + grain);
+        T chunk = fold<T>(first + static_cast<std::ptrdiff_t>(b),
+                          first + static_cast<std::ptrdiff_t>(chunk_end), op);
+        acc = acc ? op(std::move(*acc), std::move(chunk)) : std::move(chunk);
+        b = chunk_end;
+    }
+    return std::move(*acc);
+}
+
+template <typename It, typename Compare>
+void sort_range(WorkStealingThreadPool& pool, It b, It e, std::size_t grain, Compare& comp)
+{
+    const auto n = static_cast<std::size_t>(e - b);
+    if (n <= grain) {
+        std::sort(b, e, comp);
+        return;
+    }
+    const It mid = b + static_cast<std::ptrdiff_t>(n / 2);
+    fork_join(pool,
+              [&] { sort_range(pool, b, mid, grain, comp); },
+              [&] { sort_range(pool, mid, e, grain, comp); });
+    std::inplace_merge(b, mid, e, comp);
+}
+
+} // namespace detail
+
+/**
+ * fn(i) for every i in [first, last). Each task runs chunks of `grain`
+ * consecutive indices (0: automatic).
+ */
+template <typename Fn>
+void parallel_for(WorkStealingThreadPool& pool, std::size_t first, std::size_t last,
+                  std::size_t grain, Fn&& fn)
+{
+    if (first >= last) {
+        return;
+    }
+    auto body = [&fn](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+            fn(i);
+        }
+    };
+    detail::for_range(pool, first, last, detail::auto_grain(pool, last - first, grain), body);
+}
+
+template <typename Fn>
+void parallel_for(WorkStealingThreadPool& pool, std::size_t first, std::size_t last, Fn&& fn)
+{
+    parallel_for(pool, first, last, 0, std::forward<Fn>(fn));
+}
+
+/**
+ * init op x0 op x1 op ... over [first, last), like std::reduce but with the
+ * partial results combined in order (op must be associative).
+ */
+template <typename It, typename T, typename Op = std::plus<>>
+T parallel_reduce(WorkStealingThreadPool& pool, It first, It last, T init, Op op = {},
+                  std::size_t grain = 0)
+{
+    static_assert(std::random_access_iterator<It>, "parallel_reduce needs random access");
+
+    const auto n = static_cast<std::size_t>(last - first);
+    if (n == 0) {
+        return init;
+    }
+    T total = detail::reduce_range<T>(pool, first, 0, n, detail::auto_grain(pool, n, grain), op);
+    return op(std::move(init), std::move(total));
+}
+
+/**
+ * d_first[i] = op(first[i]) for every element. Returns the end of the
+ * output range. The output may alias the input.
+ */
+template <typename It, typename OutIt, typename Op>
+OutIt parallel_transform(WorkStealingThreadPool& pool, It first, It last, OutIt d_first, Op op,
+                         std::size_t grain = 0)
+{
+    static_assert(std::random_access_iterator<It> && std::random_access_iterator<OutIt>,
+                  "parallel_transform needs random access");
+
+    const auto n = static_cast<std::size_t>(last - first);
+    if (n == 0) {
+        return d_first;
+    }
+    auto body = [&](std::size_t b, std::size_t e) {
+        std::transform(first + static_cast<std::ptrdiff_t>(b), first + static_cast<std::ptrdiff_t>(e),
+                       d_first + static_cast<std::ptrdiff_t>(b), op);
+    };
+    detail::for_range(pool, 0, n, detail::auto_grain(pool, n, grain), body);
+    return d_first + static_cast<std::ptrdiff_t>(n);
+}
+
+/**
+ * Sorts [first, last): std::sort on leaves of at least `grain` elements
+ * (0: automatic, never below 2048), merged pairwise up the split tree.
+ */
+template <typename It, typename Compare = std::less<>>
+void parallel_sort(WorkStealingThreadPool& pool, It first, It last, Compare comp = {},
+                   std::size_t grain = 0)
+{
+    static_assert(std::random_access_iterator<It>, "parallel_sort needs random access");
+
+    const auto n = static_cast<std::size_t>(last - first);
+    grain = std::max(detail::auto_grain(pool, n, grain), detail::kMinSortGrain);
+    detail::sort_range(pool, first, last, grain, comp);
+}
+
+/**
+ * Inclusive scan: d_first[i] = x0 op x1 op ... op xi. Returns the end of
+ * the output range. The output may alias the input.
+ *
+ * Two passes over blocks of `grain` elements: reduce every block but the
+ * last in parallel, scan the block totals serially, then scan every block
+ * in parallel starting from the total of the blocks before it.
+ */
+template <typename It, typename OutIt, typename Op = std::plus<>>
+OutIt parallel_scan(WorkStealingThreadPool& pool, It first, It last, OutIt d_first, Op op = {},
+                    std::size_t grain = 0)
+{
+    static_assert(std::random_access_iterator<It> && std::random_access_iterator<OutIt>,
+                  "parallel_scan needs random access");
+    using T = std::iter_value_t<It>;
+
+    const auto n = static_cast<std::size_t>(last - first);
+    grain = detail::auto_grain(pool, n, grain);
+    const std::size_t blocks = n == 0 ? 0 : (n + grain - 1) / grain;
+    if (blocks <= 1) {
+        return std::inclusive_scan(first, last, d_first, op);
+    }
+
+    auto block_begin = [&](std::size_t k) { return first + static_cast<std::ptrdiff_t>(k * grain); };
+    auto block_end   = [&](std::size_t k) {
+        return first + static_cast<std::ptrdiff_t>(std::min(n, (k + 1) * grain));
+    };
+
+    // Pass 1: totals of blocks 0 .. blocks-2
+    std::vector<std::optional<T>> prefix(blocks - 1);
+    auto reduce_blocks = [&](std::size_t b, std::size_t e) {
+        for (std::size_t k = b; k < e; ++k) {
+            prefix[k].emplace(detail::fold<T>(block_begin(k), block_end(k), op));
+        }
+    };
+    detail::for_range(pool, 0, blocks - 1, 1, reduce_blocks);
+
+    // prefix[k] = total of blocks 0..k
+    for (std::size_t k = 1; k < prefix.size(); ++k) {
+        prefix[k].emplace(op(*prefix[k - 1], std::move(*prefix[k])));
+    }
+
+    // Pass 2: scan each block from the running total before it
+    auto scan_blocks = [&](std::size_t b, std::size_t e) {
+        for (std::size_t k = b; k < e; ++k) {
+            OutIt out = d_first + static_cast<std::ptrdiff_t>(k * grain);
+            if (k == 0) {
+                std::inclusive_scan(block_begin(k), block_end(k), out, op);
+            } else {
+                std::inclusive_scan(block_begin(k), block_end(k), out, op, *prefix[k - 1]);
+            }
+        }
+    };
+    detail::for_range(pool, 0, blocks, 1, scan_blocks);
+
+    return d_first + static_cast<std::ptrdiff_t>(n);
+}
+
+} // namespace thread_pool
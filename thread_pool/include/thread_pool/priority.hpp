@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace thread_pool {
+
+/**
+ * Scheduling class of a task. Workers drain higher classes first
+ * (see SchedulingConfig for how lower classes avoid starvation).
+ */
+enum class Priority : std::uint8_t {
+    high   = 0,  // latency-critical (request handling)
+    normal = 1,  // default
+    low    = 2,  // bulk background work (compaction, snapshots)
+};
+
+inline constexpr std::size_t kPriorityCount = 3;
+
+constexpr std::size_t priority_index(Priority p) noexcept
+{
+    return static_cast<std::size_t>(p);
+}
+
+/**
+ * Per-task scheduling options for submit/post/execute.
+ *
+ * USAGE:
+ *   pool.post({.priority = Priority::low}, compact);
+ *   pool.post({.priority = Priority::normal,
+ *              .deadline = std::chrono::steady_clock::now() + 5ms}, reply);
+ */
+struct TaskOptions {
+    Priority priority = Priority::normal;
+
+    // Once the deadline is less than SchedulingConfig::promotion_window
+    // away, the task runs ahead of every class
+    std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+};
+
+/**
+ * Pool-wide scheduling knobs.
+ *
+ * - aging[c]: once tasks of class c have waited this long behind higher
+ *   classes, c goes ahead of them for one task. 0 disables aging for that
+ *   class (strict priority). Aging of `high` has no effect.
+ * - promotion_window: how close to its deadline a task gets promoted
+ * - latency_sample_period: every Nth task an enqueuing thread submits is
+ *   timed for the queueing latency histograms (1: every task, 0: none).
+ *   A clock read costs about as much as a post, hence the sampling.
+ * - pin_workers: pin worker i to one CPU (topology.hpp: one per core
+ *   first, cache neighbours next to each other) and steal from workers
+ *   sharing a cache first. Off by default: pinning fights other pinned
+ *   processes and the OS scheduler's balancing.
+ */
+struct SchedulingConfig {
+    std::array<std::chrono::nanoseconds, kPriorityCount> aging{
+        std::chrono::nanoseconds{0}, std::chrono::milliseconds{2}, std::chrono::milliseconds{20}};
+    std::chrono::nanoseconds promotion_window{std::chrono::milliseconds{1}};
+    std::uint32_t            latency_sample_period = 16;
+    bool                     pin_workers           = false;
+};
+
+/**
+ * Log2-bucketed histogram of queueing latencies (time from enqueue until
+ * a worker takes the task), in nanoseconds. The pool fills it with a
+ * sample of tasks (SchedulingConfig::latency_sample_period).
+ *
+ * Bucket i counts latencies in [2^i, 2^(i+1)) ns, bucket 0 also counts 0
+ * and 1 ns, and the last bucket counts everything above. Recording is one
+ * relaxed fetch_add; snapshots are not atomic across buckets.
+ */
+class LatencyHistogram {
+public:
+    static constexpr std::size_t kBuckets = 40;  // up to ~9 minutes
+
+    struct Snapshot {
+        std::array<std::uint64_t, kBuckets> buckets{};
+        std::uint64_t                       count = 0;
+
+        /**
+         * Upper bound (ns) of the bucket holding quantile q (0..1), e.g.
+         * percentile(0.99). 0 if nothing was recorded.
+         */
+        [[nodiscard]] std::uint64_t percentile(double q) const noexcept
+        {
+            if (count == 0) {
+                return 0;
+            }
+            const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < kBuckets; ++i) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    return upper_bound(i);
+                }
+            }
+            return upper_bound(kBuckets - 1);
+        }
+
+        Snapshot& operator+=(const Snapshot& other) noexcept
+        {
+            for (std::size_t i = 0; i < kBuckets; ++i) {
+                buckets[i] += other.buckets[i];
+            }
+            count += other.count;
+            return *this;
+        }
+    };
+
+    void record(std::int64_t ns) noexcept
+    {
+        buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Snapshot snapshot() const noexcept
+    {
+        Snapshot s;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            s.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+            s.count += s.buckets[i];
+        }
+        return s;
+    }
+
+    static constexpr std::size_t bucket_of(std::int64_t ns) noexcept
+    {
+        if (ns <= 1) {
+            return 0;
+        }
+        const auto width = static_cast<std::size_t>(std::bit_width(static_cast<std::uint64_t>(ns)));
+        return width - 1 < kBuckets ? width - 1 : kBuckets - 1;
+    }
+
+    static constexpr std::uint64_t upper_bound(std::size_t bucket) noexcept
+    {
+        return (std::uint64_t{1} << (bucket + 1)) - 1;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+};
+
+} // namespace thread_pool
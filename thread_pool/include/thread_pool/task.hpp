@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace thread_pool {
+
+/**
+ * Move-only `void()` callable with a 64-byte small-buffer optimization.
+ *
+ * DESIGN:
+ * - Callables that fit in kInlineSize bytes, need no more than
+ *   alignof(std::max_align_t) and are nothrow-movable live inside the Task:
+ *   constructing, moving and running them never allocates
+ * - Larger callables are moved to the heap (one allocation)
+ * - Type erasure through one static table per callable type (invoke, move,
+ *   destroy), so a Task is 64 bytes of storage plus one pointer
+ *
+ * Compared with std::function<void()>:
+ * - Move-only callables are accepted (promises, unique_ptrs, other Tasks)
+ * - 64 bytes inline instead of libstdc++'s 16: a lambda capturing a
+ *   std::promise and a few references still fits
+ *
+ * THREAD SAFETY:
+ * - None; a Task is owned by one thread at a time
+ */
+class Task {
+public:
+    static constexpr std::size_t kInlineSize  = 64;
+    static constexpr std::size_t kInlineAlign = alignof(std::max_align_t);
+
+    // True if F is stored inline (no allocation)
+    template <typename F>
+    static constexpr bool fits_inline = sizeof(F) <= kInlineSize &&
+                                        alignof(F) <= kInlineAlign &&
+                                        std::is_nothrow_move_constructible_v<F>;
+
+    Task() noexcept = default;
+
+    template <typename F,
+              typename Fn = std::decay_t<F>,
+              typename    = std::enable_if_t<!std::is_same_v<Fn, Task> &&
+                                             std::is_invocable_r_v<void, Fn&>>>
+    Task(F&& f) {  // NOLINT: implicit, like std::function
+        if constexpr (fits_inline<Fn>) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+            vtable_ = &kInlineTable<Fn>;
+        } else {
+            ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(f)));
+            vtable_ = &kHeapTable<Fn>;
+        }
+    }
+
+    Task(Task&& other) noexcept : vtable_(other.vtable_) {
+        if (vtable_) {
+            vtable_->move(storage_, other.storage_);
+            other.vtable_ = nullptr;
+        }
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.vtable_) {
+                other.vtable_->move(storage_, other.storage_);
+                vtable_       = other.vtable_;
+                other.vtable_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        reset();
+    }
+
+    // Precondition: non-empty
+    void operator()() {
+        vtable_->invoke(storage_);
+    }
+
+    explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+    void reset() noexcept {
+        if (vtable_) {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+private:
+    struct VTable {
+        void (*invoke)(void* self);
+        void (*move)(void* dst, void* src) noexcept;  // leaves src destroyed
+        void (*destroy)(void* self) noexcept;
+    };
+
+    template <typename Fn>
+    static constexpr VTable kInlineTable{
+        [](void* self) { std::invoke(*std::launder(static_cast<Fn*>(self))); },
+        [](void* dst, void* src) noexcept {
+            Fn* from = std::launder(static_cast<Fn*>(src));
+            ::new (dst) Fn(std::move(*from));
+            from->~Fn();
+        },
+        [](void* self) noexcept { std::launder(static_cast<Fn*>(self))->~Fn(); },
+    };
+
+    template <typename Fn>
+    static constexpr VTable kHeapTable{
+        [](void* self) { std::invoke(**static_cast<Fn**>(self)); },
+        [](void* dst, void* src) noexcept {
+            *static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+        },
+        [](void* self) noexcept { delete *static_cast<Fn**>(self); },
+    };
+
+    alignas(kInlineAlign) unsigned char storage_[kInlineSize];
+    const VTable*                       vtable_{nullptr};
+};
+
+} // namespace thread_pool
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+namespace thread_pool {
+
+/**
+ * Fork-join group of tasks on a WorkStealingThreadPool.
+ *
+ * DESIGN:
+ * - spawn(f) bumps a pending count and posts f. From a worker of the pool
+ *   the task goes onto that worker's own deque, so recursive
+ *   divide-and-conquer keeps its subtasks local until they are stolen.
+ * - wait() does not block: it runs queued tasks (own deque first, then the
+ *   injector, then steals) until the pending count drops to zero. A worker
+ *   waiting on its children usually just pops them back off its own deque.
+ *   Waiting never removes a thread from the pool, so arbitrarily deep
+ *   nesting cannot deadlock it, even with one worker.
+ * - Any thread may wait; a thread outside the pool helps the same way.
+ *
+ * MEMORY ORDERING:
+ * - pending_: release decrement when a task finishes (after its last
+ *   access to the group), acquire load in wait(), so everything the tasks
+ *   wrote is visible once wait() returns
+ *
+ * EXCEPTIONS:
+ * - The first exception thrown by a spawned task is kept and rethrown by
+ *   wait(); later ones are dropped. The group is reusable after wait().
+ * - The destructor waits for outstanding tasks (they may refer to the
+ *   group and to the spawner's stack) and drops any stored exception
+ *
+ * THREAD SAFETY:
+ * - spawn: any thread, including the group's own tasks (nested spawns)
+ * - wait: one thread at a time
+ *
+ * EXAMPLE:
+ *   long fib(WorkStealingThreadPool& pool, int n) {
+ *       if (n < 2) return n;
+ *       long a = 0, b = 0;
+ *       TaskGroup g(pool);
+ *       g.spawn([&] { a = fib(pool, n - 1); });
+ *       b = fib(pool, n - 2);
+ *       g.wait();
+ *       return a + b;
+ *   }
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingThreadPool& pool) noexcept : pool_(pool) {}
+
+    ~TaskGroup()
+    {
+        pool_.help_until([this] { return done(); });
+    }
+
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * Run f() on the pool as part of this group. f must be callable as
+     * void(); its return value, if any, is discarded.
+     */
+    template <typename F>
+    void spawn(F&& f)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            pool_.post([this, fn = std::forward<F>(f)]() mutable {
+                try {
+                    fn();
+                } catch (...) {
+                    record(std::current_exception());
+                }
+                // Last access to the group: wait() may return right after
+                pending_.fetch_sub(1, std::memory_order_release);
+            });
+        } catch (...) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    /**
+     * Execute pending work until every spawned task has finished, then
+     * rethrow the first exception any of them threw.
+     */
+    void wait()
+    {
+        pool_.help_until([this] { return done(); });
+
+        if (error_) {
+            std::exception_ptr error = std::exchange(error_, nullptr);
+            failed_.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Spawned tasks not finished yet (approximate while they run)
+    [[nodiscard]] std::size_t pending() const noexcept
+    {
+        return pending_.load(std::memory_order_relaxed);
+    }
+
+private:
+    bool done() const noexcept
+    {
+        return pending_.load(std::memory_order_acquire) == 0;
+    }
+
+    void record(std::exception_ptr error) noexcept
+    {
+        // Only the first failing task writes error_; wait() reads it after
+        // every task's pending_ decrement
+        if (!failed_.exchange(true, std::memory_order_relaxed)) {
+            error_ = std::move(error);
+        }
+    }
+
+    WorkStealingThreadPool&  pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<bool>        failed_{false};  // a task has claimed error_
+    std::exception_ptr       error_;
+};
+
+} // namespace thread_pool
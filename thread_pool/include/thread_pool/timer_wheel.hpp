@@ -0,0 +1,225 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace thread_pool {
+
+/**
+ * Intrusive hook for TimerWheel. Embed (or derive from) it in the timer
+ * object; the wheel never allocates.
+ */
+struct TimerEntry {
+    TimerEntry*   prev{nullptr};
+    TimerEntry*   next{nullptr};
+    std::uint64_t due{0};                     // tick the timer expires at
+    std::uint16_t slot{kUnlinked};            // level * kSlots + slot, while scheduled
+
+    static constexpr std::uint16_t kUnlinked = 0xffff;
+
+    [[nodiscard]] bool scheduled() const noexcept { return slot != kUnlinked; }
+};
+
+/**
+ * Hierarchical timing wheel (Varghese & Lauck, SOSP 1987), as in the
+ * Linux kernel and Kafka's purgatory.
+ *
+ * DESIGN:
+ * - Time is an integer tick count; the caller picks the tick length
+ * - kLevels wheels of kSlots slots. Level L covers deltas below
+ *   kSlots^(L+1) ticks with a slot per kSlots^L ticks; slot index is
+ *   (due >> (kLevelBits * L)) % kSlots, so it does not depend on when the
+ *   timer was inserted
+ * - When the tick count crosses a multiple of kSlots^L, the slot of level
+ *   L that just came due is emptied and its timers are re-inserted, which
+ *   moves them down a level (cascading). Level 0 slots hold timers of one
+ *   exact tick and expire as a whole.
+ * - Deltas beyond the top level (2^30 ticks) go into the top level at its
+ *   farthest slot and are re-inserted from there until they fit
+ * - One occupancy bit per slot: next_event() is a rotate and a
+ *   countr_zero per level, so advance() jumps over empty stretches of time
+ *   instead of stepping through every tick
+ *
+ * COMPLEXITY:
+ * - schedule, cancel: O(1). advance: O(expired + cascaded + levels).
+ *   Each timer cascades at most kLevels - 1 times.
+ *
+ * LIMITATIONS:
+ * - Timers due on the same tick expire in no particular order
+ *
+ * THREAD SAFETY:
+ * - None; the owner serializes access (the pool holds a mutex)
+ */
+class TimerWheel {
+public:
+    static constexpr unsigned    kLevelBits = 6;
+    static constexpr std::size_t kSlots     = std::size_t{1} << kLevelBits;
+    static constexpr std::size_t kLevels    = 5;
+    static constexpr std::uint64_t kMaxDelta = (std::uint64_t{1} << (kLevelBits * kLevels)) - 1;
+
+    explicit TimerWheel(std::uint64_t now = 0) noexcept : now_(now) {}
+
+    TimerWheel(const TimerWheel&)            = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Last tick advance() has processed
+    [[nodiscard]] std::uint64_t now() const noexcept { return now_; }
+    [[nodiscard]] std::size_t   size() const noexcept { return size_; }
+    [[nodiscard]] bool          empty() const noexcept { return size_ == 0; }
+
+    /**
+     * Insert an unscheduled entry to expire at tick `due`. Returns false,
+     * without inserting, if `due` is not after now(): the caller runs the
+     * timer itself.
+     */
+    bool schedule(TimerEntry* e, std::uint64_t due) noexcept {
+        e->due = due;
+        if (due <= now_) {
+            return false;
+        }
+        link(e);
+        return true;
+    }
+
+    // Remove an entry; one that is not scheduled is left alone
+    void cancel(TimerEntry* e) noexcept {
+        if (!e->scheduled()) {
+            return;
+        }
+        std::size_t index = e->slot;
+        if (e->prev) {
+            e->prev->next = e->next;
+        } else {
+            heads_[index] = e->next;
+            if (!e->next) {
+                occupied_[index / kSlots] &= ~(std::uint64_t{1} << (index % kSlots));
+            }
+        }
+        if (e->next) {
+            e->next->prev = e->prev;
+        }
+        e->prev = e->next = nullptr;
+        e->slot = TimerEntry::kUnlinked;
+        --size_;
+    }
+
+    /**
+     * Earliest tick after now() at which advance() has something to do:
+     * a level 0 slot expiring or a higher slot cascading. Empty if no
+     * timer is scheduled.
+     */
+    [[nodiscard]] std::optional<std::uint64_t> next_event() const noexcept {
+        std::optional<std::uint64_t> best;
+        for (std::size_t level = 0; level < kLevels; ++level) {
+            if (occupied_[level] == 0) {
+                continue;
+            }
+            const unsigned      shift = kLevelBits * static_cast<unsigned>(level);
+            const std::uint64_t round = now_ >> shift;
+            // First occupied slot after the current one, wrapping around
+            const auto          from  = static_cast<int>((round + 1) % kSlots);
+            const auto          ahead = static_cast<std::uint64_t>(std::countr_zero(std::rotr(occupied_[level], from)));
+            const std::uint64_t tick  = (round + 1 + ahead) << shift;
+            if (!best || tick < *best) {
+                best = tick;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * Move time forward to tick `to`, calling on_expired(entry) for every
+     * timer due by then, in tick order. Entries are unlinked before the
+     * call, so on_expired may reschedule or free them.
+     */
+    template <typename OnExpired>
+    void advance(std::uint64_t to, OnExpired&& on_expired) {
+        while (true) {
+            const std::optional<std::uint64_t> tick = next_event();
+            if (!tick || *tick > to) {
+                break;
+            }
+            now_ = *tick;
+
+            // Highest level first: a timer cascading out of level L may
+            // land in the level L - 1 slot that cascades on this tick too
+            for (std::size_t level = kLevels - 1; level > 0; --level) {
+                const unsigned shift = kLevelBits * static_cast<unsigned>(level);
+                if ((now_ & ((std::uint64_t{1} << shift) - 1)) == 0) {
+                    cascade(level * kSlots + ((now_ >> shift) % kSlots), on_expired);
+                }
+            }
+            expire(now_ % kSlots, on_expired);
+        }
+        if (to > now_) {
+            now_ = to;
+        }
+    }
+
+private:
+    void link(TimerEntry* e) noexcept {
+        const std::uint64_t delta = e->due - now_;
+        // Too far out: park in the top level's farthest slot
+        const std::uint64_t placed = delta <= kMaxDelta ? e->due : now_ + kMaxDelta;
+        const std::size_t   level  =
+            (static_cast<std::size_t>(std::bit_width(placed - now_)) - 1) / kLevelBits;
+        const std::size_t index =
+            level * kSlots + ((placed >> (kLevelBits * static_cast<unsigned>(level))) % kSlots);
+
+        e->slot = static_cast<std::uint16_t>(index);
+        e->prev = nullptr;
+        e->next = heads_[index];
+        if (e->next) {
+            e->next->prev = e;
+        }
+        heads_[index] = e;
+        occupied_[level] |= std::uint64_t{1} << (index % kSlots);
+        ++size_;
+    }
+
+    // Detach a slot's list
+    TimerEntry* take(std::size_t index) noexcept {
+        TimerEntry* head = heads_[index];
+        heads_[index]    = nullptr;
+        occupied_[index / kSlots] &= ~(std::uint64_t{1} << (index % kSlots));
+        return head;
+    }
+
+    template <typename OnExpired>
+    void cascade(std::size_t index, OnExpired& on_expired) {
+        for (TimerEntry* e = take(index); e;) {
+            TimerEntry* next = e->next;
+            unlinked(e);
+            if (!schedule(e, e->due)) {
+                on_expired(e);
+            }
+            e = next;
+        }
+    }
+
+    template <typename OnExpired>
+    void expire(std::size_t index, OnExpired& on_expired) {
+        for (TimerEntry* e = take(index); e;) {
+            TimerEntry* next = e->next;
+            unlinked(e);
+            on_expired(e);
+            e = next;
+        }
+    }
+
+    void unlinked(TimerEntry* e) noexcept {
+        e->prev = e->next = nullptr;
+        e->slot = TimerEntry::kUnlinked;
+        --size_;
+    }
+
+    std::uint64_t                                now_;
+    std::size_t                                  size_ = 0;
+    std::array<TimerEntry*, kLevels * kSlots>    heads_{};
+    std::array<std::uint64_t, kLevels>           occupied_{};  // bit per non-empty slot
+};
+
+} // namespace thread_pool
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace thread_pool {
+
+/**
+ * One logical CPU and the caches it shares. Group ids are the lowest CPU
+ * id in the group, so equal ids mean shared; -1 means unknown.
+ */
+struct CpuInfo {
+    int id      = 0;
+    int package = 0;   // socket
+    int core    = 0;   // physical core (SMT siblings share it)
+    int l2      = -1;  // CPUs sharing this CPU's L2
+    int l3      = -1;  // CPUs sharing this CPU's last-level cache
+};
+
+/**
+ * CPU topology of the machine, for pinning workers and ordering steals.
+ *
+ * DESIGN:
+ * - detect() reads /sys/devices/system/cpu: the online CPUs, each one's
+ *   package and SMT siblings, and which CPUs share its L2 and L3
+ *   (cache/index*). It keeps only the CPUs this process may run on
+ *   (sched_getaffinity), so cgroup and taskset limits are respected.
+ * - Without sysfs (other systems, restricted containers) it falls back
+ *   to a flat topology: the allowed CPUs, or hardware_concurrency()
+ *   of them, with nothing known to be shared. Pinning still works there;
+ *   steal order just has no nearer tier.
+ *
+ * THREAD SAFETY:
+ * - Immutable after construction
+ */
+class CpuTopology {
+public:
+    // CPU ids at or above this are rejected (nothing could be pinned to them)
+#if defined(__linux__)
+    static constexpr int kMaxCpus = CPU_SETSIZE;
+#else
+    static constexpr int kMaxCpus = 1024;
+#endif
+
+    // Topology of this machine (see above)
+    static CpuTopology detect() {
+        std::vector<int> allowed = allowed_cpus();
+        CpuTopology      topo    = from_sysfs("/sys/devices/system/cpu");
+        if (!allowed.empty() && !topo.cpus_.empty()) {
+            std::erase_if(topo.cpus_, [&](const CpuInfo& cpu) {
+                return !std::binary_search(allowed.begin(), allowed.end(), cpu.id);
+            });
+        }
+        if (!topo.cpus_.empty()) {
+            return topo;
+        }
+        if (allowed.empty()) {
+            for (unsigned i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i) {
+                allowed.push_back(static_cast<int>(i));
+            }
+        }
+        return flat(allowed);
+    }
+
+    /**
+     * Parse a sysfs-style tree rooted at `root` (normally
+     * /sys/devices/system/cpu). Empty if `root`/online cannot be read.
+     */
+    static CpuTopology from_sysfs(const std::string& root) {
+        CpuTopology topo;
+        for (int id : parse_cpu_list(read_file(root + "/online"))) {
+            const std::string dir = root + "/cpu" + std::to_string(id);
+            CpuInfo           cpu;
+            cpu.id      = id;
+            cpu.package = std::max(0, read_int(dir + "/topology/physical_package_id", 0));
+            cpu.core    = lowest(read_file(dir + "/topology/thread_siblings_list"), id);
+            for (int index = 0;; ++index) {
+                const std::string cache = dir + "/cache/index" + std::to_string(index);
+                const int         level = read_int(cache + "/level", -1);
+                if (level < 0) {
+                    break;
+                }
+                if (read_file(cache + "/type").starts_with("Instruction")) {
+                    continue;
+                }
+                const int group = lowest(read_file(cache + "/shared_cpu_list"), id);
+                if (level == 2) {
+                    cpu.l2 = group;
+                } else if (level >= 3) {
+                    cpu.l3 = group;
+                }
+            }
+            topo.cpus_.push_back(cpu);
+        }
+        topo.known_ = !topo.cpus_.empty();
+        return topo;
+    }
+
+    // The given CPUs, nothing shared between them
+    static CpuTopology flat(const std::vector<int>& ids) {
+        CpuTopology topo;
+        for (int id : ids) {
+            topo.cpus_.push_back(CpuInfo{id, 0, id, -1, -1});
+        }
+        return topo;
+    }
+
+    [[nodiscard]] const std::vector<CpuInfo>& cpus() const noexcept { return cpus_; }
+
+    // True if read from sysfs rather than guessed
+    [[nodiscard]] bool known() const noexcept { return known_; }
+
+    /**
+     * CPUs in the order to pin workers to: one hardware thread per core
+     * first (cores of one cache group, then one package, next to each
+     * other), then the SMT siblings in the same order. Worker i goes on
+     * placement()[i % size].
+     */
+    [[nodiscard]] std::vector<CpuInfo> placement() const {
+        std::vector<CpuInfo> order = cpus_;
+        auto by_location = [](const CpuInfo& c) { return std::tuple(c.package, c.l3, c.core, c.id); };
+        std::sort(order.begin(), order.end(),
+                  [&](const CpuInfo& a, const CpuInfo& b) { return by_location(a) < by_location(b); });
+
+        // SMT index: how many earlier CPUs share the core
+        std::vector<std::size_t> smt(order.size(), 0);
+        for (std::size_t i = 1; i < order.size(); ++i) {
+            if (order[i].core == order[i - 1].core && order[i].package == order[i - 1].package) {
+                smt[i] = smt[i - 1] + 1;
+            }
+        }
+        std::vector<std::size_t> rank(order.size());
+        for (std::size_t i = 0; i < rank.size(); ++i) {
+            rank[i] = i;
+        }
+        std::stable_sort(rank.begin(), rank.end(),
+                         [&](std::size_t a, std::size_t b) { return smt[a] < smt[b]; });
+
+        std::vector<CpuInfo> result;
+        result.reserve(order.size());
+        for (std::size_t i : rank) {
+            result.push_back(order[i]);
+        }
+        return result;
+    }
+
+    /**
+     * How far apart two CPUs are: 0 same core or L2, 1 same L3,
+     * 2 same package, 3 different packages.
+     */
+    static int distance(const CpuInfo& a, const CpuInfo& b) noexcept {
+        if (a.id == b.id || (a.package == b.package && a.core == b.core) ||
+            (a.l2 >= 0 && a.l2 == b.l2)) {
+            return 0;
+        }
+        if (a.l3 >= 0 && a.l3 == b.l3) {
+            return 1;
+        }
+        return a.package == b.package ? 2 : 3;
+    }
+
+    /**
+     * Steal victims of worker `self`, nearest tier first; `workers[i]` is
+     * the CPU worker i is pinned to. Empty tiers are left out.
+     */
+    static std::vector<std::vector<std::size_t>> steal_tiers(const std::vector<CpuInfo>& workers,
+                                                             std::size_t                 self) {
+        std::vector<std::vector<std::size_t>> tiers(4);
+        for (std::size_t i = 0; i < workers.size(); ++i) {
+            if (i != self) {
+                tiers[static_cast<std::size_t>(distance(workers[self], workers[i]))].push_back(i);
+            }
+        }
+        std::erase_if(tiers, [](const std::vector<std::size_t>& tier) { return tier.empty(); });
+        return tiers;
+    }
+
+    /**
+     * Parse a kernel CPU list such as "0-3,8,10-11". Malformed parts, and
+     * ids or ranges reaching kMaxCpus, are skipped.
+     */
+    static std::vector<int> parse_cpu_list(std::string_view text) {
+        std::vector<int> ids;
+        while (!text.empty()) {
+            const std::size_t      comma = text.find(',');
+            const std::string_view part  = text.substr(0, comma);
+            text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+
+            int       first = 0;
+            int       last  = 0;
+            std::size_t pos = 0;
+            if (!parse_int(part, pos, first)) {
+                continue;
+            }
+            last = first;
+            if (pos < part.size() && part[pos] == '-' && !parse_int(part, ++pos, last)) {
+                continue;
+            }
+            for (int id = first; id <= last; ++id) {
+                ids.push_back(id);
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+    /**
+     * Pin a thread to one CPU. Returns false where that is not supported
+     * or not permitted; the thread then stays unpinned.
+     */
+    static bool pin_thread(std::thread& thread, int cpu) noexcept {
+#if defined(__linux__)
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+        (void)thread;
+        (void)cpu;
+        return false;
+#endif
+    }
+
+private:
+    // Sorted CPUs this process may run on; empty if unknown
+    static std::vector<int> allowed_cpus() {
+        std::vector<int> ids;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int id = 0; id < CPU_SETSIZE; ++id) {
+                if (CPU_ISSET(id, &set)) {
+                    ids.push_back(id);
+                }
+            }
+        }
+#endif
+        return ids;
+    }
+
+    static bool parse_int(std::string_view text, std::size_t& pos, int& value) {
+        while (pos < text.size() && text[pos] == ' ') {
+            ++pos;
+        }
+        const std::size_t start = pos;
+        bool              fits  = true;
+        value                   = 0;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            if (fits) {
+                value = value * 10 + (text[pos] - '0');  // < 10 * kMaxCpus
+                fits  = value < kMaxCpus;
+            }
+            ++pos;
+        }
+        return pos > start && fits;
+    }
+
+    static std::string read_file(const std::string& path) {
+        std::ifstream in(path);
+        std::string   line;
+        std::getline(in, line);
+        return line;
+    }
+
+    static int read_int(const std::string& path, int fallback) {
+        const std::string text = read_file(path);
+        std::size_t       pos  = 0;
+        int               value = 0;
+        return parse_int(text, pos, value) ? value : fallback;
+    }
+
+    // Lowest CPU in a list, or `fallback` if the list is empty
+    static int lowest(const std::string& list, int fallback) {
+        const std::vector<int> ids = parse_cpu_list(list);
+        return ids.empty() ? fallback : ids.front();
+    }
+
+    std::vector<CpuInfo> cpus_;
+    bool                 known_ = false;
+};
+
+} // namespace thread_pool
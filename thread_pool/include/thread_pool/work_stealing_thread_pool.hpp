@@ -1,46 +1,152 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <coroutine>
 #include <cstddef>
-#include <deque>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <future>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <stdexcept>
 #include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "thread_pool/block_pool.hpp"
+#include "thread_pool/chase_lev_deque.hpp"
+#include "thread_pool/metrics.hpp"
+#include "thread_pool/priority.hpp"
+#include "thread_pool/task.hpp"
+#include "thread_pool/timer_wheel.hpp"
+#include "thread_pool/topology.hpp"
+
 namespace thread_pool {
 
 /**
  * Work-stealing thread pool with per-thread task queues and futures.
  * 
  * DESIGN OVERVIEW:
- * - Each worker thread has its own deque of tasks (task affinity)
+ * - Each worker thread has its own lock-free Chase-Lev deque of tasks
+ *   (chase_lev_deque.hpp)
  * - Work stealing: idle workers attempt to steal tasks from others
- * - Global condition variable for signaling work availability
+ * - Idle workers park individually (one futex word each, via
+ *   std::atomic::wait); there is no shared condition variable
  * 
  * SCHEDULING POLICY:
- * - When a task is submitted, it's enqueued to a worker in round-robin
- * - Worker executes from local queue (LIFO: pop from back)
- * - When local queue empty, steal from other workers (FIFO: pop from front)
- * 
+ * - A task submitted from one of this pool's workers goes onto that
+ *   worker's own deque (only the owner may push to a Chase-Lev deque)
+ * - A task submitted from any other thread goes into the injector queue
+ * - Worker executes from local deque (LIFO: pop from bottom), then from the
+ *   injector, then steals from other workers (FIFO: steal from top)
+ * - Each steal starts at a random victim, so thieves do not all converge
+ *   on worker 0 and trail each other around the ring
+ *
+ * AFFINITY (SchedulingConfig::pin_workers, topology.hpp):
+ * - Off by default: threads float and victims form a single tier
+ * - On: worker i is pinned to CpuTopology::placement()[i] (one hardware
+ *   thread per core first) and steals in tiers: workers sharing its core
+ *   or L2, then its L3, then its package, then the rest. Stolen work
+ *   then mostly stays within a cache domain.
+ * - Topology comes from /sys/devices/system/cpu; without it the tiers
+ *   collapse into one and pinning is attempted anyway. A CPU that cannot
+ *   be pinned to leaves its worker unpinned (worker_cpu() == -1).
+ *
+ * PRIORITIES (priority.hpp):
+ * - Every task has a class (high / normal / low); each worker has one
+ *   deque per class and so does the injector. A task posted without
+ *   options from inside a running task inherits that task's class
+ *   (children of request work stay request work), otherwise it is normal.
+ * - A worker takes from the highest non-empty class: local deque, then
+ *   injector, then steal, class by class
+ * - Aging: a lower class that has gone without being served for its
+ *   SchedulingConfig::aging limit gets one task ahead of the higher
+ *   classes. Clocks are per worker, so bulk work parked on one worker's
+ *   deque cannot be starved by another worker reporting it empty.
+ * - Deadlines: a task with TaskOptions::deadline also goes into a
+ *   deadline heap; once within promotion_window of its deadline, the next
+ *   worker to schedule runs it ahead of every class. Whichever of the heap
+ *   and the class queue yields it first runs it (an atomic claim); the
+ *   other copy is dropped when reached.
+ * - Queueing latency (enqueue until taken) of a sample of the tasks is
+ *   recorded per class in log2 histograms, see queue_latency()
+ *
+ * TIMERS (timer_wheel.hpp):
+ * - submit_after / submit_at / schedule_periodic park the task in a
+ *   hierarchical timing wheel with kTimerTick (1 ms) ticks instead of a
+ *   sleeping thread or a sleeping task
+ * - One timer thread, started by the first timer, sleeps until the
+ *   wheel's next event and hands every task that expired on it to the
+ *   injectors as one batch per class (one lock each, one wake-up)
+ * - The TaskNode a timer is queued in is allocated when it is armed, so
+ *   the timer thread never allocates. Fired tasks are sampled for
+ *   queue_latency() like submitted ones, timed from when they fire.
+ * - Tasks never run early; they run late by up to a tick plus queueing.
+ *   They take the class of the task that scheduled them.
+ * - Cancellation through the returned handle is O(1): an unlink from the
+ *   wheel under the timer mutex. Timer nodes are recycled, never freed
+ *   before the pool, so a stale handle is detected by a generation count.
+ * - A periodic task is re-armed after each run, so runs never overlap;
+ *   periods it fell behind on are skipped
+ *
+ * METRICS (metrics.hpp):
+ * - Built with THREAD_POOL_METRICS=1, each worker counts the tasks it
+ *   runs and where it got them (own deque, injector, steal), failed
+ *   steal scans, parks and wake-ups, and its busy / parked time; for the
+ *   tasks sampled for queueing latency it also records run time and the
+ *   queue depth it saw. metrics() gathers it all, to_json() dumps it.
+ * - Counters live in the worker's own cache line and are written only
+ *   by it, without atomic RMW. Clocks are read only around parking and
+ *   for sampled tasks.
+ * - Off by default: the hooks are empty inline functions and the
+ *   scheduler compiles to what it is without them
+ *
+ * ALLOCATION:
+ * - Tasks are move-only Task objects (task.hpp) with 64 bytes of inline
+ *   storage, so small callables are not boxed
+ * - Each task lives in a TaskNode from BlockPool (block_pool.hpp), a
+ *   thread-cached recycling allocator; the injector links nodes
+ *   intrusively, so queueing does not allocate either
+ * - In steady state, post()/execute() of a small callable performs no
+ *   heap allocation, and neither does submit() (see FUTURES)
+ *
  * THREAD SAFETY:
- * - Per-queue mutex: protects individual task deques
- * - Global mutex + condition variable: for shutdown signaling
- * - Atomic next_worker_: tracks round-robin submission index
- * - No lock-free algorithms here (favor clarity over extreme performance)
- * 
+ * - Worker deques: lock-free. Local push/pop use no atomic RMW except when
+ *   racing a thief for the last task; a steal is one CAS
+ * - Injector: one mutex-protected intrusive list per class, touched once
+ *   per external submission
+ * - Parking (Go / Tokio scheduler style):
+ *   - A worker that finds nothing locally becomes a *searching* thief,
+ *     but only while searchers are fewer than half the awake workers
+ *     (spinning_); the rest park right away
+ *   - A parked worker sits on its own Parker, listed in idle_ (mutex-
+ *     protected; the mutex is only taken to park and to wake)
+ *   - A submit wakes at most one parked worker, and only if nobody is
+ *     searching and somebody is parked: a searcher will find the task
+ *     anyway. Busy pools and pools with a searcher never take a lock.
+ *   - The woken worker starts out searching. A searcher that finds work
+ *     and was the last searcher wakes another, so parallelism ramps up
+ *     one worker at a time instead of as a thundering herd.
+ *
  * FUTURES:
- * - std::packaged_task wraps user functions
- * - Returns std::future immediately
- * - Blocked calling thread can get_future() to wait
- * 
+ * - submit() returns a std::future immediately; its std::promise is built
+ *   with PoolAllocator, so the shared state comes from BlockPool
+ * - post()/execute() are fire-and-forget: no future, no shared state.
+ *   An exception escaping such a task calls std::terminate (as it would on
+ *   a std::thread); use submit() to get exceptions back
+ *
  * TERMINATION:
- * - Destructor sets stop flag and notifies all
+ * - Destructor stops the timer thread and drops timers that have not
+ *   fired (their futures report broken_promise), then sets the stop flag
+ *   and unparks every worker
  * - Threads drain remaining work before exiting
  * 
  * EXAMPLE:
@@ -49,48 +155,82 @@ namespace thread_pool {
  *   int result = fut.get();  // blocks until ready
  */
 class WorkStealingThreadPool {
+    struct TimerNode;
+
 public:
-    using Task = std::function<void()>;
+    using Task = thread_pool::Task;
 
     /**
      * Construct with specified thread count.
      * If thread_count is 0, defaults to hardware_concurrency().
-     * Each thread gets its own work-stealing deque.
+     * Each thread gets its own work-stealing deques (one per class).
      */
     explicit WorkStealingThreadPool(std::size_t thread_count =
-        std::thread::hardware_concurrency())
-        : stop_(false)
+        std::thread::hardware_concurrency(), const SchedulingConfig& config = {})
+        : promotion_window_ns_(config.promotion_window.count()),
+          latency_sample_period_(config.latency_sample_period), stop_(false)
     {
         if (thread_count == 0) {
             thread_count = 1;
         }
+        for (std::size_t cls = 0; cls < kPriorityCount; ++cls) {
+            aging_ns_[cls] = config.aging[cls].count();
+        }
 
         workers_.reserve(thread_count);
+        idle_.reserve(thread_count);  // parking never allocates
         for (std::size_t i = 0; i < thread_count; ++i) {
             workers_.emplace_back(std::make_unique<WorkerQueue>());
         }
 
-        next_worker_.store(0, std::memory_order_relaxed);
+        // CPU per worker when pinning; otherwise one tier of victims
+        std::vector<CpuInfo> cpus;
+        if (config.pin_workers) {
+            const std::vector<CpuInfo> order = CpuTopology::detect().placement();
+            for (std::size_t i = 0; i < thread_count; ++i) {
+                cpus.push_back(order[i % order.size()]);
+            }
+        }
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            WorkerQueue& w = *workers_[i];
+            const std::vector<std::vector<std::size_t>> tiers = cpus.empty()
+                ? std::vector<std::vector<std::size_t>>{all_but(i)}
+                : CpuTopology::steal_tiers(cpus, i);
+            for (const auto& tier : tiers) {
+                w.victims.insert(w.victims.end(), tier.begin(), tier.end());
+                w.tier_ends.push_back(w.victims.size());
+            }
+            w.steal_rng = 0x9E3779B97F4A7C15ull * (i + 1);
+        }
 
         // Launch worker threads
         for (std::size_t i = 0; i < thread_count; ++i) {
             threads_.emplace_back([this, i] { worker_loop(i); });
+            if (!cpus.empty() && CpuTopology::pin_thread(threads_.back(), cpus[i].id)) {
+                workers_[i]->cpu = cpus[i].id;
+            }
         }
     }
 
     ~WorkStealingThreadPool()
     {
-        {
-            std::lock_guard<std::mutex> lk(global_mutex_);
-            stop_.store(true, std::memory_order_relaxed);
+        stop_timers();
+
+        stop_.store(true, std::memory_order_seq_cst);
+        for (auto& w : workers_) {
+            w->parker.unpark();
         }
-        global_cv_.notify_all();
 
         for (auto& t : threads_) {
             if (t.joinable()) {
                 t.join();
             }
         }
+
+        // Deadline entries whose task already ran from its class queue
+        for (TaskNode* node : deadline_heap_) {
+            release(node);
+        }
     }
 
     WorkStealingThreadPool(const WorkStealingThreadPool&)            = delete;
@@ -106,25 +246,193 @@ public:
      *   auto fut = pool->submit(myfunc, arg1, arg2);
      *   auto result = fut.get();  // blocks until ready
      * 
-     * THREAD SAFETY: Safe to call from any thread.
-     * BLOCKING: Never blocks; task is queued immediately.
+     * THREAD SAFETY: Safe to call from any thread. From a worker of this
+     * pool the task goes onto that worker's own deque.
+     * BLOCKING: Never blocks on other tasks; task is queued immediately.
      */
     template <typename F, typename... Args>
     auto submit(F&& f, Args&&... args)
         -> std::future<std::invoke_result_t<F, Args...>>
+    {
+        return submit(inherited_options(), std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    /**
+     * submit() with a priority class and/or deadline.
+     *
+     * USAGE:
+     *   auto fut = pool.submit({.priority = Priority::high}, handle, request);
+     */
+    template <typename F, typename... Args>
+    auto submit(TaskOptions options, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>
     {
         using R = std::invoke_result_t<F, Args...>;
 
-        auto task_ptr =
-            std::make_shared<std::packaged_task<R()>>(
-                std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        // Shared state from BlockPool instead of operator new
+        std::promise<R> promise(std::allocator_arg, PoolAllocator<char>{});
+        std::future<R>  fut = promise.get_future();
+
+        enqueue_task(promise_task(std::move(promise), std::forward<F>(f),
+                                  std::forward<Args>(args)...), options);
+        return fut;
+    }
+
+    /**
+     * Fire-and-forget: run f(args...) on the pool, no future.
+     *
+     * Cheaper than submit(): no promise, no shared state, no result
+     * transfer. The callable must not throw; an escaping exception calls
+     * std::terminate.
+     *
+     * THREAD SAFETY: Same as submit().
+     */
+    template <typename F, typename... Args>
+    void post(F&& f, Args&&... args)
+    {
+        post(inherited_options(), std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    /**
+     * post() with a priority class and/or deadline.
+     */
+    template <typename F, typename... Args>
+    void post(TaskOptions options, F&& f, Args&&... args)
+    {
+        if constexpr (sizeof...(Args) == 0) {
+            enqueue_task(Task(std::forward<F>(f)), options);
+        } else {
+            enqueue_task(Task([fn = std::forward<F>(f),
+                               ... bound = std::forward<Args>(args)]() mutable {
+                std::invoke(fn, std::move(bound)...);
+            }), options);
+        }
+    }
+
+    /**
+     * Fire-and-forget for an already-built task (executor-style name).
+     * Equivalent to post(std::move(task)).
+     */
+    void execute(Task task)
+    {
+        enqueue_task(std::move(task), inherited_options());
+    }
 
-        std::future<R> fut = task_ptr->get_future();
+    void execute(TaskOptions options, Task task)
+    {
+        enqueue_task(std::move(task), options);
+    }
 
-        Task wrapper = [task_ptr]() { (*task_ptr)(); };
+    static constexpr std::chrono::milliseconds kTimerTick{1};  // timer wheel resolution
 
-        enqueue_task(std::move(wrapper));
-        return fut;
+    /**
+     * Handle to a pending timer (submit_after / submit_at /
+     * schedule_periodic). Cheap to copy; must not outlive the pool.
+     */
+    class TimerHandle {
+    public:
+        TimerHandle() = default;
+
+        /**
+         * Stop the timer. A one-shot task that has not fired is dropped
+         * (its future reports std::future_errc::broken_promise); a
+         * periodic task runs no more, though a run already started
+         * finishes.
+         * Returns false if the task already fired or was cancelled. O(1).
+         */
+        bool cancel()
+        {
+            return pool_ != nullptr && pool_->cancel_timer(node_, generation_);
+        }
+
+    private:
+        friend class WorkStealingThreadPool;
+
+        TimerHandle(WorkStealingThreadPool* pool, TimerNode* node, std::uint32_t generation) noexcept
+            : pool_(pool), node_(node), generation_(generation) {}
+
+        WorkStealingThreadPool* pool_ = nullptr;
+        TimerNode*              node_ = nullptr;
+        std::uint32_t           generation_ = 0;
+    };
+
+    /**
+     * Future of a delayed task that can also cancel it.
+     */
+    template <typename R>
+    class ScheduledFuture : public std::future<R> {
+    public:
+        ScheduledFuture() = default;
+
+        // See TimerHandle::cancel()
+        bool cancel() { return timer_.cancel(); }
+
+        [[nodiscard]] TimerHandle timer() const noexcept { return timer_; }
+
+    private:
+        friend class WorkStealingThreadPool;
+
+        ScheduledFuture(std::future<R>&& fut, TimerHandle timer) noexcept
+            : std::future<R>(std::move(fut)), timer_(timer) {}
+
+        TimerHandle timer_;
+    };
+
+    /**
+     * submit() once `delay` has passed.
+     *
+     * USAGE:
+     *   auto fut = pool.submit_after(50ms, retry, request);
+     *   fut.cancel();  // if the retry is no longer needed
+     *
+     * THREAD SAFETY: Safe to call from any thread.
+     */
+    template <typename Rep, typename Period, typename F, typename... Args>
+    auto submit_after(std::chrono::duration<Rep, Period> delay, F&& f, Args&&... args)
+        -> ScheduledFuture<std::invoke_result_t<F, Args...>>
+    {
+        return submit_at(std::chrono::steady_clock::now() + delay, std::forward<F>(f),
+                         std::forward<Args>(args)...);
+    }
+
+    /**
+     * submit() at time `when` (at once if it has passed).
+     */
+    template <typename F, typename... Args>
+    auto submit_at(std::chrono::steady_clock::time_point when, F&& f, Args&&... args)
+        -> ScheduledFuture<std::invoke_result_t<F, Args...>>
+    {
+        using R = std::invoke_result_t<F, Args...>;
+
+        std::promise<R> promise(std::allocator_arg, PoolAllocator<char>{});
+        std::future<R>  fut = promise.get_future();
+
+        TimerHandle timer = start_timer(promise_task(std::move(promise), std::forward<F>(f),
+                                                     std::forward<Args>(args)...),
+                                        tick_at(when), 0);
+        return ScheduledFuture<R>(std::move(fut), timer);
+    }
+
+    /**
+     * Post f every `period` (rounded up to kTimerTick), first one period
+     * from now, until cancelled through the returned handle or until the
+     * pool is destroyed. f must not throw (as with post()).
+     *
+     * USAGE:
+     *   auto flush = pool.schedule_periodic(100ms, [&log] { log.flush(); });
+     *   ...
+     *   flush.cancel();
+     */
+    template <typename Rep, typename Period, typename F>
+    TimerHandle schedule_periodic(std::chrono::duration<Rep, Period> period, F&& f)
+    {
+        if (period <= period.zero()) {
+            throw std::invalid_argument("schedule_periodic: period must be positive");
+        }
+        const std::uint64_t ticks = std::max<std::uint64_t>(
+            1, static_cast<std::uint64_t>(std::chrono::ceil<std::chrono::milliseconds>(period) / kTimerTick));
+        return start_timer(Task(std::forward<F>(f)),
+                           tick_at(std::chrono::steady_clock::now() + period), ticks);
     }
 
     /**
@@ -135,41 +443,817 @@ public:
         return workers_.size();
     }
 
+    /**
+     * Queueing latency histogram of one class (enqueue until a thread
+     * takes the task), summed over all threads. Approximate while tasks
+     * are running.
+     */
+    [[nodiscard]] LatencyHistogram::Snapshot queue_latency(Priority priority) const noexcept
+    {
+        const std::size_t          cls = priority_index(priority);
+        LatencyHistogram::Snapshot total = external_latency_[cls].snapshot();
+        for (auto& w : workers_) {
+            total += w->latency[cls].snapshot();
+        }
+        return total;
+    }
+
+    /**
+     * Scheduler metrics: per-worker counters and the run time and queue
+     * depth histograms (see METRICS), plus queue_latency() of each class.
+     * Counters stay zero unless built with THREAD_POOL_METRICS=1.
+     */
+    [[nodiscard]] SchedulerMetrics metrics() const
+    {
+        SchedulerMetrics result;
+        result.workers.reserve(workers_.size());
+        for (auto& w : workers_) {
+            result.workers.push_back(w->counters.snapshot());
+            w->counters.add_histograms(result.run_time, result.queue_depth);
+        }
+        external_counters_.add_histograms(result.run_time, result.queue_depth);
+        for (std::size_t cls = 0; cls < kPriorityCount; ++cls) {
+            result.start_latency[cls] = queue_latency(static_cast<Priority>(cls));
+        }
+        return result;
+    }
+
+    /**
+     * Run one queued task on the calling thread, if there is one, chosen
+     * like a worker would: a promoted deadline task, else by class from
+     * the caller's own deques (when it is a worker of this pool) and the
+     * injectors, else a steal. Returns false if nothing was found.
+     *
+     * Lets a thread that waits for its subtasks help instead of blocking
+     * (see parallel_algorithms.hpp). Safe to call from any thread.
+     */
+    bool try_run_pending_task()
+    {
+        const bool        worker = tls_pool_ == this;
+        const std::size_t self   = worker ? tls_index_ : workers_.size();
+        LazyClock         clock;
+        TaskNode*         task = nullptr;
+        if (!find_task(self, false, clock, task) && !find_task(self, true, clock, task)) {
+            return false;
+        }
+        if (worker) {
+            count_pick(self, task);
+            run(task, clock, workers_[self]->latency, workers_[self]->counters);
+        } else {
+            run(task, clock, external_latency_, external_counters_);
+        }
+        return true;
+    }
+
+    /**
+     * CPU worker `index` is pinned to, or -1 if it is not pinned (see
+     * SchedulingConfig::pin_workers).
+     */
+    [[nodiscard]] int worker_cpu(std::size_t index) const noexcept
+    {
+        return workers_[index]->cpu;
+    }
+
+    /**
+     * True if the calling thread is one of this pool's workers.
+     */
+    [[nodiscard]] bool in_worker_thread() const noexcept
+    {
+        return tls_pool_ == this;
+    }
+
+    /**
+     * Tasks waiting in the calling worker's own deque (approximate: thieves
+     * may be taking some). 0 when not called from a worker of this pool.
+     */
+    [[nodiscard]] std::size_t local_queue_size() const noexcept
+    {
+        if (tls_pool_ != this) {
+            return 0;
+        }
+        std::size_t total = 0;
+        for (auto& deque : workers_[tls_index_]->tasks) {
+            total += deque.size();
+        }
+        return total;
+    }
+
+    /**
+     * Run queued tasks on the calling thread until done() returns true.
+     *
+     * The non-blocking way to wait for subtasks from inside a worker: a
+     * worker that calls future.get() instead stops taking work, and enough
+     * of those deadlock the pool. Yields when there is nothing to run.
+     * See TaskGroup (task_group.hpp) for the usual spawn + wait pattern.
+     *
+     * USAGE:
+     *   auto fut = pool.submit(child);
+     *   pool.help_until([&] {
+     *       return fut.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+     *   });
+     */
+    template <typename Pred>
+    void help_until(Pred&& done)
+    {
+        while (!done()) {
+            if (!try_run_pending_task()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * Awaitable that moves the awaiting coroutine onto this pool:
+     * `co_await pool.schedule();` suspends, posts the resumption, and
+     * continues on a worker. Awaited from a worker, it requeues the
+     * coroutine on that worker's own deque (a yield point).
+     * See coroutine.hpp for the coroutine Task type.
+     */
+    class ScheduleAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            pool_.post([handle] { handle.resume(); });
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        friend class WorkStealingThreadPool;
+
+        explicit ScheduleAwaiter(WorkStealingThreadPool& pool) noexcept : pool_(pool) {}
+
+        WorkStealingThreadPool& pool_;
+    };
+
+    [[nodiscard]] ScheduleAwaiter schedule() noexcept
+    {
+        return ScheduleAwaiter(*this);
+    }
+
 private:
-    // Per-worker task queue with associated mutex
+    // A queued task. Allocated from BlockPool; `next` links it into the
+    // injector without a container allocation.
+    //
+    // A task with a deadline is referenced twice, from its class queue and
+    // from the deadline heap: whoever wins `claimed` runs it, and the last
+    // of the two references frees it.
+    struct TaskNode {
+        TaskNode(Task&& t, Priority p) noexcept : task(std::move(t)), priority(p) {}
+
+        Task                      task;
+        TaskNode*                 next{nullptr};
+        std::int64_t              enqueued_ns{0};  // 0: not sampled for latency
+        std::int64_t              deadline_ns{0};  // 0: no deadline
+        std::atomic<std::uint8_t> refs{1};         // only used with a deadline
+        std::atomic<bool>         claimed{false};  // only used with a deadline
+        Priority                  priority;
+    };
+
+    static TaskNode* make_node(Task&& task, Priority priority)
+    {
+        void* block = BlockPool::allocate(sizeof(TaskNode));
+        return ::new (block) TaskNode(std::move(task), priority);
+    }
+
+    static void free_node(TaskNode* node) noexcept
+    {
+        node->~TaskNode();
+        BlockPool::deallocate(node, sizeof(TaskNode));
+    }
+
+    // The task submit() queues: runs f(args...) into the promise
+    template <typename R, typename F, typename... Args>
+    static Task promise_task(std::promise<R>&& promise, F&& f, Args&&... args)
+    {
+        return Task([promise = std::move(promise), fn = std::forward<F>(f),
+                     ... bound = std::forward<Args>(args)]() mutable {
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    std::invoke(fn, std::move(bound)...);
+                    promise.set_value();
+                } else {
+                    promise.set_value(std::invoke(fn, std::move(bound)...));
+                }
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        });
+    }
+
+    // A delayed or periodic task. Owned by timer_nodes_ and recycled
+    // through free_timers_; all fields are guarded by timer_mutex_.
+    struct TimerNode : TimerEntry {
+        Task              task;
+        TaskNode*         ready{nullptr};  // queued in when it fires (allocated when armed)
+        std::uint64_t     period{0};      // ticks; 0: one-shot
+        std::uint32_t     generation{0};  // bumped on recycling, invalidates handles
+        Priority          priority{Priority::normal};
+        std::atomic<bool> cancelled{false};  // periodic, cancelled while handed to the pool
+        TimerNode*        next_free{nullptr};
+    };
+
+    /**
+     * One worker's sleep slot: a futex word (std::atomic::wait).
+     * unpark() before park() is not lost: park() consumes the token and
+     * returns immediately.
+     */
+    struct Parker {
+        void park() noexcept
+        {
+            while (token.exchange(0, std::memory_order_acquire) == 0) {
+                token.wait(0, std::memory_order_relaxed);
+            }
+        }
+
+        void unpark() noexcept
+        {
+            token.store(1, std::memory_order_release);
+            token.notify_one();
+        }
+
+        std::atomic<std::uint32_t> token{0};
+    };
+
+    // Metrics hooks; empty unless THREAD_POOL_METRICS
+    using Counters = std::conditional_t<kMetricsEnabled, detail::WorkerCounters, detail::NoCounters>;
+
+    // Per-worker state. The deques hold pointers: thieves read slots
+    // speculatively, so items must be trivially copyable.
     struct WorkerQueue {
-        std::deque<Task> tasks;  // task deque (supports pop_back and pop_front)
-        std::mutex       mutex;  // protects tasks list
+        // One per class; owner: push/pop bottom, thieves: steal top
+        std::array<ChaseLevDeque<TaskNode*>, kPriorityCount> tasks;
+        std::array<std::int64_t, kPriorityCount> waiting_since{};  // owner only (aging), 0: not waiting
+        std::uint32_t aging_skips{0};  // picks since take_aged last looked (owner only)
+        bool          aging{false};    // some waiting_since is running (owner only)
+        std::array<LatencyHistogram, kPriorityCount> latency;    // tasks this worker took
+        [[no_unique_address]] Counters counters;  // metrics, owner writes only
+        std::vector<std::size_t> victims;    // steal order: nearest cache tier first
+        std::vector<std::size_t> tier_ends;  // end of each tier in victims
+        std::uint64_t            steal_rng{0};  // owner only: random start within a tier
+        int                      cpu{-1};       // pinned to; -1: not pinned
+        alignas(64) Parker parker;       // own cache line: written by wakers
+        bool parked{false};              // listed in idle_ (guarded by idle_mutex_)
+    };
+
+    // FIFO of tasks of one class submitted from outside the pool
+    struct alignas(64) Injector {
+        void push(TaskNode* node)
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            if (tail) {
+                tail->next = node;
+            } else {
+                head = node;
+            }
+            tail = node;
+            size.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Append `count` nodes linked through `next`, under one lock
+        void push_batch(TaskNode* first, TaskNode* last, std::size_t count)
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            if (tail) {
+                tail->next = first;
+            } else {
+                head = first;
+            }
+            tail = last;
+            size.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        bool pop(TaskNode*& out)
+        {
+            if (size.load(std::memory_order_relaxed) == 0) {
+                return false;  // skip the lock; a racing push re-notifies
+            }
+            std::lock_guard<std::mutex> lk(mutex);
+            if (!head) {
+                return false;
+            }
+            out  = head;
+            head = out->next;
+            if (!head) {
+                tail = nullptr;
+            }
+            size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        TaskNode*                head{nullptr};
+        TaskNode*                tail{nullptr};
+        std::mutex               mutex;    // protects head/tail
+        std::atomic<std::size_t> size{0};  // readable without the mutex
     };
 
+    static std::int64_t clock_ns() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // Reads the clock at most once per scheduling decision, and only if
+    // something needs it (a clock read costs as much as a whole post)
+    class LazyClock {
+    public:
+        std::int64_t now() noexcept
+        {
+            if (ns_ == 0) {
+                ns_ = clock_ns();
+            }
+            return ns_;
+        }
+
+    private:
+        std::int64_t ns_ = 0;
+    };
+
+    // Options for a task posted without any: the running task's class
+    static TaskOptions inherited_options() noexcept
+    {
+        return TaskOptions{tls_priority_, std::nullopt};
+    }
+
     /**
-     * Enqueue a task to a worker thread (round-robin selection).
-     * next_worker_ is incremented in atomic fashion to distribute load.
-     * Only uses relaxed memory order since this is just scheduling.
+     * Enqueue a task: onto the calling worker's own deque of its class
+     * when called from inside this pool, otherwise into the class's
+     * injector; plus the deadline heap if it has a deadline.
      */
-    void enqueue_task(Task task)
+    void enqueue_task(Task&& task, const TaskOptions& options)
     {
-        const std::size_t n = workers_.size();
-        const std::size_t idx =
-            next_worker_.fetch_add(1, std::memory_order_relaxed) % n;
+        const std::size_t cls  = priority_index(options.priority);
+        TaskNode*         node = make_node(std::move(task), options.priority);
+        sample_latency(node);
+        if (options.deadline) {
+            node->deadline_ns = std::max<std::int64_t>(
+                1, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       options.deadline->time_since_epoch()).count());
+            node->refs.store(2, std::memory_order_relaxed);
+            try {
+                watch_deadline(node);
+            } catch (...) {
+                free_node(node);  // not in the heap: push_back is all or nothing
+                throw;
+            }
+        }
+
+        if (tls_pool_ == this) {
+            try {
+                workers_[tls_index_]->tasks[cls].push(node);  // may grow the deque
+            } catch (...) {
+                if (node->deadline_ns != 0 && !unwatch_deadline(node)) {
+                    release(node);  // already promoted and running: it was queued after all
+                    return;
+                }
+                free_node(node);
+                throw;
+            }
+        } else {
+            injectors_[cls].push(node);
+        }
 
+        notify_one_idle();
+    }
+
+    // Time every latency_sample_period_-th node this thread queues, for
+    // queue_latency()
+    void sample_latency(TaskNode* node) noexcept
+    {
+        if (latency_sample_period_ != 0 && ++tls_unsampled_ >= latency_sample_period_) {
+            tls_unsampled_    = 0;
+            node->enqueued_ns = clock_ns();
+        }
+    }
+
+    // Earliest deadline first
+    static bool later_deadline(const TaskNode* a, const TaskNode* b) noexcept
+    {
+        return a->deadline_ns > b->deadline_ns;
+    }
+
+    void watch_deadline(TaskNode* node)
+    {
+        std::lock_guard<std::mutex> lk(deadline_mutex_);
+        drop_claimed_deadlines();
+        deadline_heap_.push_back(node);
+        std::push_heap(deadline_heap_.begin(), deadline_heap_.end(), later_deadline);
+        next_deadline_ns_.store(deadline_heap_.front()->deadline_ns, std::memory_order_relaxed);
+    }
+
+    /**
+     * Take back a node whose class-queue push failed: claim it and remove
+     * it from the heap. Returns false if a worker promoted it first (it is
+     * running and holds the heap's reference).
+     */
+    bool unwatch_deadline(TaskNode* node) noexcept
+    {
+        std::lock_guard<std::mutex> lk(deadline_mutex_);
+        if (!claim(node)) {
+            return false;
+        }
+        // Still in the heap: take_promoted pops and claims under this lock
+        std::erase(deadline_heap_, node);
+        std::make_heap(deadline_heap_.begin(), deadline_heap_.end(), later_deadline);
+        next_deadline_ns_.store(deadline_heap_.empty() ? kNoDeadline
+                                                       : deadline_heap_.front()->deadline_ns,
+                                std::memory_order_relaxed);
+        return true;
+    }
+
+    // Pop heap entries whose task already ran from its class queue
+    // (deadline_mutex_ held)
+    void drop_claimed_deadlines() noexcept
+    {
+        while (!deadline_heap_.empty() &&
+               deadline_heap_.front()->claimed.load(std::memory_order_acquire)) {
+            TaskNode* node = deadline_heap_.front();
+            std::pop_heap(deadline_heap_.begin(), deadline_heap_.end(), later_deadline);
+            deadline_heap_.pop_back();
+            release(node);
+        }
+    }
+
+    /**
+     * Take the earliest-deadline task if it is within the promotion
+     * window. One relaxed load when no deadline task is queued; a clock
+     * read plus that load when none is close.
+     */
+    bool take_promoted(LazyClock& clock, TaskNode*& out)
+    {
+        const std::int64_t next = next_deadline_ns_.load(std::memory_order_relaxed);
+        if (next == kNoDeadline || clock.now() + promotion_window_ns_ < next) {
+            return false;
+        }
+        const std::int64_t now = clock.now();
+        std::lock_guard<std::mutex> lk(deadline_mutex_);
+        bool found = false;
+        while (!found) {
+            drop_claimed_deadlines();
+            if (deadline_heap_.empty() ||
+                now + promotion_window_ns_ < deadline_heap_.front()->deadline_ns) {
+                break;
+            }
+            TaskNode* node = deadline_heap_.front();
+            std::pop_heap(deadline_heap_.begin(), deadline_heap_.end(), later_deadline);
+            deadline_heap_.pop_back();
+            if (claim(node)) {
+                out   = node;
+                found = true;
+            } else {
+                release(node);
+            }
+        }
+        next_deadline_ns_.store(deadline_heap_.empty() ? kNoDeadline
+                                                       : deadline_heap_.front()->deadline_ns,
+                                std::memory_order_relaxed);
+        return found;
+    }
+
+    // Decide who runs a task taken from a queue (always the taker, unless
+    // the task has a deadline and its other copy was taken first)
+    static bool claim(TaskNode* node) noexcept
+    {
+        return node->deadline_ns == 0 || !node->claimed.exchange(true, std::memory_order_acq_rel);
+    }
+
+    // Drop one reference to a node
+    static void release(TaskNode* node) noexcept
+    {
+        if (node->deadline_ns == 0 || node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            free_node(node);
+        }
+    }
+
+    // Timer ticks since the pool was built, rounded down
+    std::uint64_t current_tick() const noexcept
+    {
+        return static_cast<std::uint64_t>((std::chrono::steady_clock::now() - timer_epoch_) / kTimerTick);
+    }
+
+    // First tick at or after `when`, so timers never fire early
+    std::uint64_t tick_at(std::chrono::steady_clock::time_point when) const noexcept
+    {
+        if (when <= timer_epoch_) {
+            return 0;
+        }
+        const auto since = std::min<std::chrono::steady_clock::duration>(when - timer_epoch_, kTimerHorizon);
+        return static_cast<std::uint64_t>(std::chrono::ceil<std::chrono::milliseconds>(since) / kTimerTick);
+    }
+
+    /**
+     * Put a task on the timer wheel at tick `due`, repeating every
+     * `period` ticks unless 0. A one-shot task already due is enqueued
+     * right away.
+     */
+    TimerHandle start_timer(Task&& task, std::uint64_t due, std::uint64_t period)
+    {
+        const Priority priority = tls_priority_;
+        Task           dropped;  // destroyed after unlocking
         {
-            auto& w = *workers_[idx];
-            std::lock_guard<std::mutex> lk(w.mutex);
-            w.tasks.emplace_back(std::move(task));
+            std::lock_guard<std::mutex> lk(timer_mutex_);
+            if (timers_stopped_) {
+                dropped = std::move(task);  // scheduled while the pool shuts down
+                return TimerHandle{};
+            }
+            if (period != 0 || due > timer_wheel_.now()) {
+                if (!timer_thread_.joinable()) {
+                    timer_thread_ = std::thread([this] { timer_loop(); });
+                }
+                TaskNode*  ready = make_node(Task{}, priority);
+                TimerNode* node  = nullptr;
+                try {
+                    node = acquire_timer();
+                } catch (...) {
+                    free_node(ready);
+                    throw;
+                }
+                node->task     = std::move(task);
+                node->ready    = ready;
+                node->period   = period;
+                node->priority = priority;
+                arm_timer(node, due);
+                return TimerHandle(this, node, node->generation);
+            }
+        }
+        // Already due: straight to the queues
+        enqueue_task(std::move(task), TaskOptions{priority, std::nullopt});
+        return TimerHandle{};
+    }
+
+    TimerNode* acquire_timer()
+    {
+        if (!free_timers_) {
+            timer_nodes_.push_back(std::make_unique<TimerNode>());
+            return timer_nodes_.back().get();
+        }
+        TimerNode* node = free_timers_;
+        free_timers_    = node->next_free;
+        return node;
+    }
+
+    // Back on the free list; the task must have been moved out
+    void recycle_timer(TimerNode* node) noexcept
+    {
+        if (node->ready) {
+            free_node(std::exchange(node->ready, nullptr));
+        }
+        ++node->generation;
+        node->cancelled.store(false, std::memory_order_relaxed);
+        node->next_free = free_timers_;
+        free_timers_    = node;
+    }
+
+    // Insert into the wheel (timer_mutex_ held), waking the timer thread
+    // if this is now the earliest event
+    void arm_timer(TimerNode* node, std::uint64_t due)
+    {
+        timer_wheel_.schedule(node, std::max(due, timer_wheel_.now() + 1));
+        if (node->due < timer_wake_tick_) {
+            timer_cv_.notify_one();
+        }
+    }
+
+    bool cancel_timer(TimerNode* node, std::uint32_t generation)
+    {
+        Task dropped;  // destroyed after unlocking: may complete a future
+        {
+            std::lock_guard<std::mutex> lk(timer_mutex_);
+            if (node->generation != generation || node->cancelled.load(std::memory_order_relaxed)) {
+                return false;  // fired, cancelled, or recycled
+            }
+            if (node->scheduled()) {
+                timer_wheel_.cancel(node);
+                dropped = std::move(node->task);
+                recycle_timer(node);
+            } else {
+                node->cancelled.store(true, std::memory_order_relaxed);  // run_periodic recycles it
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Timer thread: advance the wheel to the current tick, hand expired
+     * tasks to the injectors (one batch per class), then sleep until the
+     * wheel's next event or until an earlier timer is armed.
+     */
+    void timer_loop()
+    {
+        struct Batch {
+            TaskNode*   head{nullptr};
+            TaskNode*   tail{nullptr};
+            std::size_t count{0};
+        };
+
+        std::unique_lock<std::mutex> lk(timer_mutex_);
+        while (!timers_stopped_) {
+            std::array<Batch, kPriorityCount> batches{};
+            bool                              expired = false;
+            timer_wheel_.advance(current_tick(), [&](TimerEntry* entry) {
+                auto*     timer = static_cast<TimerNode*>(entry);
+                TaskNode* node  = std::exchange(timer->ready, nullptr);
+                if (timer->period == 0) {
+                    node->task = std::move(timer->task);
+                    recycle_timer(timer);
+                } else {
+                    node->task = Task([this, timer] { run_periodic(timer); });  // inline, no allocation
+                }
+                sample_latency(node);
+                Batch& batch = batches[priority_index(node->priority)];
+                (batch.tail ? batch.tail->next : batch.head) = node;
+                batch.tail = node;
+                ++batch.count;
+                expired = true;
+            });
+
+            if (expired) {
+                lk.unlock();
+                for (std::size_t cls = 0; cls < kPriorityCount; ++cls) {
+                    if (batches[cls].count != 0) {
+                        injectors_[cls].push_batch(batches[cls].head, batches[cls].tail,
+                                                   batches[cls].count);
+                    }
+                }
+                notify_one_idle();  // searchers wake more workers for the rest
+                lk.lock();
+                continue;
+            }
+
+            const std::optional<std::uint64_t> next = timer_wheel_.next_event();
+            timer_wake_tick_ = next ? *next : kNoTimer;
+            if (next) {
+                timer_cv_.wait_until(lk, timer_epoch_ + static_cast<std::int64_t>(*next) * kTimerTick);
+            } else {
+                timer_cv_.wait(lk);
+            }
+            timer_wake_tick_ = 0;  // awake: arm_timer need not notify
+        }
+    }
+
+    // One run of a periodic task, then re-arm it for its next period
+    void run_periodic(TimerNode* timer)
+    {
+        if (!timer->cancelled.load(std::memory_order_relaxed)) {
+            timer->task();  // not touched by anyone else while not in the wheel
+        }
+
+        // Node for the next run. Without one the timer stops: an exception
+        // here would escape a fire-and-forget task.
+        TaskNode* ready = nullptr;
+        try {
+            ready = make_node(Task{}, timer->priority);
+        } catch (const std::bad_alloc&) {
+        }
+
+        Task dropped;
+        std::lock_guard<std::mutex> lk(timer_mutex_);
+        timer->ready = ready;
+        if (!ready || timer->cancelled.load(std::memory_order_relaxed) || timers_stopped_) {
+            dropped = std::move(timer->task);
+            recycle_timer(timer);
+            return;
+        }
+        // Fixed rate, skipping periods missed while the pool was busy
+        const std::uint64_t now  = current_tick();
+        std::uint64_t       next = timer->due + timer->period;
+        if (next <= now) {
+            next += (now - next) / timer->period * timer->period + timer->period;
+        }
+        arm_timer(timer, next);
+    }
+
+    // Drop timers that have not fired and join the timer thread
+    void stop_timers()
+    {
+        std::vector<Task> dropped;
+        {
+            std::lock_guard<std::mutex> lk(timer_mutex_);
+            timers_stopped_ = true;
+            for (auto& node : timer_nodes_) {
+                if (node->scheduled()) {
+                    timer_wheel_.cancel(node.get());
+                    dropped.push_back(std::move(node->task));
+                    recycle_timer(node.get());
+                }
+            }
+        }
+        timer_cv_.notify_one();
+        if (timer_thread_.joinable()) {
+            timer_thread_.join();
+        }
+    }
+
+    /**
+     * After publishing work: wake one parked worker, unless a searcher will
+     * pick the work up anyway or nobody is parked.
+     *
+     * Pairs with the parking path in worker_loop (Dekker-style): the
+     * submitter publishes the task, fences, then reads spinning_/sleepers_;
+     * a worker about to park drops out of spinning_ or joins sleepers_,
+     * fences, then re-checks has_work(). Either the submitter sees that
+     * worker, or the worker sees the task.
+     */
+    void notify_one_idle()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (spinning_.load(std::memory_order_relaxed) != 0 ||
+            sleepers_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        wake_one();
+    }
+
+    /**
+     * Unpark one worker as a searcher. Does nothing if another thread got
+     * to be the (only) new searcher first, so concurrent submits wake one
+     * worker between them, not one each.
+     */
+    void wake_one()
+    {
+        std::size_t expected = 0;
+        if (!spinning_.compare_exchange_strong(expected, 1, std::memory_order_seq_cst)) {
+            return;  // somebody is searching already
+        }
+
+        std::size_t index = 0;
+        {
+            std::lock_guard<std::mutex> lk(idle_mutex_);
+            if (idle_.empty()) {
+                spinning_.fetch_sub(1, std::memory_order_seq_cst);
+                return;
+            }
+            index = idle_.back();
+            idle_.pop_back();
+            workers_[index]->parked = false;
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        workers_[index]->parker.unpark();  // counted in spinning_ on its behalf
+    }
+
+    /**
+     * Become a searching thief, unless enough workers are searching
+     * already (at most half of the awake ones, at least one).
+     */
+    bool begin_search()
+    {
+        const std::size_t awake     = workers_.size() - sleepers_.load(std::memory_order_relaxed);
+        const std::size_t searching = spinning_.load(std::memory_order_relaxed);
+        if (searching > 0 && 2 * searching >= awake) {
+            return false;
+        }
+        spinning_.fetch_add(1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    /**
+     * A searcher found work. If it was the last searcher, wake another one:
+     * where there was one task there are likely more.
+     */
+    void end_search()
+    {
+        if (spinning_.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+            sleepers_.load(std::memory_order_relaxed) != 0) {
+            wake_one();
         }
+    }
 
-        global_cv_.notify_one();  // wake one sleeping worker
+    // Put this worker on the idle list
+    void register_sleeper(std::size_t index)
+    {
+        std::lock_guard<std::mutex> lk(idle_mutex_);
+        workers_[index]->parked = true;
+        idle_.push_back(index);
+        sleepers_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Take this worker off the idle list. Returns false if a waker got to
+    // it first (and counted it as a searcher).
+    bool unregister_sleeper(std::size_t index)
+    {
+        std::lock_guard<std::mutex> lk(idle_mutex_);
+        if (!workers_[index]->parked) {
+            return false;
+        }
+        workers_[index]->parked = false;
+        idle_.erase(std::find(idle_.begin(), idle_.end(), index));
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
     }
 
     /**
      * Main worker loop (runs in each worker thread).
      * 
-     * ALGORITHM:
-     * 1. Try pop from local queue (LIFO: back)
-     * 2. If empty, try steal from other queues (FIFO: front)
-     * 3. If nothing to do, wait on condition variable
-     * 4. Repeat until shutdown
+     * ALGORITHM (see find_task for the order between classes):
+     * 1. Try pop from local deque (LIFO: bottom)
+     * 2. If empty, take the oldest task from the injector
+     * 3. If empty, become a searcher (if allowed) and steal from other
+     *    deques (FIFO: top)
+     * 4. If nothing to do, park on this worker's own Parker
+     * 5. Repeat until shutdown
      * 
      * WHY LIFO for local, FIFO for stealing:
      * - LIFO (own queue): prefers recently-submitted (cache-hot) tasks
@@ -177,91 +1261,369 @@ private:
      */
     void worker_loop(std::size_t index)
     {
+        tls_pool_  = this;
+        tls_index_ = index;
+
+        WorkerQueue& w = *workers_[index];
+        w.counters.start();
+
+        bool searching = false;  // counted in spinning_
         while (true) {
-            Task task;
+            TaskNode* task = nullptr;
+            LazyClock clock;
 
-            // Try local queue first, then steal
-            if (try_pop_local(index, task) || try_steal(index, task)) {
-                task();
+            // Local deques and injected work first, then steal
+            bool found = find_task(index, false, clock, task);
+            if (!found) {
+                if (!searching) {
+                    searching = begin_search();
+                }
+                found = searching && find_task(index, true, clock, task);
+            }
+            if (found) {
+                if (searching) {
+                    searching = false;
+                    end_search();
+                }
+                count_pick(index, task);
+                run(task, clock, w.latency, w.counters);
                 continue;
             }
 
-            // No work found, wait for notification
-            std::unique_lock<std::mutex> lk(global_mutex_);
-            global_cv_.wait(lk, [this] {
-                return stop_.load(std::memory_order_relaxed) || has_work();
-            });
+            if (searching) {
+                // The last searcher to give up re-checks: a submitter may
+                // have skipped waking anyone because it saw us searching
+                searching = false;
+                if (spinning_.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (has_work()) {
+                        searching = begin_search();
+                        continue;
+                    }
+                }
+            }
+
+            if (stop_.load(std::memory_order_seq_cst)) {
+                if (!has_work()) {
+                    break;  // shutdown and no remaining work
+                }
+                continue;
+            }
+
+            register_sleeper(index);
+            std::atomic_thread_fence(std::memory_order_seq_cst);  // see notify_one_idle()
+            if (has_work() || stop_.load(std::memory_order_relaxed)) {
+                if (unregister_sleeper(index)) {
+                    // Work the submitter may not wake anyone for: go get it
+                    spinning_.fetch_add(1, std::memory_order_seq_cst);
+                    searching = true;
+                    continue;
+                }
+                // Already woken: park() below returns at once
+            }
+
+            w.counters.park_begin();
+            w.parker.park();
+
+            // Woken by wake_one() (already counted as searching), or by
+            // the destructor (still listed as idle)
+            searching = !unregister_sleeper(index);
+            w.counters.park_end(searching);
+        }
+
+        w.counters.stop();
+        tls_pool_ = nullptr;
+    }
 
-            if (stop_.load(std::memory_order_relaxed) && !has_work()) {
-                break;  // shutdown and no remaining work
+    /**
+     * One scheduling decision for thread `self` (workers_.size() when not
+     * a worker):
+     * 1. a task within the promotion window of its deadline
+     * 2. a task of a lower class that has waited past its aging limit
+     *    (workers only, see take_aged)
+     * 3. the highest non-empty class
+     * `steal` allows taking from other workers' deques.
+     */
+    bool find_task(std::size_t self, bool steal, LazyClock& clock, TaskNode*& out)
+    {
+        if (take_promoted(clock, out)) {
+            return true;
+        }
+        if (self < workers_.size() && take_aged(self, steal, clock, out)) {
+            return true;
+        }
+        for (std::size_t cls = 0; cls < kPriorityCount; ++cls) {
+            if (take_from_class(cls, self, steal, out)) {
+                return true;
             }
         }
+        return false;
     }
 
     /**
-     * Attempt to pop a task from this worker's local queue (LIFO).
-     * Returns true and fills 'out' if task was found.
+     * Aging. A worker that can see work of a lower class (in its own deque
+     * or the injector) while a higher class also has work starts that
+     * class's waiting clock; once it has waited past its limit, the class
+     * gets the next task. The clock stops when the class is served or
+     * runs dry.
+     *
+     * Checked on every kAgingCheckInterval-th pick until some class is
+     * waiting, then on every pick. When all visible work is in one class,
+     * which is the usual case, this costs a counter increment per pick and
+     * never reads the clock.
      */
-    bool try_pop_local(std::size_t index, Task& out)
+    bool take_aged(std::size_t self, bool steal, LazyClock& clock, TaskNode*& out)
     {
-        auto& w = *workers_[index];
-        std::lock_guard<std::mutex> lk(w.mutex);
-        if (w.tasks.empty()) {
+        WorkerQueue& w = *workers_[self];
+        if (!w.aging && ++w.aging_skips < kAgingCheckInterval) {
             return false;
         }
-        out = std::move(w.tasks.back());  // pop from back (LIFO)
-        w.tasks.pop_back();
+        w.aging_skips = 0;
+        w.aging       = false;
+
+        bool higher = false;  // a higher class has visible work
+        for (std::size_t cls = 0; cls < kPriorityCount; ++cls) {
+            const bool visible = !w.tasks[cls].empty() ||
+                                 injectors_[cls].size.load(std::memory_order_relaxed) != 0;
+            if (!visible || !higher || aging_ns_[cls] == 0) {
+                w.waiting_since[cls] = 0;
+                higher = higher || visible;
+                continue;
+            }
+            w.aging = true;
+            if (w.waiting_since[cls] == 0) {
+                w.waiting_since[cls] = clock.now();
+            } else if (clock.now() - w.waiting_since[cls] > aging_ns_[cls] &&
+                       take_from_class(cls, self, steal, out)) {
+                w.waiting_since[cls] = 0;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Own deque (LIFO), then injector, then (if allowed) steal (FIFO)
+    bool take_from_class(std::size_t cls, std::size_t self, bool steal, TaskNode*& out)
+    {
+        while ((self < workers_.size() && try_pop_local(self, cls, out)) ||
+               pop_injector(self, cls, out) || (steal && try_steal(self, cls, out))) {
+            if (claim(out)) {
+                return true;
+            }
+            release(out);  // already run through the deadline heap
+        }
+        return false;
+    }
+
+    bool pop_injector(std::size_t self, std::size_t cls, TaskNode*& out)
+    {
+        if (!injectors_[cls].pop(out)) {
+            return false;
+        }
+        if (self < workers_.size()) {
+            workers_[self]->counters.injector_pop();
+        }
         return true;
     }
 
     /**
-     * Attempt to steal a task from another worker's queue (FIFO).
-     * Tries all other workers in order starting from next victim.
+     * Run a taken task on this thread and free it. `latency` and
+     * `counters` belong to the calling thread; `clock` is the time the
+     * task was taken.
+     */
+    static void run(TaskNode* node, LazyClock& clock,
+                    std::array<LatencyHistogram, kPriorityCount>& latency, Counters& counters)
+    {
+        const bool sampled = node->enqueued_ns != 0;
+        if (sampled) {
+            latency[priority_index(node->priority)].record(clock.now() - node->enqueued_ns);
+        }
+
+        const Priority outer = std::exchange(tls_priority_, node->priority);
+        node->task();
+        tls_priority_ = outer;
+
+        if constexpr (kMetricsEnabled) {
+            if (sampled) {
+                counters.run_time(clock_ns() - clock.now());
+            }
+        }
+
+        if (node->deadline_ns != 0) {
+            node->task.reset();  // the heap entry may outlive the task
+        }
+        release(node);
+    }
+
+    /**
+     * Attempt to pop a task of one class from this worker's local deque
+     * (LIFO). Returns true and fills 'out' if task was found.
+     */
+    bool try_pop_local(std::size_t index, std::size_t cls, TaskNode*& out)
+    {
+        auto& deque = workers_[index]->tasks[cls];
+        if (deque.empty() || !deque.pop(out)) {  // pop on empty costs a fence
+            return false;
+        }
+        workers_[index]->counters.local_pop();
+        return true;
+    }
+
+    // Metrics: worker `index` is about to run `node`
+    void count_pick(std::size_t index, const TaskNode* node) noexcept
+    {
+        workers_[index]->counters.task();
+        if constexpr (kMetricsEnabled) {
+            if (node->enqueued_ns != 0) {
+                workers_[index]->counters.queue_depth(queued_near(index));
+            }
+        }
+    }
+
+    // Tasks left in worker `index`'s deques and the injectors (metrics)
+    std::size_t queued_near(std::size_t index) const noexcept
+    {
+        std::size_t depth = 0;
+        for (std::size_t cls = 0; cls < kPriorityCount; ++cls) {
+            depth += workers_[index]->tasks[cls].size() +
+                     injectors_[cls].size.load(std::memory_order_relaxed);
+        }
+        return depth;
+    }
+
+    /**
+     * Attempt to steal a task of one class from another worker's deque
+     * (FIFO). Tries every other worker, nearest cache tier first, each
+     * tier from a random starting point; a self_index of workers_.size()
+     * (not a worker) tries every deque in order.
      * Returns true and fills 'out' if a task was stolen.
      */
-    bool try_steal(std::size_t self_index, Task& out)
+    bool try_steal(std::size_t self_index, std::size_t cls, TaskNode*& out)
     {
-        const std::size_t n = workers_.size();
-        for (std::size_t offset = 1; offset < n; ++offset) {
-            const std::size_t victim = (self_index + offset) % n;
-            auto& w = *workers_[victim];
+        // Empty checks first: a failed steal still pays a full fence
+        if (self_index >= workers_.size()) {
+            for (auto& w : workers_) {  // a helping non-worker
+                if (!w->tasks[cls].empty() && w->tasks[cls].steal(out)) {
+                    return true;
+                }
+            }
+            return false;
+        }
 
-            std::lock_guard<std::mutex> lk(w.mutex);
-            if (!w.tasks.empty()) {
-                out = std::move(w.tasks.front());  // pop from front (FIFO)
-                w.tasks.pop_front();
-                return true;
+        // Tier by tier, each from a random victim around
+        WorkerQueue& self  = *workers_[self_index];
+        std::size_t  begin = 0;
+        for (const std::size_t end : self.tier_ends) {
+            std::size_t pos = begin + random_below(self.steal_rng, end - begin);
+            for (std::size_t i = begin; i < end; ++i) {
+                auto& deque = workers_[self.victims[pos]]->tasks[cls];
+                if (!deque.empty() && deque.steal(out)) {
+                    self.counters.steal(true);
+                    return true;
+                }
+                if (++pos == end) {
+                    pos = begin;
+                }
             }
+            begin = end;
         }
+        self.counters.steal(false);
         return false;
     }
 
+    // xorshift64* step, scaled to [0, bound)
+    static std::size_t random_below(std::uint64_t& state, std::size_t bound) noexcept
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        const std::uint64_t r = (state * 0x2545F4914F6CDD1Dull) >> 32;
+        return static_cast<std::size_t>((r * bound) >> 32);
+    }
+
+    // Every worker index except `self`
+    std::vector<std::size_t> all_but(std::size_t self) const
+    {
+        std::vector<std::size_t> others;
+        for (std::size_t i = 0; i < workers_.size(); ++i) {
+            if (i != self) {
+                others.push_back(i);
+            }
+        }
+        return others;
+    }
+
     /**
-     * Check if any worker has pending tasks.
-     * Used in condition variable predicate to wake sleeping workers.
-     * Iterates all queues, so O(n) but only called during waits.
+     * Check if any deque or injector has pending tasks.
+     * Lock-free, O(n) loads; only called on the way to parking (and at
+     * shutdown), never per submit. Deadline tasks are always also in a
+     * class queue until run, so the deadline heap need not be checked.
      */
-    bool has_work()
+    bool has_work() const noexcept
     {
-        for (auto& wptr : workers_) {
-            auto& w = *wptr;
-            std::lock_guard<std::mutex> lk(w.mutex);
-            if (!w.tasks.empty()) {
+        for (auto& injector : injectors_) {
+            if (injector.size.load(std::memory_order_relaxed) != 0) {
                 return true;
             }
         }
+        for (auto& wptr : workers_) {
+            for (auto& deque : wptr->tasks) {
+                if (!deque.empty()) {
+                    return true;
+                }
+            }
+        }
         return false;
     }
 
+    // Worker identity of the calling thread (null outside any pool)
+    static inline thread_local const WorkStealingThreadPool* tls_pool_  = nullptr;
+    static inline thread_local std::size_t                   tls_index_ = 0;
+    // Class of the task the calling thread is running (normal outside tasks)
+    static inline thread_local Priority tls_priority_ = Priority::normal;
+    // Enqueues by the calling thread since it last timed one
+    static inline thread_local std::uint32_t tls_unsampled_ = 0;
+
+    static constexpr std::int64_t  kNoDeadline         = std::numeric_limits<std::int64_t>::max();
+    static constexpr std::uint32_t kAgingCheckInterval = 16;  // picks between idle aging checks
+    static constexpr std::uint64_t kNoTimer = std::numeric_limits<std::uint64_t>::max();
+    // Timers further out are clamped (and fire ~100 years after the pool starts)
+    static constexpr std::chrono::hours kTimerHorizon{24 * 365 * 100};
+
     // Data members
-    std::vector<std::unique_ptr<WorkerQueue>> workers_;  // per-thread task queues
+    std::vector<std::unique_ptr<WorkerQueue>> workers_;  // per-thread task deques
     std::vector<std::thread>                  threads_;  // worker threads
 
-    std::atomic<bool>        stop_;          // shutdown flag
-    std::atomic<std::size_t> next_worker_{0};  // round-robin submission index
+    std::array<Injector, kPriorityCount> injectors_;  // tasks submitted from outside the pool
+
+    std::array<std::int64_t, kPriorityCount> aging_ns_{};  // SchedulingConfig::aging
+    std::int64_t                             promotion_window_ns_;
+    std::uint32_t                            latency_sample_period_;
+
+    std::mutex                deadline_mutex_;  // protects deadline_heap_
+    std::vector<TaskNode*>    deadline_heap_;   // min-heap on deadline_ns
+    std::atomic<std::int64_t> next_deadline_ns_{kNoDeadline};  // heap top, readable without the mutex
+
+    std::array<LatencyHistogram, kPriorityCount> external_latency_;  // tasks run by non-workers
+    Counters                                     external_counters_;  // histograms of non-workers' tasks
+
+    const std::chrono::steady_clock::time_point timer_epoch_ = std::chrono::steady_clock::now();  // tick 0
+    std::mutex                              timer_mutex_;  // protects the timer fields and TimerNodes
+    std::condition_variable                 timer_cv_;     // wakes the timer thread
+    TimerWheel                              timer_wheel_;
+    std::vector<std::unique_ptr<TimerNode>> timer_nodes_;  // every timer node made
+    TimerNode*                              free_timers_{nullptr};
+    std::uint64_t                           timer_wake_tick_{0};  // tick the timer thread sleeps until
+    bool                                    timers_stopped_{false};
+    std::thread                             timer_thread_;  // started by the first timer
+
+    std::atomic<bool> stop_;  // shutdown flag
+
+    alignas(64) std::atomic<std::size_t> spinning_{0};  // workers searching for work
+    alignas(64) std::atomic<std::size_t> sleepers_{0};  // workers parked (== idle_.size())
 
-    std::mutex              global_mutex_;   // protects has_work() checks
-    std::condition_variable global_cv_;      // notifies idle workers of new work
+    std::mutex               idle_mutex_;  // protects idle_ and WorkerQueue::parked
+    std::vector<std::size_t> idle_;        // parked workers, most recent last
 };
 
 } // namespace thread_pool
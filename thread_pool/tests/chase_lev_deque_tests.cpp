@@ -0,0 +1,128 @@
+#include "thread_pool/chase_lev_deque.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using thread_pool::ChaseLevDeque;
+
+static void test_owner_lifo() {
+    ChaseLevDeque<std::intptr_t> dq(4);
+
+    std::intptr_t x = 0;
+    assert(!dq.pop(x));
+    assert(dq.empty());
+
+    for (std::intptr_t i = 1; i <= 3; ++i) {
+        dq.push(i);
+    }
+    assert(dq.size() == 3);
+
+    assert(dq.pop(x) && x == 3);
+    assert(dq.pop(x) && x == 2);
+    assert(dq.pop(x) && x == 1);
+    assert(!dq.pop(x));
+    assert(dq.empty());
+}
+
+static void test_steal_fifo() {
+    ChaseLevDeque<std::intptr_t> dq(4);
+    for (std::intptr_t i = 1; i <= 3; ++i) {
+        dq.push(i);
+    }
+
+    std::intptr_t x = 0;
+    assert(dq.steal(x) && x == 1);
+    assert(dq.pop(x) && x == 3);
+    assert(dq.steal(x) && x == 2);
+    assert(!dq.steal(x));
+    assert(!dq.pop(x));
+}
+
+static void test_grows_and_keeps_order() {
+    ChaseLevDeque<std::intptr_t> dq(2);
+
+    // Leave some stolen gaps at the top so the live range wraps when growing
+    std::intptr_t x = 0;
+    for (std::intptr_t i = 0; i < 3; ++i) {
+        dq.push(i);
+    }
+    assert(dq.steal(x) && x == 0);
+
+    for (std::intptr_t i = 3; i < 1000; ++i) {
+        dq.push(i);
+    }
+    assert(dq.capacity() >= 999);
+    assert(dq.size() == 999);
+
+    assert(dq.steal(x) && x == 1);
+    for (std::intptr_t i = 999; i >= 2; --i) {
+        assert(dq.pop(x) && x == i);
+    }
+    assert(!dq.pop(x));
+}
+
+static void test_concurrent_owner_and_thieves() {
+    // Every item is taken exactly once, by the owner or one of the thieves
+    constexpr int N       = 200000;
+    constexpr int Thieves = 3;
+
+    ChaseLevDeque<std::intptr_t> dq(8);  // small: forces growth under steals
+    std::vector<std::atomic<int>> taken(N);
+    std::atomic<bool> done{false};
+    std::atomic<int>  total{0};
+
+    auto take = [&](std::intptr_t v) {
+        assert(taken[static_cast<std::size_t>(v)].fetch_add(1) == 0);
+        total.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < Thieves; ++t) {
+        thieves.emplace_back([&] {
+            std::intptr_t v = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                if (dq.steal(v)) {
+                    take(v);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            while (dq.steal(v)) {
+                take(v);
+            }
+        });
+    }
+
+    std::intptr_t v = 0;
+    for (int i = 0; i < N; ++i) {
+        dq.push(i);
+        if (i % 3 == 0 && dq.pop(v)) {
+            take(v);
+        }
+    }
+    while (dq.pop(v)) {
+        take(v);
+    }
+    done.store(true, std::memory_order_release);
+
+    for (auto& t : thieves) {
+        t.join();
+    }
+    assert(total.load() == N);
+}
+
+int main() {
+    std::cout << "Running chase_lev_deque tests...\n";
+
+    test_owner_lifo();
+    test_steal_fifo();
+    test_grows_and_keeps_order();
+    test_concurrent_owner_and_thieves();
+
+    std::cout << "All chase_lev_deque tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include "thread_pool/coroutine.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+using thread_pool::WorkStealingThreadPool;
+namespace coro = thread_pool::coro;
+
+static coro::Task<int> value_on_pool(WorkStealingThreadPool& pool, int value)
+{
+    co_await pool.schedule();
+    co_return value;
+}
+
+static coro::Task<int> ready_value(int value)
+{
+    co_return value;
+}
+
+static void test_schedule_moves_to_worker()
+{
+    WorkStealingThreadPool pool(2);
+
+    auto on_worker = [](WorkStealingThreadPool& p) -> coro::Task<bool> {
+        const bool before = p.in_worker_thread();
+        co_await p.schedule();
+        co_return !before && p.in_worker_thread();
+    };
+    assert(coro::sync_wait(on_worker(pool)));
+    assert(coro::sync_wait(value_on_pool(pool, 7)) == 7);
+}
+
+static void test_task_chain()
+{
+    WorkStealingThreadPool pool(3);
+
+    auto sum = [](WorkStealingThreadPool& p) -> coro::Task<int> {
+        int total = 0;
+        for (int i = 1; i <= 100; ++i) {
+            total += co_await value_on_pool(p, i);
+        }
+        co_return total;
+    };
+    assert(coro::sync_wait(sum(pool)) == 5050);
+
+    auto strings = []() -> coro::Task<std::string> { co_return std::string("move-only path"); };
+    auto outer   = [&]() -> coro::Task<std::size_t> {
+        std::string s = co_await strings();
+        co_return s.size();
+    };
+    assert(coro::sync_wait(outer()) == 14);
+}
+
+static void test_symmetric_transfer_does_not_grow_stack()
+{
+    // A million awaits of children that complete synchronously: without
+    // symmetric transfer each resume would nest on the stack
+    auto loop = []() -> coro::Task<long> {
+        long total = 0;
+        for (int i = 0; i < 1'000'000; ++i) {
+            total += co_await ready_value(1);
+        }
+        co_return total;
+    };
+    assert(coro::sync_wait(loop()) == 1'000'000);
+}
+
+static void test_exception_propagates()
+{
+    WorkStealingThreadPool pool(2);
+
+    auto failing = [](WorkStealingThreadPool& p) -> coro::Task<int> {
+        co_await p.schedule();
+        throw std::runtime_error("coroutine failed");
+    };
+    auto caller = [&](WorkStealingThreadPool& p) -> coro::Task<bool> {
+        try {
+            co_await failing(p);
+        } catch (const std::runtime_error&) {
+            co_return true;
+        }
+        co_return false;
+    };
+    assert(coro::sync_wait(caller(pool)));
+
+    bool caught = false;
+    try {
+        coro::sync_wait(failing(pool));
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+}
+
+static void test_when_all()
+{
+    WorkStealingThreadPool pool(4);
+
+    auto noop = [](WorkStealingThreadPool& p) -> coro::Task<> { co_await p.schedule(); };
+    auto [a, b, c] = coro::sync_wait(
+        coro::when_all(value_on_pool(pool, 1), ready_value(2), noop(pool)));
+    assert(a == 1 && b == 2);
+    static_assert(std::is_same_v<decltype(c), std::monostate>);
+
+    std::vector<coro::Task<int>> tasks;
+    for (int i = 0; i < 200; ++i) {
+        tasks.push_back(value_on_pool(pool, i));
+    }
+    std::vector<int> results = coro::sync_wait(coro::when_all(std::move(tasks)));
+    assert(results.size() == 200);
+    for (int i = 0; i < 200; ++i) {
+        assert(results[static_cast<std::size_t>(i)] == i);
+    }
+
+    std::atomic<int> ran{0};
+    auto count = [](WorkStealingThreadPool& p, std::atomic<int>& n) -> coro::Task<> {
+        co_await p.schedule();
+        n.fetch_add(1, std::memory_order_relaxed);
+    };
+    std::vector<coro::Task<>> voids;
+    for (int i = 0; i < 50; ++i) {
+        voids.push_back(count(pool, ran));
+    }
+    coro::sync_wait(coro::when_all(std::move(voids)));
+    assert(ran.load() == 50);
+
+    assert(coro::sync_wait(coro::when_all(std::vector<coro::Task<int>>{})).empty());
+}
+
+static void test_when_all_exception()
+{
+    WorkStealingThreadPool pool(2);
+
+    std::atomic<int> finished{0};
+    auto child = [](WorkStealingThreadPool& p, int i, std::atomic<int>& done) -> coro::Task<int> {
+        co_await p.schedule();
+        done.fetch_add(1, std::memory_order_relaxed);
+        if (i == 3) {
+            throw std::runtime_error("child failed");
+        }
+        co_return i;
+    };
+    std::vector<coro::Task<int>> tasks;
+    for (int i = 0; i < 8; ++i) {
+        tasks.push_back(child(pool, i, finished));
+    }
+
+    bool caught = false;
+    try {
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+    assert(finished.load() == 8);  // every child ran before the rethrow
+}
+
+static void test_when_any()
+{
+    WorkStealingThreadPool pool(4);
+
+    auto delayed = [](WorkStealingThreadPool& p, int ms) -> coro::Task<int> {
+        co_await p.schedule();
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        co_return ms;
+    };
+    std::vector<coro::Task<int>> tasks;
+    tasks.push_back(delayed(pool, 200));
+    tasks.push_back(ready_value(-1));  // finishes inline, before anything else
+    tasks.push_back(delayed(pool, 100));
+
+    auto first = coro::sync_wait(coro::when_any(std::move(tasks)));
+    assert(first.index == 1 && first.value == -1);
+
+    bool caught = false;
+    try {
+        coro::sync_wait(coro::when_any(std::vector<coro::Task<int>>{}));
+    } catch (const std::invalid_argument&) {
+        caught = true;
+    }
+    assert(caught);
+    // Losers finish in the background; ~pool drains them
+}
+
+static void test_resumes_on_completing_thread()
+{
+    WorkStealingThreadPool pool(2);
+
+    // The awaiting coroutine continues on the worker that finished the child
+    auto child = [](WorkStealingThreadPool& p) -> coro::Task<std::thread::id> {
+        co_await p.schedule();
+        co_return std::this_thread::get_id();
+    };
+    auto parent = [&](WorkStealingThreadPool& p) -> coro::Task<bool> {
+        const std::thread::id child_thread = co_await child(p);
+        co_return child_thread == std::this_thread::get_id();
+    };
+    for (int i = 0; i < 100; ++i) {
+        assert(coro::sync_wait(parent(pool)));
+    }
+}
+
+int main()
+{
+    std::cout << "Running coroutine tests...\n";
+
+    test_schedule_moves_to_worker();
+    test_task_chain();
+    test_symmetric_transfer_does_not_grow_stack();
+    test_exception_propagates();
+    test_when_all();
+    test_when_all_exception();
+    test_when_any();
+    test_resumes_on_completing_thread();
+
+    std::cout << "All coroutine tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include "thread_pool/metrics.hpp"
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Built twice: with THREAD_POOL_METRICS=1 (metrics_tests) and without
+// (metrics_disabled_tests), where every counter must stay zero
+
+using thread_pool::kMetricsEnabled;
+using thread_pool::Priority;
+using thread_pool::SchedulerMetrics;
+using thread_pool::SchedulingConfig;
+using thread_pool::WorkerMetrics;
+using thread_pool::WorkStealingThreadPool;
+using namespace std::chrono_literals;
+
+static SchedulingConfig sample_all()
+{
+    SchedulingConfig config;
+    config.latency_sample_period = 1;  // every task is timed
+    return config;
+}
+
+static std::size_t count_of(const std::string& text, const std::string& word)
+{
+    std::size_t n = 0;
+    for (std::size_t pos = text.find(word); pos != std::string::npos; pos = text.find(word, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+static void test_task_counts()
+{
+    constexpr std::size_t  kTasks = 1000;
+    WorkStealingThreadPool pool(2, sample_all());
+
+    std::vector<std::future<void>> futs;
+    for (std::size_t i = 0; i < kTasks; ++i) {
+        futs.push_back(pool.submit([] {}));
+    }
+    for (auto& f : futs) {
+        f.get();
+    }
+    // Run time is recorded after the future is ready
+    if (kMetricsEnabled) {
+        while (pool.metrics().run_time.count < kTasks) {
+            std::this_thread::yield();
+        }
+    }
+
+    const SchedulerMetrics m = pool.metrics();
+    assert(m.enabled == kMetricsEnabled);
+    assert(m.workers.size() == 2);
+    assert(m.start_latency[thread_pool::priority_index(Priority::normal)].count == kTasks);
+
+    const WorkerMetrics total = m.total();
+    if (kMetricsEnabled) {
+        assert(total.tasks == kTasks);
+        assert(total.injector_pops == kTasks);  // all submitted from outside
+        assert(total.local_pops == 0 && total.steals == 0);
+        assert(m.run_time.count == kTasks);
+        assert(m.queue_depth.count == kTasks);
+        assert(m.queue_depth.percentile(1.0) <= 2 * kTasks);
+    } else {
+        assert(total.tasks == 0 && total.injector_pops == 0 && total.parks == 0);
+        assert(total.busy_ns == 0 && total.idle_ns == 0);
+        assert(m.run_time.count == 0 && m.queue_depth.count == 0);
+    }
+}
+
+static void test_steals()
+{
+    constexpr int          kChildren = 200;
+    WorkStealingThreadPool pool(4);
+    std::atomic<int>       done{0};
+
+    // Children go onto the parent's deque; the parent waits without
+    // helping, so every child is stolen
+    pool.submit([&] {
+        for (int i = 0; i < kChildren; ++i) {
+            pool.post([&done] {
+                std::this_thread::sleep_for(100us);
+                done.fetch_add(1);
+            });
+        }
+        while (done.load() < kChildren) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }).get();
+
+    const WorkerMetrics total = pool.metrics().total();
+    if (kMetricsEnabled) {
+        assert(total.tasks == kChildren + 1);
+        assert(total.steals == kChildren);
+        assert(total.injector_pops == 1);
+        assert(total.local_pops + total.injector_pops + total.steals == total.tasks);
+        assert(total.failed_steals > 0);  // somebody ended up looking in vain
+    } else {
+        assert(total.tasks == 0 && total.steals == 0 && total.failed_steals == 0);
+    }
+}
+
+static void test_parking_and_time()
+{
+    WorkStealingThreadPool pool(2);
+    std::this_thread::sleep_for(30ms);  // both workers park
+
+    SchedulerMetrics m = pool.metrics();
+    for (const WorkerMetrics& w : m.workers) {
+        if (kMetricsEnabled) {
+            assert(w.parks >= 1);
+            assert(w.idle_ns >= std::chrono::nanoseconds(20ms).count());  // current park counts
+            assert(w.busy_ns >= 0 && w.busy_ns < w.idle_ns);
+        } else {
+            assert(w.parks == 0 && w.idle_ns == 0);
+        }
+    }
+
+    // A submit from outside wakes a parked worker
+    pool.submit([] {}).get();
+    m = pool.metrics();
+    if (kMetricsEnabled) {
+        assert(m.total().wakeups >= 1);
+    } else {
+        assert(m.total().wakeups == 0);
+    }
+}
+
+static void test_json()
+{
+    WorkStealingThreadPool pool(3, sample_all());
+    pool.submit({.priority = Priority::high}, [] {}).get();
+
+    const std::string json = pool.metrics().to_json();
+    assert(json.front() == '{' && json.back() == '}');
+    assert(json.find(kMetricsEnabled ? "\"enabled\":true" : "\"enabled\":false") != std::string::npos);
+    assert(json.find("\"workers\":[{") != std::string::npos);
+    assert(count_of(json, "\"tasks\":") == 4);  // total and one per worker
+    assert(json.find("\"start_latency_ns\":{\"high\":{\"count\":1,") != std::string::npos);
+    assert(json.find("\"normal\":{\"count\":0,") != std::string::npos);
+    assert(json.find("\"run_time_ns\":{") != std::string::npos);
+    assert(json.find("\"queue_depth\":{") != std::string::npos);
+    assert(count_of(json, "\"p99\":") == 5);
+    assert(count_of(json, "{") == count_of(json, "}"));
+}
+
+int main()
+{
+    std::cout << "Running metrics tests...\n";
+
+    test_task_counts();
+    test_steals();
+    test_parking_and_time();
+    test_json();
+
+    std::cout << "All metrics tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include "thread_pool/parallel_algorithms.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using thread_pool::WorkStealingThreadPool;
+
+static void test_parallel_for_visits_each_index_once()
+{
+    WorkStealingThreadPool pool(4);
+
+    for (std::size_t n : {0u, 1u, 7u, 1000u, 100003u}) {
+        std::vector<std::atomic<int>> hits(n);
+        thread_pool::parallel_for(pool, 0, n, [&](std::size_t i) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        });
+        for (auto& h : hits) {
+            assert(h.load() == 1);
+        }
+    }
+
+    // Explicit grain, offset range
+    std::vector<int> out(500, 0);
+    thread_pool::parallel_for(pool, 100, 400, 16, [&](std::size_t i) { out[i] = 1; });
+    assert(std::accumulate(out.begin(), out.end(), 0) == 300);
+    assert(out[99] == 0 && out[100] == 1 && out[399] == 1 && out[400] == 0);
+}
+
+static void test_parallel_reduce()
+{
+    WorkStealingThreadPool pool(4);
+
+    std::vector<std::int64_t> data(1 << 20);
+    std::iota(data.begin(), data.end(), 0);
+    const std::int64_t n   = static_cast<std::int64_t>(data.size());
+    const std::int64_t sum = thread_pool::parallel_reduce(pool, data.begin(), data.end(),
+                                                          std::int64_t{10});
+    assert(sum == 10 + n * (n - 1) / 2);
+
+    assert(thread_pool::parallel_reduce(pool, data.begin(), data.begin(), 5) == 5);
+
+    // Associative but not commutative: partials must be combined in order
+    std::vector<std::string> words;
+    std::string expected = ">";
+    for (int i = 0; i < 2000; ++i) {
+        words.push_back(std::to_string(i % 10));
+        expected += words.back();
+    }
+    const std::string joined = thread_pool::parallel_reduce(
+        pool, words.begin(), words.end(), std::string(">"),
+        [](std::string a, const std::string& b) { return a + b; }, 8);
+    assert(joined == expected);
+}
+
+static void test_parallel_transform()
+{
+    WorkStealingThreadPool pool(3);
+
+    std::vector<int> in(50000);
+    std::iota(in.begin(), in.end(), 0);
+    std::vector<long> out(in.size());
+
+    auto end = thread_pool::parallel_transform(pool, in.begin(), in.end(), out.begin(),
+                                               [](int x) { return static_cast<long>(x) * x; });
+    assert(end == out.end());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        assert(out[i] == static_cast<long>(i) * static_cast<long>(i));
+    }
+
+    // In place
+    thread_pool::parallel_transform(pool, in.begin(), in.end(), in.begin(),
+                                    [](int x) { return -x; });
+    assert(in[12345] == -12345);
+}
+
+static void test_parallel_sort()
+{
+    WorkStealingThreadPool pool(4);
+
+    std::mt19937 rng(42);
+    for (std::size_t n : {0u, 1u, 100u, 5000u, 300000u}) {
+        std::vector<std::uint32_t> v(n);
+        for (auto& x : v) {
+            x = rng() % 1000;  // plenty of duplicates
+        }
+        std::vector<std::uint32_t> expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        thread_pool::parallel_sort(pool, v.begin(), v.end());
+        assert(v == expected);
+    }
+
+    std::vector<int> desc(100000);
+    std::iota(desc.begin(), desc.end(), 0);
+    thread_pool::parallel_sort(pool, desc.begin(), desc.end(), std::greater<>{});
+    assert(std::is_sorted(desc.begin(), desc.end(), std::greater<>{}));
+}
+
+static void test_parallel_scan()
+{
+    WorkStealingThreadPool pool(4);
+
+    for (std::size_t n : {0u, 1u, 2u, 999u, 100000u}) {
+        std::vector<std::int64_t> in(n);
+        std::iota(in.begin(), in.end(), 1);
+        std::vector<std::int64_t> expected(n);
+        std::inclusive_scan(in.begin(), in.end(), expected.begin());
+
+        std::vector<std::int64_t> out(n);
+        auto end = thread_pool::parallel_scan(pool, in.begin(), in.end(), out.begin());
+        assert(end == out.end());
+        assert(out == expected);
+
+        // In place, small explicit grain (many blocks)
+        thread_pool::parallel_scan(pool, in.begin(), in.end(), in.begin(), std::plus<>{}, 7);
+        assert(in == expected);
+    }
+
+    // Non-commutative op
+    std::vector<std::string> letters(300);
+    for (std::size_t i = 0; i < letters.size(); ++i) {
+        letters[i] = std::string(1, static_cast<char>('a' + i % 26));
+    }
+    std::vector<std::string> out(letters.size());
+    thread_pool::parallel_scan(pool, letters.begin(), letters.end(), out.begin(),
+                               [](const std::string& a, const std::string& b) { return a + b; }, 16);
+    std::string prefix;
+    for (std::size_t i = 0; i < letters.size(); ++i) {
+        prefix += letters[i];
+        assert(out[i] == prefix);
+    }
+}
+
+static void test_nested_calls_from_workers()
+{
+    // Every worker blocks in an inner parallel_for: joins must help, not wait
+    WorkStealingThreadPool pool(2);
+
+    std::atomic<long> total{0};
+    thread_pool::parallel_for(pool, 0, 16, 1, [&](std::size_t) {
+        thread_pool::parallel_for(pool, 0, 1000, 10, [&](std::size_t i) {
+            total.fetch_add(static_cast<long>(i), std::memory_order_relaxed);
+        });
+    });
+    assert(total.load() == 16L * (999L * 1000L / 2));
+}
+
+static void test_exception_propagates()
+{
+    WorkStealingThreadPool pool(4);
+
+    std::atomic<int> ran{0};
+    bool caught = false;
+    try {
+        thread_pool::parallel_for(pool, 0, 10000, 10, [&](std::size_t i) {
+            ran.fetch_add(1, std::memory_order_relaxed);
+            if (i == 7777) {
+                throw std::runtime_error("bad index");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+
+    // Pool still usable afterwards
+    std::vector<int> v(1000, 1);
+    assert(thread_pool::parallel_reduce(pool, v.begin(), v.end(), 0) == 1000);
+}
+
+int main()
+{
+    std::cout << "Running parallel algorithms tests...\n";
+
+    test_parallel_for_visits_each_index_once();
+    test_parallel_reduce();
+    test_parallel_transform();
+    test_parallel_sort();
+    test_parallel_scan();
+    test_nested_calls_from_workers();
+    test_exception_propagates();
+
+    std::cout << "All parallel algorithms tests passed.\n";
+    return 0;
+}
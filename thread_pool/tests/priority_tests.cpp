@@ -0,0 +1,310 @@
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+using thread_pool::LatencyHistogram;
+using thread_pool::Priority;
+using thread_pool::SchedulingConfig;
+using thread_pool::TaskOptions;
+using thread_pool::WorkStealingThreadPool;
+using namespace std::chrono_literals;
+
+// While set, every operator new throws (to fail a deque's growth)
+static std::atomic<bool> g_fail_allocations{false};
+
+void* operator new(std::size_t size)
+{
+    if (g_fail_allocations.load(std::memory_order_relaxed)) {
+        throw std::bad_alloc();
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static SchedulingConfig strict_config()
+{
+    SchedulingConfig config;
+    config.aging.fill(0ns);
+    return config;
+}
+
+// Occupies the pool's only worker until release() is called
+class Gate {
+public:
+    explicit Gate(WorkStealingThreadPool& pool)
+    {
+        pool.post([this] {
+            entered_.store(true);
+            while (!open_.load()) {
+                std::this_thread::yield();
+            }
+        });
+        while (!entered_.load()) {
+            std::this_thread::yield();
+        }
+    }
+
+    void release() { open_.store(true); }
+
+private:
+    std::atomic<bool> entered_{false};
+    std::atomic<bool> open_{false};
+};
+
+static void test_higher_classes_run_first()
+{
+    WorkStealingThreadPool pool(1, strict_config());
+    std::mutex             mutex;
+    std::vector<int>       order;
+    auto record = [&](int tag) {
+        std::lock_guard<std::mutex> lk(mutex);
+        order.push_back(tag);
+    };
+
+    Gate gate(pool);
+    for (int i = 0; i < 5; ++i) {
+        pool.post({.priority = Priority::low}, [&, i] { record(200 + i); });
+        pool.post([&, i] { record(100 + i); });  // normal by default
+        pool.post({.priority = Priority::high}, [&, i] { record(i); });
+    }
+    gate.release();
+    pool.submit({.priority = Priority::low}, [] {}).get();
+
+    assert(order.size() == 15);
+    for (int i = 0; i < 15; ++i) {
+        assert(order[static_cast<std::size_t>(i)] == (i / 5) * 100 + i % 5);  // by class, FIFO within
+    }
+}
+
+static void test_aging_prevents_starvation()
+{
+    SchedulingConfig config = strict_config();
+    config.aging[thread_pool::priority_index(Priority::low)] = 2ms;
+
+    // Declared before the pool: queued flood tasks still run in ~pool
+    std::atomic<bool>     stop{false};
+    std::atomic<bool>     flood_done{false};
+    std::atomic<bool>     low_ran{false};
+    std::atomic<int>      high_runs{0};
+    std::function<void()> flood;
+    WorkStealingThreadPool pool(1, config);
+
+    // A stream of high-priority work that keeps the only worker busy
+    flood = [&] {
+        high_runs.fetch_add(1);
+        std::this_thread::sleep_for(100us);
+        if (stop.load()) {
+            flood_done.store(true);
+        } else {
+            pool.post(flood);  // inherits high
+        }
+    };
+    pool.post({.priority = Priority::high}, flood);
+    pool.post({.priority = Priority::low}, [&] { low_ran.store(true); });
+
+    const auto start = std::chrono::steady_clock::now();
+    while (!low_ran.load() && std::chrono::steady_clock::now() - start < 2s) {
+        std::this_thread::sleep_for(1ms);
+    }
+    stop.store(true);
+    while (!flood_done.load()) {  // the last flood task may be copying flood
+        std::this_thread::sleep_for(1ms);
+    }
+    assert(low_ran.load());
+    assert(high_runs.load() > 1);
+}
+
+static void test_without_aging_low_waits()
+{
+    std::atomic<int>      remaining{50};
+    std::atomic<bool>     low_ran_early{false};
+    std::function<void()> flood;  // outlives the pool, like the counters
+    WorkStealingThreadPool pool(1, strict_config());
+
+    flood = [&] {
+        std::this_thread::sleep_for(50us);
+        if (remaining.fetch_sub(1) > 1) {
+            pool.post(flood);
+        }
+    };
+    Gate gate(pool);
+    pool.post({.priority = Priority::high}, flood);
+    pool.post({.priority = Priority::low}, [&] { low_ran_early.store(remaining.load() > 0); });
+    gate.release();
+    pool.submit({.priority = Priority::low}, [] {}).get();
+    assert(!low_ran_early.load());
+}
+
+static void test_deadline_promotion()
+{
+    SchedulingConfig config = strict_config();
+    config.promotion_window = 5ms;
+    WorkStealingThreadPool pool(1, config);
+    std::mutex             mutex;
+    std::vector<int>       order;
+    auto record = [&](int tag) {
+        std::lock_guard<std::mutex> lk(mutex);
+        order.push_back(tag);
+    };
+
+    Gate gate(pool);
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) {
+        pool.post({.priority = Priority::high}, [&, i] { record(i); });
+    }
+    // Due within the window: jumps the high tasks
+    pool.post({.priority = Priority::low, .deadline = now + 1ms}, [&] { record(100); });
+    // Far from its deadline: runs in class order
+    pool.post({.priority = Priority::low, .deadline = now + 1h}, [&] { record(101); });
+    gate.release();
+    pool.submit({.priority = Priority::low}, [] {}).get();
+
+    const std::vector<int> expected{100, 0, 1, 2, 101};
+    assert(order == expected);
+}
+
+static void test_deadline_tasks_run_once()
+{
+    // Heap and class queue race for every task; each must run exactly once
+    std::atomic<int> runs{0};
+    {
+        SchedulingConfig config;
+        config.promotion_window = 200us;
+        WorkStealingThreadPool pool(4, config);
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 5000; ++i) {
+            const auto deadline = start + std::chrono::microseconds(i % 500);
+            const auto priority = static_cast<Priority>(i % 3);
+            pool.post({.priority = priority, .deadline = deadline}, [&runs] { runs.fetch_add(1); });
+        }
+        pool.post({.deadline = start + 1h}, [&runs] { runs.fetch_add(1); });  // stays in the heap
+    }
+    assert(runs.load() == 5001);
+}
+
+static void test_failed_push_leaves_no_deadline_entry()
+{
+    // A deadline task whose deque push throws must not stay in the heap,
+    // where it would be promoted and run although post() threw
+    SchedulingConfig config;
+    config.promotion_window = 1h;  // every deadline task is due at once
+    WorkStealingThreadPool pool(1, config);
+    std::atomic<bool>      ran{false};
+    bool                   threw = false;
+
+    const auto soon = std::chrono::steady_clock::now();
+    for (int i = 0; i < 16; ++i) {
+        pool.submit({.deadline = soon}, [] {}).get();  // heap has spare capacity
+    }
+    pool.submit([&] {
+        // Warm this worker's node cache (through the normal deque), then
+        // fill its low deque exactly
+        for (int i = 0; i < 300; ++i) {
+            pool.post([] {});
+        }
+        while (pool.try_run_pending_task()) {
+        }
+        for (std::size_t i = 0; i < thread_pool::ChaseLevDeque<int>::kDefaultCapacity; ++i) {
+            pool.post({.priority = Priority::low}, [] {});
+        }
+        g_fail_allocations.store(true);
+        try {
+            pool.post({.priority = Priority::low, .deadline = soon}, [&ran] { ran.store(true); });
+        } catch (const std::bad_alloc&) {
+            threw = true;
+        }
+        g_fail_allocations.store(false);
+    }).get();
+    pool.submit({.priority = Priority::low}, [] {}).get();  // everything queued before has run
+
+    assert(threw);
+    assert(!ran.load());
+}
+
+static void test_priority_inherited_and_histograms()
+{
+    SchedulingConfig config;
+    config.latency_sample_period = 1;  // time every task
+    WorkStealingThreadPool pool(2, config);
+
+    auto fut = pool.submit({.priority = Priority::high}, [&pool] {
+        // Posted without options from a high task: high as well
+        return pool.submit([] { return 7; });
+    });
+    assert(fut.get().get() == 7);
+
+    for (int i = 0; i < 10; ++i) {
+        pool.submit({.priority = Priority::low}, [] {}).get();
+    }
+    TaskOptions opts{.priority = Priority::low};  // lvalue options
+    pool.submit(opts, [] {}).get();
+
+    // Taken-task counts are recorded before the tasks run
+    assert(pool.queue_latency(Priority::high).count == 2);
+    assert(pool.queue_latency(Priority::low).count == 11);
+    assert(pool.queue_latency(Priority::normal).count == 0);
+
+    const LatencyHistogram::Snapshot low = pool.queue_latency(Priority::low);
+    assert(low.percentile(0.5) > 0 && low.percentile(0.5) <= low.percentile(1.0));
+
+    // Default sampling times a fraction of the tasks
+    WorkStealingThreadPool sampled(1);
+    for (int i = 0; i < 64; ++i) {
+        sampled.submit([] {}).get();
+    }
+    const std::uint64_t timed = sampled.queue_latency(Priority::normal).count;
+    assert(timed >= 3 && timed <= 5);
+}
+
+static void test_histogram_buckets()
+{
+    assert(LatencyHistogram::bucket_of(0) == 0);
+    assert(LatencyHistogram::bucket_of(1) == 0);
+    assert(LatencyHistogram::bucket_of(2) == 1);
+    assert(LatencyHistogram::bucket_of(1023) == 9);
+    assert(LatencyHistogram::bucket_of(1024) == 10);
+    assert(LatencyHistogram::bucket_of(-5) == 0);
+    assert(LatencyHistogram::bucket_of(std::int64_t{1} << 62) == LatencyHistogram::kBuckets - 1);
+
+    LatencyHistogram h;
+    for (int i = 0; i < 99; ++i) {
+        h.record(100);  // bucket 6: [64, 128)
+    }
+    h.record(1'000'000);  // bucket 19
+    const auto s = h.snapshot();
+    assert(s.count == 100);
+    assert(s.percentile(0.5) == 127);
+    assert(s.percentile(1.0) == (std::uint64_t{1} << 20) - 1);
+    assert(LatencyHistogram::Snapshot{}.percentile(0.5) == 0);
+}
+
+int main()
+{
+    std::cout << "Running priority tests...\n";
+
+    test_higher_classes_run_first();
+    test_aging_prevents_starvation();
+    test_without_aging_low_waits();
+    test_deadline_promotion();
+    test_deadline_tasks_run_once();
+    test_failed_push_leaves_no_deadline_entry();
+    test_priority_inherited_and_histograms();
+    test_histogram_buckets();
+
+    std::cout << "All priority tests passed.\n";
+    return 0;
+}
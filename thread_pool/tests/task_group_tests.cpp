@@ -0,0 +1,148 @@
+#include "thread_pool/task_group.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using thread_pool::TaskGroup;
+using thread_pool::WorkStealingThreadPool;
+
+static long fib(WorkStealingThreadPool& pool, int n)
+{
+    if (n < 2) {
+        return n;
+    }
+    long a = 0;
+    long b = 0;
+    TaskGroup group(pool);
+    group.spawn([&] { a = fib(pool, n - 1); });
+    b = fib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+static void test_recursive_fib()
+{
+    // Deep nesting on few workers: with blocking joins this would deadlock
+    for (std::size_t threads : {1u, 2u, 4u}) {
+        WorkStealingThreadPool pool(threads);
+        assert(fib(pool, 20) == 6765);
+
+        // Same, started from inside a worker
+        auto fut = pool.submit([&pool] { return fib(pool, 18); });
+        assert(fut.get() == 2584);
+    }
+}
+
+static void test_spawn_many_and_reuse()
+{
+    WorkStealingThreadPool pool(3);
+    TaskGroup group(pool);
+
+    std::atomic<int> counter{0};
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            group.spawn([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        group.wait();
+        assert(group.pending() == 0);
+        assert(counter.load() == (round + 1) * 1000);
+    }
+}
+
+static void test_nested_spawns_into_same_group()
+{
+    WorkStealingThreadPool pool(2);
+    TaskGroup group(pool);
+
+    std::atomic<int> leaves{0};
+    for (int i = 0; i < 10; ++i) {
+        group.spawn([&] {
+            for (int j = 0; j < 10; ++j) {
+                group.spawn([&leaves] { leaves.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    group.wait();
+    assert(leaves.load() == 100);
+}
+
+static void test_exception_rethrown_by_wait()
+{
+    WorkStealingThreadPool pool(2);
+    TaskGroup group(pool);
+
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 100; ++i) {
+        group.spawn([&ran, i] {
+            ran.fetch_add(1, std::memory_order_relaxed);
+            if (i % 10 == 3) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+
+    bool caught = false;
+    try {
+        group.wait();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+    assert(ran.load() == 100);  // the other tasks still ran
+
+    // Error consumed: the group is clean again
+    group.spawn([] {});
+    group.wait();
+}
+
+static void test_destructor_waits()
+{
+    WorkStealingThreadPool pool(2);
+    std::atomic<int> finished{0};
+    {
+        TaskGroup group(pool);
+        for (int i = 0; i < 4; ++i) {
+            group.spawn([&finished] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                finished.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+    }
+    assert(finished.load() == 4);
+}
+
+static void test_help_until_future()
+{
+    // A worker waiting on a child's future without blocking the only worker
+    WorkStealingThreadPool pool(1);
+
+    auto outer = pool.submit([&pool] {
+        auto inner = pool.submit([] { return 21; });
+        pool.help_until([&] {
+            return inner.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+        return inner.get() * 2;
+    });
+    assert(outer.get() == 42);
+}
+
+int main()
+{
+    std::cout << "Running task_group tests...\n";
+
+    test_recursive_fib();
+    test_spawn_many_and_reuse();
+    test_nested_spawns_into_same_group();
+    test_exception_rethrown_by_wait();
+    test_destructor_waits();
+    test_help_until_future();
+
+    std::cout << "All task_group tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "thread_pool/task.hpp"
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+using thread_pool::Task;
+using thread_pool::WorkStealingThreadPool;
+
+// Count every global heap allocation made by this process
+static std::atomic<std::size_t> g_allocations{0};
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Tracks live instances, to check Task destroys what it owns exactly once
+struct Counted {
+    static inline int live = 0;
+
+    Counted() { ++live; }
+    Counted(const Counted&) { ++live; }
+    Counted(Counted&&) noexcept { ++live; }
+    ~Counted() { --live; }
+};
+
+static void test_inline_and_heap_storage()
+{
+    int calls = 0;
+    auto small = [&calls] { ++calls; };
+    static_assert(Task::fits_inline<decltype(small)>);
+
+    std::array<char, 128> payload{};
+    auto big = [&calls, payload] { calls += payload[0] + 1; };
+    static_assert(!Task::fits_inline<decltype(big)>);
+
+    const std::size_t before_small = g_allocations.load();
+    Task a(small);
+    assert(g_allocations.load() == before_small);  // stored inline
+    a();
+
+    const std::size_t before_big = g_allocations.load();
+    Task b(big);
+    assert(g_allocations.load() == before_big + 1);  // boxed once
+    b();
+
+    assert(calls == 2);
+}
+
+static void test_move_only_callable()
+{
+    auto value = std::make_unique<int>(41);
+    int  seen  = 0;
+
+    Task t([v = std::move(value), &seen] { seen = *v + 1; });
+    Task moved(std::move(t));
+    assert(!t);
+    assert(moved);
+
+    moved();
+    assert(seen == 42);
+}
+
+static void test_destroys_exactly_once()
+{
+    {
+        Task t([c = Counted{}] { (void)c; });
+        assert(Counted::live == 1);
+
+        Task u;
+        u = std::move(t);
+        assert(Counted::live == 1);
+
+        u.reset();
+        assert(!u);
+        assert(Counted::live == 0);
+    }
+    {
+        std::array<char, 128> payload{};
+        Task t([c = Counted{}, payload] { (void)c; (void)payload; });
+        Task u(std::move(t));
+        assert(Counted::live == 1);
+    }
+    assert(Counted::live == 0);
+}
+
+static void test_post_is_allocation_free()
+{
+    WorkStealingThreadPool pool(2);
+
+    constexpr int kRounds = 8;
+    constexpr int kBatch  = 256;
+    std::atomic<int> done{0};
+
+    std::size_t allocations_in_last_round = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        done.store(0);
+        const std::size_t before = g_allocations.load();
+        for (int i = 0; i < kBatch; ++i) {
+            pool.post([&done] { done.fetch_add(1, std::memory_order_release); });
+        }
+        while (done.load(std::memory_order_acquire) != kBatch) {
+            std::this_thread::yield();
+        }
+        allocations_in_last_round = g_allocations.load() - before;
+    }
+
+    // Warm-up rounds fill the block caches; after that nothing is allocated
+    assert(allocations_in_last_round == 0);
+}
+
+static void test_submit_is_allocation_free()
+{
+    WorkStealingThreadPool pool(2);
+
+    constexpr int kRounds = 8;
+    constexpr int kBatch  = 256;
+
+    std::vector<std::future<int>> futures;
+    futures.reserve(kBatch);
+
+    std::size_t allocations_in_last_round = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        futures.clear();
+        const std::size_t before = g_allocations.load();
+        for (int i = 0; i < kBatch; ++i) {
+            futures.push_back(pool.submit([i] { return i; }));
+        }
+        long long sum = 0;
+        for (auto& f : futures) {
+            sum += f.get();
+        }
+        assert(sum == static_cast<long long>(kBatch - 1) * kBatch / 2);
+        futures.clear();  // release the shared states inside the measured round
+        allocations_in_last_round = g_allocations.load() - before;
+    }
+
+    assert(allocations_in_last_round == 0);
+}
+
+int main()
+{
+    std::cout << "Running task tests...\n";
+
+    test_inline_and_heap_storage();
+    test_move_only_callable();
+    test_destroys_exactly_once();
+    test_post_is_allocation_free();
+    test_submit_is_allocation_free();
+
+    std::cout << "All task tests passed.\n";
+    return 0;
+}
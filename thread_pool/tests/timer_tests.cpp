@@ -0,0 +1,242 @@
+#include "thread_pool/timer_wheel.hpp"
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using thread_pool::Priority;
+using thread_pool::TimerEntry;
+using thread_pool::TimerWheel;
+using thread_pool::WorkStealingThreadPool;
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+struct TestTimer : TimerEntry {
+    int  id      = 0;
+    bool expired = false;
+};
+
+static void test_wheel_expires_on_due_tick()
+{
+    // Random deltas across every level, random advance steps: each timer
+    // expires exactly on its tick, cancelled ones never
+    std::mt19937_64 rng(42);
+    TimerWheel      wheel(1000);
+    std::vector<TestTimer> timers(5000);
+    std::vector<bool>      cancelled(timers.size(), false);
+
+    for (std::size_t i = 0; i < timers.size(); ++i) {
+        const unsigned bits  = static_cast<unsigned>(rng() % 34);  // up to past the top level
+        const auto     delta = 1 + (rng() & ((std::uint64_t{1} << bits) - 1));
+        timers[i].id = static_cast<int>(i);
+        const bool scheduled = wheel.schedule(&timers[i], wheel.now() + delta);
+        assert(scheduled);
+    }
+    for (std::size_t i = 0; i < timers.size(); i += 7) {
+        wheel.cancel(&timers[i]);
+        assert(!timers[i].scheduled());
+        cancelled[i] = true;
+    }
+
+    std::size_t expired = 0;
+    while (!wheel.empty()) {
+        const std::uint64_t to = wheel.now() + 1 + rng() % (std::uint64_t{1} << (rng() % 36));
+        wheel.advance(to, [&](TimerEntry* e) {
+            auto* t = static_cast<TestTimer*>(e);
+            assert(!t->expired && !t->scheduled());
+            assert(wheel.now() == t->due);  // on its tick, not a cascade boundary
+            t->expired = true;
+            ++expired;
+        });
+        assert(wheel.now() == to);
+    }
+    for (std::size_t i = 0; i < timers.size(); ++i) {
+        assert(timers[i].expired == !cancelled[i]);
+    }
+    assert(expired == timers.size() - (timers.size() + 6) / 7);
+}
+
+static void test_wheel_next_event()
+{
+    TimerWheel wheel;
+    assert(!wheel.next_event());
+
+    TestTimer near, far;
+    bool scheduled = wheel.schedule(&near, 0);
+    assert(!scheduled);  // not after now(): caller runs it
+    scheduled = wheel.schedule(&near, 5);
+    assert(scheduled && *wheel.next_event() == 5);
+
+    scheduled = wheel.schedule(&far, 1000);  // level 1: next event is its cascade
+    assert(scheduled);
+    wheel.cancel(&near);
+    assert(*wheel.next_event() == 960);
+    wheel.advance(960, [](TimerEntry*) { assert(false); });
+    assert(*wheel.next_event() == 1000);
+
+    int fired = 0;
+    wheel.advance(999, [&](TimerEntry*) { ++fired; });
+    assert(fired == 0);
+    wheel.advance(1000, [&](TimerEntry* e) {
+        assert(e == &far);
+        ++fired;
+    });
+    assert(fired == 1 && wheel.empty() && !wheel.next_event());
+}
+
+static void test_submit_after_waits()
+{
+    WorkStealingThreadPool pool(2);
+
+    const auto start = Clock::now();
+    auto       fut   = pool.submit_after(30ms, [start] { return Clock::now() - start; });
+    const auto waited = fut.get();
+    assert(waited >= 30ms);  // never early
+
+    // Fire in deadline order, not submission order
+    std::mutex       mutex;
+    std::vector<int> order;
+    std::vector<WorkStealingThreadPool::ScheduledFuture<void>> futs;
+    for (int i : {3, 1, 2}) {
+        futs.push_back(pool.submit_at(Clock::now() + i * 15ms, [&, i] {
+            std::lock_guard<std::mutex> lk(mutex);
+            order.push_back(i);
+        }));
+    }
+    for (auto& f : futs) {
+        f.get();
+    }
+    assert((order == std::vector<int>{1, 2, 3}));
+
+    // Past time points and zero delays run at once
+    const int past = pool.submit_at(Clock::now() - 1h, [] { return 1; }).get();
+    const int now  = pool.submit_after(0ms, [](int x) { return x * 2; }, 21).get();
+    assert(past == 1 && now == 42);
+}
+
+static void test_cancel()
+{
+    WorkStealingThreadPool pool(2);
+    std::atomic<bool>      ran{false};
+
+    auto fut = pool.submit_after(1h, [&ran] { ran.store(true); });
+    const bool cancelled = fut.cancel();
+    const bool again     = fut.cancel();
+    assert(cancelled && !again);  // the second time it is already cancelled
+    bool broken = false;
+    try {
+        fut.get();
+    } catch (const std::future_error& e) {
+        broken = e.code() == std::future_errc::broken_promise;
+    }
+    assert(broken);
+
+    auto done = pool.submit_after(1ms, [] { return 3; });
+    const int fired = done.get();
+    assert(fired == 3);
+    const bool done_cancelled = done.cancel();
+    assert(!done_cancelled);  // fired: its node may be reused already
+
+    // A recycled node does not answer to an old handle
+    auto reused = pool.submit_after(1h, [] {});
+    const bool stale_cancelled  = done.timer().cancel();
+    const bool reused_cancelled = reused.cancel();
+    assert(!stale_cancelled && reused_cancelled);
+
+    WorkStealingThreadPool::TimerHandle empty;
+    const bool empty_cancelled = empty.cancel();
+    assert(!empty_cancelled);
+    assert(!ran.load());
+}
+
+static void test_periodic()
+{
+    std::atomic<int> runs{0};
+    std::atomic<int> concurrent{0};
+    std::atomic<bool> overlapped{false};
+    WorkStealingThreadPool pool(4);
+
+    auto timer = pool.schedule_periodic(2ms, [&] {
+        if (concurrent.fetch_add(1) != 0) {
+            overlapped.store(true);
+        }
+        std::this_thread::sleep_for(3ms);  // longer than the period
+        concurrent.fetch_sub(1);
+        runs.fetch_add(1);
+    });
+    while (runs.load() < 5) {
+        std::this_thread::sleep_for(1ms);
+    }
+    const bool timer_cancelled = timer.cancel();
+    const bool timer_again     = timer.cancel();
+    assert(timer_cancelled && !timer_again);
+    std::this_thread::sleep_for(10ms);  // a run in flight may still finish
+    const int after_cancel = runs.load();
+    std::this_thread::sleep_for(20ms);
+    assert(runs.load() == after_cancel);
+    assert(!overlapped.load());
+
+    bool threw = false;
+    try {
+        pool.schedule_periodic(0ms, [] {});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+static void test_timer_priority_and_shutdown()
+{
+    std::atomic<bool> ran{false};
+    std::future<bool> pending;
+    {
+        thread_pool::SchedulingConfig config;
+        config.latency_sample_period = 1;  // every enqueue is counted
+        WorkStealingThreadPool pool(2, config);
+
+        // A delayed task takes the class of the task that scheduled it, and
+        // passes it on to what it posts
+        auto delayed = pool.submit({.priority = Priority::high}, [&pool] {
+            return pool.submit_after(1ms, [&pool] { pool.submit([] {}).get(); });
+        }).get();
+        delayed.get();
+        // Outer task, the delayed task (timed from when it fired), the child
+        assert(pool.queue_latency(Priority::high).count == 3);
+        assert(pool.queue_latency(Priority::normal).count == 0);
+
+        pending = pool.submit_after(1h, [&ran] { ran.store(true); return true; });
+        (void)pool.schedule_periodic(1ms, [] {});  // still running at destruction
+        std::this_thread::sleep_for(5ms);
+    }
+    assert(!ran.load());  // dropped, not run
+    bool broken = false;
+    try {
+        pending.get();
+    } catch (const std::future_error&) {
+        broken = true;
+    }
+    assert(broken);
+}
+
+int main()
+{
+    std::cout << "Running timer tests...\n";
+
+    test_wheel_expires_on_due_tick();
+    test_wheel_next_event();
+    test_submit_after_waits();
+    test_cancel();
+    test_periodic();
+    test_timer_priority_and_shutdown();
+
+    std::cout << "All timer tests passed.\n";
+    return 0;
+}
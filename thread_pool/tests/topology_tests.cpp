@@ -0,0 +1,167 @@
+#include "thread_pool/task_group.hpp"
+#include "thread_pool/topology.hpp"
+#include "thread_pool/work_stealing_thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using thread_pool::CpuInfo;
+using thread_pool::CpuTopology;
+using thread_pool::SchedulingConfig;
+using thread_pool::WorkStealingThreadPool;
+namespace fs = std::filesystem;
+
+static void write_file(const fs::path& path, const std::string& text)
+{
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << text << "\n";
+}
+
+static void write_cache(const fs::path& cpu, int index, int level, const std::string& type,
+                        const std::string& shared)
+{
+    const fs::path dir = cpu / "cache" / ("index" + std::to_string(index));
+    write_file(dir / "level", std::to_string(level));
+    write_file(dir / "type", type);
+    write_file(dir / "shared_cpu_list", shared);
+}
+
+// 2 packages x 2 cores x 2 hardware threads, numbered like Linux on x86:
+// cpu = thread * 4 + package * 2 + core. L2 per core, L3 per package.
+static fs::path make_fake_sysfs()
+{
+    const fs::path root = fs::temp_directory_path() / "thread_pool_topology_test";
+    fs::remove_all(root);
+    write_file(root / "online", "0-7");
+    for (int id = 0; id < 8; ++id) {
+        const int      package = (id / 2) % 2;
+        const int      first   = id % 4;  // lowest sibling
+        const fs::path cpu     = root / ("cpu" + std::to_string(id));
+        const std::string siblings = std::to_string(first) + "," + std::to_string(first + 4);
+        write_file(cpu / "topology" / "physical_package_id", std::to_string(package));
+        write_file(cpu / "topology" / "thread_siblings_list", siblings);
+        write_cache(cpu, 0, 1, "Data", siblings);
+        write_cache(cpu, 1, 1, "Instruction", siblings);
+        write_cache(cpu, 2, 2, "Unified", siblings);
+        write_cache(cpu, 3, 3, "Unified", package == 0 ? "0-1,4-5" : "2-3,6-7");
+    }
+    return root;
+}
+
+static void test_parse_cpu_list()
+{
+    assert((CpuTopology::parse_cpu_list("0-3,8,10-11") == std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    assert((CpuTopology::parse_cpu_list("5") == std::vector<int>{5}));
+    assert((CpuTopology::parse_cpu_list("2,0-1,1") == std::vector<int>{0, 1, 2}));  // sorted, unique
+    assert((CpuTopology::parse_cpu_list("x,2,-") == std::vector<int>{2}));          // bad parts skipped
+    assert(CpuTopology::parse_cpu_list("").empty());
+
+    // Ids past kMaxCpus, and ranges reaching them, are skipped whole
+    const std::string too_big = std::to_string(CpuTopology::kMaxCpus);
+    assert((CpuTopology::parse_cpu_list("1," + too_big + ",3") == std::vector<int>{1, 3}));
+    assert((CpuTopology::parse_cpu_list("0-2147483647,4") == std::vector<int>{4}));
+    assert((CpuTopology::parse_cpu_list("99999999999999999999,5") == std::vector<int>{5}));
+    assert(CpuTopology::parse_cpu_list("2-" + too_big).empty());
+}
+
+static void test_sysfs_topology()
+{
+    const fs::path    root = make_fake_sysfs();
+    const CpuTopology topo = CpuTopology::from_sysfs(root.string());
+    assert(topo.known());
+    assert(topo.cpus().size() == 8);
+
+    const CpuInfo& cpu4 = topo.cpus()[4];
+    assert(cpu4.id == 4 && cpu4.package == 0 && cpu4.core == 0 && cpu4.l2 == 0 && cpu4.l3 == 0);
+    const CpuInfo& cpu7 = topo.cpus()[7];
+    assert(cpu7.package == 1 && cpu7.core == 3 && cpu7.l2 == 3 && cpu7.l3 == 2);
+
+    assert(CpuTopology::distance(topo.cpus()[0], topo.cpus()[4]) == 0);  // SMT siblings
+    assert(CpuTopology::distance(topo.cpus()[0], topo.cpus()[1]) == 1);  // same L3
+    assert(CpuTopology::distance(topo.cpus()[0], topo.cpus()[2]) == 3);  // other package
+    assert(CpuTopology::distance(CpuInfo{0, 0, 0, -1, -1}, CpuInfo{1, 0, 1, -1, -1}) == 2);
+
+    // One thread per core first, cache neighbours adjacent
+    std::vector<int> order;
+    for (const CpuInfo& cpu : topo.placement()) {
+        order.push_back(cpu.id);
+    }
+    assert((order == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+
+    // Worker 0 sits on cpu 0: its SMT sibling, then its L3, then the rest
+    const auto tiers = CpuTopology::steal_tiers(topo.placement(), 0);
+    assert(tiers.size() == 3);
+    assert((tiers[0] == std::vector<std::size_t>{4}));
+    assert((tiers[1] == std::vector<std::size_t>{1, 5}));
+    assert((tiers[2] == std::vector<std::size_t>{2, 3, 6, 7}));
+
+    // Only some CPUs online, topology files missing: still usable
+    write_file(root / "online", "0,9");
+    const CpuTopology partial = CpuTopology::from_sysfs(root.string());
+    assert(partial.cpus().size() == 2);
+    assert(partial.cpus()[1].id == 9 && partial.cpus()[1].core == 9 && partial.cpus()[1].l3 == -1);
+
+    fs::remove_all(root);
+    assert(CpuTopology::from_sysfs(root.string()).cpus().empty());
+}
+
+static void test_flat_fallback()
+{
+    const CpuTopology flat = CpuTopology::flat({0, 1, 2});
+    assert(!flat.known());
+    const auto tiers = CpuTopology::steal_tiers(flat.placement(), 1);
+    assert(tiers.size() == 1);  // nothing known to be shared: one tier
+    assert((tiers[0] == std::vector<std::size_t>{0, 2}));
+
+    const CpuTopology here = CpuTopology::detect();
+    assert(!here.cpus().empty());
+}
+
+static long fib(WorkStealingThreadPool& pool, int n)
+{
+    if (n < 2) {
+        return n;
+    }
+    long                   a = 0;
+    thread_pool::TaskGroup group(pool);
+    group.spawn([&] { a = fib(pool, n - 1); });
+    const long b = fib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+static void test_pinned_pool()
+{
+    const CpuTopology here = CpuTopology::detect();
+    SchedulingConfig  config;
+    config.pin_workers = true;
+    WorkStealingThreadPool pool(4, config);  // more workers than CPUs wraps around
+
+    for (std::size_t i = 0; i < pool.thread_count(); ++i) {
+        const int cpu = pool.worker_cpu(i);
+        assert(cpu == -1 || std::any_of(here.cpus().begin(), here.cpus().end(),
+                                        [cpu](const CpuInfo& c) { return c.id == cpu; }));
+    }
+    assert(pool.submit([&pool] { return fib(pool, 20); }).get() == 6765);
+
+    WorkStealingThreadPool unpinned(2);
+    assert(unpinned.worker_cpu(0) == -1 && unpinned.worker_cpu(1) == -1);
+}
+
+int main()
+{
+    std::cout << "Running topology tests...\n";
+
+    test_parse_cpu_list();
+    test_sysfs_topology();
+    test_flat_fallback();
+    test_pinned_pool();
+
+    std::cout << "All topology tests passed.\n";
+    return 0;
+}
@@ -4,6 +4,8 @@
 #include <cassert>
 #include <chrono>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
@@ -53,12 +55,120 @@ static void test_parallel_increment()
     assert(counter.load(std::memory_order_relaxed) == N);
 }
 
+static void test_nested_submission()
+{
+    // Tasks submitted from inside a worker land on that worker's own deque
+    // and are stolen by the others
+    WorkStealingThreadPool pool(4);
+
+    constexpr int Outer = 50;
+    constexpr int Inner = 200;
+    std::atomic<int> counter{0};
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < Outer; ++i) {
+        futures.push_back(pool.submit([&pool, &counter] {
+            for (int j = 0; j < Inner; ++j) {
+                pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+        }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    // Inner tasks are fire-and-forget: wait until they all ran
+    while (counter.load(std::memory_order_relaxed) != Outer * Inner) {
+        std::this_thread::yield();
+    }
+}
+
+static void test_destructor_drains_pending_work()
+{
+    std::atomic<int> counter{0};
+    {
+        WorkStealingThreadPool pool(2);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&counter] {
+                counter.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+    }
+    assert(counter.load() == 1000);
+}
+
+static void test_submit_forwards_arguments_and_exceptions()
+{
+    WorkStealingThreadPool pool(2);
+
+    // Move-only argument, bound into the task
+    auto fut = pool.submit([](std::unique_ptr<int> p, int k) { return *p * k; },
+                           std::make_unique<int>(6), 7);
+    assert(fut.get() == 42);
+
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    bool caught = false;
+    try {
+        failing.get();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+}
+
+static void test_post_and_execute()
+{
+    std::atomic<int> counter{0};
+    {
+        WorkStealingThreadPool pool(2);
+        for (int i = 0; i < 500; ++i) {
+            pool.post([&counter](int by) { counter.fetch_add(by, std::memory_order_relaxed); }, 1);
+            pool.execute([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+    }
+    assert(counter.load() == 1000);
+}
+
+static void test_no_lost_wakeups()
+{
+    // Workers park between tasks; a lost wake-up would hang one of the get()s
+    WorkStealingThreadPool pool(4);
+    for (int round = 0; round < 2000; ++round) {
+        assert(pool.submit([round] { return round; }).get() == round);
+    }
+
+    // Several outside submitters racing workers that are going to sleep
+    std::atomic<int> counter{0};
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < 3; ++t) {
+        submitters.emplace_back([&pool, &counter] {
+            for (int i = 0; i < 300; ++i) {
+                pool.submit([&counter] {
+                    counter.fetch_add(1, std::memory_order_relaxed);
+                }).get();
+                if (i % 50 == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+        });
+    }
+    for (auto& t : submitters) {
+        t.join();
+    }
+    assert(counter.load() == 900);
+}
+
 int main()
 {
     std::cout << "Running thread_pool tests...\n";
 
     test_basic_sum();
     test_parallel_increment();
+    test_nested_submission();
+    test_destructor_drains_pending_work();
+    test_submit_forwards_arguments_and_exceptions();
+    test_post_and_execute();
+    test_no_lost_wakeups();
 
     std::cout << "All thread_pool tests passed.\n";
     return 0;